@@ -89,6 +89,20 @@ typedef enum {
 #define INTEL_CAP_TSN_TIME_AWARE_SHAPER    INTEL_CAP_TSN_TAS
 #define INTEL_CAP_TSN_FRAME_PREEMPTION     INTEL_CAP_TSN_FP
 
+/* Per-family capability sets (single source for the device database and C++ traits) */
+#define INTEL_FAMILY_I210_CAPABILITIES     (INTEL_CAP_BASIC_1588 | INTEL_CAP_MMIO | INTEL_CAP_DMA | \
+                                            INTEL_CAP_NATIVE_OS | INTEL_CAP_VLAN_FILTER | \
+                                            INTEL_CAP_QOS_PRIORITY | INTEL_CAP_AVB_SHAPING)
+#define INTEL_FAMILY_I219_CAPABILITIES     (INTEL_CAP_BASIC_1588 | INTEL_CAP_MDIO | INTEL_CAP_NATIVE_OS | \
+                                            INTEL_CAP_VLAN_FILTER | INTEL_CAP_QOS_PRIORITY | \
+                                            INTEL_CAP_AVB_SHAPING | INTEL_CAP_ADVANCED_QOS)
+#define INTEL_FAMILY_I225_CAPABILITIES     (INTEL_CAP_BASIC_1588 | INTEL_CAP_ENHANCED_TS | INTEL_CAP_TSN_TAS | \
+                                            INTEL_CAP_TSN_FP | INTEL_CAP_PCIe_PTM | INTEL_CAP_2_5G | \
+                                            INTEL_CAP_MMIO | INTEL_CAP_DMA | INTEL_CAP_NATIVE_OS | \
+                                            INTEL_CAP_VLAN_FILTER | INTEL_CAP_QOS_PRIORITY | \
+                                            INTEL_CAP_AVB_SHAPING | INTEL_CAP_ADVANCED_QOS)
+#define INTEL_FAMILY_I226_CAPABILITIES     INTEL_FAMILY_I225_CAPABILITIES
+
 /* Device family aliases for compatibility */
 #define INTEL_DEVICE_FAMILY_I210           INTEL_FAMILY_I210
 #define INTEL_DEVICE_FAMILY_I219           INTEL_FAMILY_I219
@@ -107,7 +121,8 @@ typedef enum {
     INTEL_HAL_ERROR_TIMEOUT = -7,
     INTEL_HAL_ERROR_HARDWARE = -8,
     INTEL_HAL_ERROR_OS_SPECIFIC = -9,
-    INTEL_HAL_ERROR_DEVICE_IO = -10
+    INTEL_HAL_ERROR_DEVICE_IO = -10,
+    INTEL_HAL_ERROR_NO_BANDWIDTH = -11
 } intel_hal_result_t;
 
 /* Timestamp Structure */
@@ -160,6 +175,20 @@ typedef struct {
 #endif
 } intel_device_info_t;
 
+/* Compact device record (32 bytes on 64-bit platforms) */
+typedef struct {
+    uint32_t capabilities;              /* INTEL_CAP_* */
+    uint16_t device_id;
+    uint8_t family;                     /* intel_device_family_t */
+    uint8_t pci_function;
+    uint16_t pci_domain;
+    uint8_t pci_bus;
+    uint8_t pci_device;
+    uint32_t if_index;                  /* OS interface index, 0 if unknown */
+    int32_t ptp_index;                  /* PHC index (/dev/ptpN), -1 if none */
+    const char *name;                   /* Model name (static storage), e.g. "I226-V" */
+} intel_device_record_t;
+
 /* Network Interface Information */
 typedef struct {
     char name[64];
@@ -304,21 +333,70 @@ void intel_hal_cleanup(void);
 /**
  * @brief Enumerate all supported Intel devices
  * 
- * @param[out] devices Array to store device information
+ * Every adapter instance is reported, including several of the same model.
+ * Call with devices == NULL to query the number of devices.
+ * 
+ * @param[out] devices Array to store device information (may be NULL)
  * @param[in,out] count Input: size of devices array, Output: actual count
  * @return INTEL_HAL_SUCCESS on success, error code otherwise
  */
 intel_hal_result_t intel_hal_enumerate_devices(intel_device_info_t *devices, uint32_t *count);
 
+/**
+ * @brief Enumerate supported Intel devices as compact records
+ * 
+ * Scans the system (sysfs on Linux, SetupAPI on Windows) without opening
+ * devices or allocating. Records are ordered by PCI address on Linux.
+ * Call with records == NULL to query the number of devices.
+ * 
+ * @param[out] records Array to store device records (may be NULL)
+ * @param[in,out] count Input: size of records array, Output: number of devices present
+ * @return INTEL_HAL_SUCCESS on success, INTEL_HAL_ERROR_NO_MEMORY if records
+ *         was too small (the first *count-on-input records are filled),
+ *         error code otherwise
+ */
+intel_hal_result_t intel_hal_enumerate_records(intel_device_record_t *records, uint32_t *count);
+
 /**
  * @brief Open an Intel device for hardware access
  * 
- * @param[in] device_id PCI device ID or interface name
+ * A PCI device ID ("0x125C") opens the first adapter with that ID; a PCI
+ * address ("0000:03:00.0") or interface name opens that specific adapter.
+ * 
+ * @param[in] device_id PCI device ID, PCI address or interface name
  * @param[out] device Pointer to store device handle
  * @return INTEL_HAL_SUCCESS on success, error code otherwise
  */
 intel_hal_result_t intel_hal_open_device(const char *device_id, intel_device_t **device);
 
+/**
+ * @brief Open the adapter instance described by an enumeration record
+ * 
+ * @param[in] record Record from intel_hal_enumerate_records()
+ * @param[out] device Pointer to store device handle
+ * @return INTEL_HAL_SUCCESS on success, error code otherwise
+ */
+intel_hal_result_t intel_hal_open_device_by_record(const intel_device_record_t *record, intel_device_t **device);
+
+/**
+ * @brief Find an open device by interface index (O(1))
+ * 
+ * @param[in] if_index OS interface index
+ * @return Device handle, or NULL if no open device has that index
+ */
+intel_device_t *intel_hal_find_device_by_ifindex(uint32_t if_index);
+
+/**
+ * @brief Find an open device by PCI address (O(1))
+ * 
+ * @param[in] domain PCI domain
+ * @param[in] bus PCI bus
+ * @param[in] dev PCI device
+ * @param[in] function PCI function
+ * @return Device handle, or NULL if no open device has that address
+ */
+intel_device_t *intel_hal_find_device_by_pci_address(uint16_t domain, uint8_t bus, uint8_t dev, uint8_t function);
+
 /**
  * @brief Close an Intel device
  * 
@@ -335,6 +413,15 @@ void intel_hal_close_device(intel_device_t *device);
  */
 intel_hal_result_t intel_hal_get_device_info(intel_device_t *device, intel_device_info_t *info);
 
+/**
+ * @brief Get the compact record (instance identity) of an open device
+ * 
+ * @param[in] device Device handle
+ * @param[out] record Device record
+ * @return INTEL_HAL_SUCCESS on success, error code otherwise
+ */
+intel_hal_result_t intel_hal_get_device_record(intel_device_t *device, intel_device_record_t *record);
+
 /**
  * @brief Get network interface information
  * 
@@ -402,6 +489,9 @@ bool intel_hal_has_capability(intel_device_t *device, uint32_t capability);
  * TSN (Time-Sensitive Networking) Functions
  * ============================================================================ */
 
+/* Hardware gate control list entries */
+#define INTEL_HAL_TAS_MAX_ENTRIES 8
+
 /* Time-Aware Shaper Configuration */
 typedef struct {
     uint32_t gate_control_list_length;  /* Number of gate control entries */
@@ -410,9 +500,23 @@ typedef struct {
     struct {
         uint8_t gate_states;            /* Gate states (bit field) */
         uint32_t time_interval;         /* Time interval in nanoseconds */
-    } gate_control_list[8];             /* Maximum 8 entries */
+    } gate_control_list[INTEL_HAL_TAS_MAX_ENTRIES]; /* Maximum 8 entries */
 } intel_tas_config_t;
 
+/* Gate control list entry */
+typedef struct {
+    uint8_t gate_states;                /* Gate states (bit field) */
+    uint32_t time_interval;             /* Time interval in nanoseconds */
+} intel_gcl_entry_t;
+
+/* Variable-length gate control list */
+typedef struct {
+    uint64_t cycle_time;                /* Gate cycle time in nanoseconds */
+    uint64_t base_time;                 /* Base time for gate schedule */
+    uint32_t entry_count;               /* Number of entries */
+    const intel_gcl_entry_t *entries;   /* Entries; intervals must sum to cycle_time */
+} intel_gcl_t;
+
 /* Frame Preemption Configuration */
 typedef struct {
     uint8_t preemptible_queues;         /* Bit field of preemptible queues */
@@ -434,10 +538,240 @@ typedef struct {
  * 
  * @param[in] device Device handle
  * @param[in] config TAS configuration
- * @return INTEL_HAL_SUCCESS on success, error code otherwise
+ * @return INTEL_HAL_SUCCESS on success, INTEL_HAL_ERROR_INVALID_PARAM if the
+ *         list has more than INTEL_HAL_TAS_MAX_ENTRIES entries, error code otherwise
  */
 intel_hal_result_t intel_hal_setup_time_aware_shaper(intel_device_t *device, const intel_tas_config_t *config);
 
+/**
+ * @brief Validate a variable-length gate control list
+ * 
+ * Checks that no interval is zero and that the intervals sum to cycle_time.
+ * 
+ * @param[in] gcl Gate control list
+ * @return INTEL_HAL_SUCCESS if valid, INTEL_HAL_ERROR_INVALID_PARAM otherwise
+ */
+intel_hal_result_t intel_hal_gcl_validate(const intel_gcl_t *gcl);
+
+/**
+ * @brief Fit a variable-length gate control list to the hardware entry limit
+ * 
+ * Merges adjacent entries with identical gate states (the last entry merges
+ * into the first by moving base_time back) and folds a list that repeats
+ * within the cycle onto the shorter cycle. The gate timeline is unchanged.
+ * 
+ * @param[in] gcl Gate control list
+ * @param[out] config Equivalent TAS configuration
+ * @return INTEL_HAL_SUCCESS on success, INTEL_HAL_ERROR_NOT_SUPPORTED if the
+ *         list still needs more than INTEL_HAL_TAS_MAX_ENTRIES entries (the
+ *         error message gives the count), error code otherwise
+ */
+intel_hal_result_t intel_hal_gcl_fit(const intel_gcl_t *gcl, intel_tas_config_t *config);
+
+/* Schedule analysis of one traffic class */
+typedef struct {
+    uint64_t frame_time_ns;             /* Transmission time of one frame incl. preamble and IPG */
+    uint64_t open_time_ns;              /* Gate-open time per cycle */
+    uint64_t max_closed_interval_ns;    /* Longest continuous gate-closed interval */
+    uint64_t guaranteed_bandwidth_bps;  /* Payload bits per second of whole frames fitting in the windows */
+    uint64_t worst_case_latency_ns;     /* Arrival at any phase to end of transmission; UINT64_MAX if no window fits a frame */
+} intel_tas_tc_analysis_t;
+
+/* Schedule analysis for all traffic classes (bit n of gate_states = class n) */
+typedef struct {
+    intel_tas_tc_analysis_t tc[8];
+} intel_tas_analysis_t;
+
+/**
+ * @brief Analyze the per-traffic-class guarantees of a TAS schedule
+ * 
+ * Assumes a frame is only started if it completes before its gate closes
+ * and that the class queue is otherwise empty. Runs in O(entries).
+ * 
+ * @param[in] config TAS configuration (intervals must sum to cycle_time)
+ * @param[in] link_speed_mbps Link speed in Mbps
+ * @param[in] frame_size Frame size per traffic class in bytes (header to FCS)
+ * @param[out] analysis Per-class results
+ * @return INTEL_HAL_SUCCESS on success, error code otherwise
+ */
+intel_hal_result_t intel_hal_analyze_tas(const intel_tas_config_t *config, uint32_t link_speed_mbps,
+                                         const uint32_t frame_size[8], intel_tas_analysis_t *analysis);
+
+/**
+ * @brief Configure Time-Aware Shaper from a variable-length gate control list
+ * 
+ * @param[in] device Device handle
+ * @param[in] gcl Gate control list (see intel_hal_gcl_fit())
+ * @return INTEL_HAL_SUCCESS on success, error code otherwise
+ */
+intel_hal_result_t intel_hal_setup_gcl(intel_device_t *device, const intel_gcl_t *gcl);
+
+/* Earliest AdminBaseTime after the current PHC time for a staged schedule */
+#define INTEL_HAL_TAS_UPDATE_MIN_LEAD_NS 1000000ULL
+
+/* Result of staging an admin schedule */
+typedef struct {
+    uint64_t admin_base_time;           /* PHC time the admin schedule becomes operational; 0 if nothing staged */
+    uint32_t changed_entries;           /* Bit n set if entry n differs from the operating schedule */
+    bool hardware;                      /* Switch performed by the I225/I226 gate scheduler */
+} intel_tas_update_t;
+
+/**
+ * @brief Stage an admin TAS schedule to replace the operating one without a gap
+ *
+ * The admin schedule takes over at AdminBaseTime, which is admin->base_time
+ * if that is at least not_before and INTEL_HAL_TAS_UPDATE_MIN_LEAD_NS in the
+ * future, otherwise the first operating cycle boundary (or, with no schedule
+ * operating, the first admin cycle start) after both. The operating schedule
+ * runs whole cycles until then. I225/I226 switch in hardware at that time;
+ * other families switch their software schedule at exactly that PHC time.
+ * A schedule identical to the operating one is not staged.
+ *
+ * @param[in] device Device handle
+ * @param[in] admin Admin schedule (base_time as above)
+ * @param[in] not_before Earliest PHC time for the switch (0 for as soon as possible)
+ * @param[out] update AdminBaseTime and changed entries (may be NULL)
+ * @return INTEL_HAL_SUCCESS on success, error code otherwise
+ */
+intel_hal_result_t intel_hal_tas_stage_update(intel_device_t *device, const intel_tas_config_t *admin,
+                                              uint64_t not_before, intel_tas_update_t *update);
+
+/**
+ * @brief Get the staged admin schedule, if it has not yet become operational
+ *
+ * @param[in] device Device handle
+ * @param[out] pending Whether an admin schedule is waiting for its base time
+ * @param[out] admin_base_time Its AdminBaseTime (0 if none pending)
+ * @return INTEL_HAL_SUCCESS on success, error code otherwise
+ */
+intel_hal_result_t intel_hal_tas_get_update_status(intel_device_t *device, bool *pending, uint64_t *admin_base_time);
+
+/**
+ * @brief First point of a cycle grid at or after a PHC time
+ *
+ * The grid is reference_base + k * cycle_time for any integer k; pass 0 to
+ * align to whole multiples of the cycle since the PTP epoch.
+ *
+ * @param[in] reference_base Any point of the grid
+ * @param[in] cycle_time Cycle time in nanoseconds (0 returns phc_time)
+ * @param[in] phc_time Earliest acceptable base time
+ * @return Base time on the grid
+ */
+uint64_t intel_hal_tas_next_base_time(uint64_t reference_base, uint64_t cycle_time, uint64_t phc_time);
+
+/* Lookup index of a TAS schedule (filled by intel_hal_tas_index_build()) */
+typedef struct {
+    uint64_t base_time;
+    uint64_t cycle_time;
+    uint32_t entry_count;
+    uint64_t entry_start[INTEL_HAL_TAS_MAX_ENTRIES];    /* Offset of each entry in the cycle */
+    uint8_t gate_states[INTEL_HAL_TAS_MAX_ENTRIES];
+    uint32_t window_count[8];                           /* Open windows per traffic class */
+    int64_t window_start[8][INTEL_HAL_TAS_MAX_ENTRIES]; /* Negative if open from the previous cycle */
+    uint64_t window_end[8][INTEL_HAL_TAS_MAX_ENTRIES];  /* Ascending */
+} intel_tas_index_t;
+
+/* Gate position at a PHC time and the open window of one traffic class */
+typedef struct {
+    uint8_t gate_states;                /* Gate states in effect */
+    uint32_t entry;                     /* Gate control entry in effect */
+    uint64_t cycle_start;               /* PHC time the current cycle started */
+    uint64_t cycle_offset;              /* Position in the cycle */
+    bool open;                          /* Class gate open at the queried time */
+    uint64_t window_start;              /* Current window if open, else the next one */
+    uint64_t window_end;                /* 0 if the class gate never opens */
+} intel_tas_gate_info_t;
+
+/**
+ * @brief Precompute the lookup index of a TAS schedule
+ *
+ * @param[in] config TAS configuration (intervals must sum to cycle_time)
+ * @param[out] index Lookup index
+ * @return INTEL_HAL_SUCCESS on success, error code otherwise
+ */
+intel_hal_result_t intel_hal_tas_index_build(const intel_tas_config_t *config, intel_tas_index_t *index);
+
+/**
+ * @brief Look up the gate position and class window at a PHC time in O(log entries)
+ *
+ * Times before base_time are answered for base_time.
+ *
+ * @param[in] index Lookup index
+ * @param[in] phc_time PHC time in nanoseconds
+ * @param[in] traffic_class Traffic class (0-7)
+ * @param[out] info Gate position and window
+ * @return INTEL_HAL_SUCCESS on success, error code otherwise
+ */
+intel_hal_result_t intel_hal_tas_index_query(const intel_tas_index_t *index, uint64_t phc_time,
+                                             uint8_t traffic_class, intel_tas_gate_info_t *info);
+
+/**
+ * @brief Get the current gate position and the next open window of a traffic class
+ *
+ * Answered from the index of the schedule applied through the HAL, switching
+ * to a staged admin schedule for windows from its base time on.
+ *
+ * @param[in] device Device handle
+ * @param[in] traffic_class Traffic class (0-7)
+ * @param[out] info Gate position at the current PHC time and window
+ * @return INTEL_HAL_SUCCESS on success, INTEL_HAL_ERROR_NOT_SUPPORTED if no
+ *         schedule is enabled, error code otherwise
+ */
+intel_hal_result_t intel_hal_get_tas_gate_info(intel_device_t *device, uint8_t traffic_class,
+                                               intel_tas_gate_info_t *info);
+
+/* Hyperperiod limit of schedule synthesis, in gate cycles */
+#define INTEL_TSN_SYNTH_MAX_CYCLES 4096
+
+/* Periodic scheduled stream */
+typedef struct {
+    uint64_t period_ns;                 /* Transmission period */
+    uint32_t frame_size;                /* Frame size in bytes (header to FCS) */
+    uint8_t traffic_class;              /* Scheduled traffic class (0-7) */
+    uint64_t deadline_ns;               /* Period start to end of transmission (0 = period) */
+} intel_tsn_stream_t;
+
+/* Schedule synthesis parameters */
+typedef struct {
+    uint32_t link_speed_mbps;
+    uint64_t base_time;                 /* Base time of the synthesized schedule */
+    uint8_t best_effort_gates;          /* Gates open outside the scheduled windows (0 for none, no scheduled TC) */
+    uint32_t guard_frame_size;          /* Largest best-effort frame; sizes the guard band */
+} intel_tsn_synth_config_t;
+
+/* Synthesized transmission slot of one stream */
+typedef struct {
+    uint64_t launch_offset_ns;          /* Launch time after each period start (base_time + n * period) */
+    uint64_t latency_ns;                /* Period start to end of transmission */
+} intel_tsn_stream_slot_t;
+
+/**
+ * @brief Synthesize a gate control list and launch offsets for periodic streams
+ *
+ * The gate cycle is the greatest common divisor of the stream periods. Each
+ * scheduled traffic class gets one exclusive window per cycle, ordered by
+ * earliest deadline, followed by the best-effort window and a guard band of
+ * one guard_frame_size frame before the cycle wraps. Streams are packed in
+ * earliest-deadline order into the cycles of the hyperperiod: each takes the
+ * cycle phase that keeps the class window smallest while meeting its
+ * deadline, at one position that is free in every cycle it recurs in.
+ * Runs in O(streams * hyperperiod cycles).
+ *
+ * @param[in] config Synthesis parameters
+ * @param[in] streams Streams
+ * @param[in] stream_count Number of streams
+ * @param[out] slots Launch offset and latency per stream (stream_count entries)
+ * @param[out] tas Gate schedule, base_time from config
+ * @return INTEL_HAL_SUCCESS on success, INTEL_HAL_ERROR_INVALID_PARAM if
+ *         best_effort_gates includes a scheduled traffic class,
+ *         INTEL_HAL_ERROR_NOT_SUPPORTED if the streams do not fit the cycle or
+ *         a deadline cannot be met (the error message says which), error code
+ *         otherwise
+ */
+intel_hal_result_t intel_hal_tsn_synthesize(const intel_tsn_synth_config_t *config,
+                                            const intel_tsn_stream_t *streams, uint32_t stream_count,
+                                            intel_tsn_stream_slot_t *slots, intel_tas_config_t *tas);
+
 /**
  * @brief Configure Frame Preemption (IEEE 802.1Qbu)
  * 
@@ -460,8 +794,9 @@ intel_hal_result_t intel_hal_xmit_timed_packet(intel_device_t *device, const int
  * @brief Get Time-Aware Shaper status
  * 
  * @param[in] device Device handle
- * @param[out] enabled Whether TAS is currently enabled
+ * @param[out] enabled Whether a hardware or software gate schedule is enabled
  * @param[out] current_time Current gate schedule time
+ * @note Use intel_hal_get_tas_gate_info() for the gate position and windows
  * @return INTEL_HAL_SUCCESS on success, error code otherwise
  */
 intel_hal_result_t intel_hal_get_tas_status(intel_device_t *device, bool *enabled, uint64_t *current_time);
@@ -476,6 +811,1299 @@ intel_hal_result_t intel_hal_get_tas_status(intel_device_t *device, bool *enable
  */
 intel_hal_result_t intel_hal_get_frame_preemption_status(intel_device_t *device, bool *enabled, uint8_t *active_queues);
 
+/* Frame preemption verification status (IEEE 802.3br) */
+typedef enum {
+    INTEL_FP_VERIFY_INITIAL = 0,        /* Preemption not enabled */
+    INTEL_FP_VERIFY_VERIFYING,
+    INTEL_FP_VERIFY_SUCCEEDED,
+    INTEL_FP_VERIFY_FAILED,
+    INTEL_FP_VERIFY_DISABLED,           /* Verification disabled by configuration */
+    INTEL_FP_VERIFY_UNKNOWN             /* No preemption traffic from the link partner to judge by */
+} intel_fp_verify_status_t;
+
+/* MAC merge counters */
+typedef struct {
+    uint64_t tx_preempted_frames;
+    uint64_t tx_fragments;
+    uint64_t rx_fragments;
+    uint64_t assembly_ok;               /* Preempted frames reassembled */
+    uint64_t assembly_errors;           /* Out-of-order or missing fragments */
+    uint64_t smd_errors;                /* Unexpected start-of-mPacket delimiters */
+} intel_fp_counters_t;
+
+/* Frame preemption status */
+typedef struct {
+    bool enabled;                       /* Configured through the HAL */
+    bool tx_active;                     /* Preemption enabled in the MAC */
+    bool hold;                          /* Express hold requested */
+    uint8_t preemptible_queues;
+    intel_fp_verify_status_t verify_status;
+    intel_fp_counters_t total;          /* Since the device was opened */
+    intel_fp_counters_t delta;          /* Since the previous call */
+} intel_fp_status_t;
+
+/**
+ * @brief Get Frame Preemption state and MAC merge counters (I226)
+ *
+ * Reads the clear-on-read hardware counters, so deltas are relative to the
+ * previous call on this device handle. The MAC has no verify state
+ * register: the verify status is SUCCEEDED once preempted frames from the
+ * link partner were reassembled since the last configuration. After three
+ * verify times without that it is FAILED if only reassembly or SMD errors
+ * were seen, and UNKNOWN if the partner sent no preemption traffic at all,
+ * which a partner with nothing preemptible to send cannot be told apart from.
+ *
+ * @param[in] device Device handle
+ * @param[out] status Preemption state and counters
+ * @return INTEL_HAL_SUCCESS on success, INTEL_HAL_ERROR_NOT_SUPPORTED on
+ *         families without preemption, error code otherwise
+ */
+intel_hal_result_t intel_hal_get_frame_preemption_stats(intel_device_t *device, intel_fp_status_t *status);
+
+/* ============================================================================
+ * Port Bandwidth Ledger
+ *
+ * Each device keeps a ledger of the bandwidth claimed per traffic class by
+ * bandwidth allocations, CBS idle slopes, rate limits and stream
+ * reservations. A class counts with the largest of its claims. Configure
+ * calls and reservations that would take the port past its capacity fail
+ * with INTEL_HAL_ERROR_NO_BANDWIDTH. Queries are lock-free.
+ * ============================================================================ */
+
+/**
+ * @brief Reserve bandwidth for a stream on a traffic class
+ * 
+ * @param[in] device Device handle
+ * @param[in] traffic_class Traffic class (0-7)
+ * @param[in] bps Bandwidth in bits per second
+ * @return INTEL_HAL_SUCCESS on success, INTEL_HAL_ERROR_NO_BANDWIDTH if the
+ *         port would be oversubscribed, error code otherwise
+ */
+intel_hal_result_t intel_hal_bandwidth_reserve(intel_device_t *device, uint8_t traffic_class, uint64_t bps);
+
+/**
+ * @brief Release bandwidth reserved with intel_hal_bandwidth_reserve()
+ * 
+ * @param[in] device Device handle
+ * @param[in] traffic_class Traffic class (0-7)
+ * @param[in] bps Bandwidth in bits per second
+ * @return INTEL_HAL_SUCCESS on success, error code otherwise
+ */
+intel_hal_result_t intel_hal_bandwidth_release(intel_device_t *device, uint8_t traffic_class, uint64_t bps);
+
+/**
+ * @brief Set the port capacity used by the ledger
+ * 
+ * Defaults to 1 Gbps (2.5 Gbps on 2.5G-capable families). Bandwidth
+ * allocation percentages are converted at the capacity in effect when
+ * they are configured.
+ * 
+ * @param[in] device Device handle
+ * @param[in] capacity_bps Capacity in bits per second
+ * @return INTEL_HAL_SUCCESS on success, INTEL_HAL_ERROR_DEVICE_BUSY if more
+ *         than the new capacity is already committed, error code otherwise
+ */
+intel_hal_result_t intel_hal_bandwidth_set_capacity(intel_device_t *device, uint64_t capacity_bps);
+
+/**
+ * @brief Get the uncommitted port bandwidth (lock-free)
+ * 
+ * @param[in] device Device handle
+ * @param[out] headroom_bps Remaining bandwidth in bits per second
+ * @return INTEL_HAL_SUCCESS on success, error code otherwise
+ */
+intel_hal_result_t intel_hal_bandwidth_get_headroom(intel_device_t *device, uint64_t *headroom_bps);
+
+/**
+ * @brief Get the bandwidth committed to a traffic class (lock-free)
+ * 
+ * @param[in] device Device handle
+ * @param[in] traffic_class Traffic class (0-7)
+ * @param[out] committed_bps Largest claim of the class in bits per second
+ * @return INTEL_HAL_SUCCESS on success, error code otherwise
+ */
+intel_hal_result_t intel_hal_bandwidth_get_committed(intel_device_t *device, uint8_t traffic_class, uint64_t *committed_bps);
+
+/* ============================================================================
+ * SRP Credit-Based Shaper Calculation
+ * ============================================================================ */
+
+/* Stream Reservation class */
+typedef enum {
+    INTEL_SR_CLASS_A = 0,               /* 125 us class measurement interval */
+    INTEL_SR_CLASS_B = 1                /* 250 us class measurement interval */
+} intel_sr_class_t;
+
+/* One stream reservation (SRP TSpec) */
+typedef struct {
+    intel_sr_class_t sr_class;
+    uint16_t max_frame_size;            /* SRP MaxFrameSize in bytes (without the 42-byte per-frame overhead) */
+    uint16_t max_interval_frames;       /* Frames per class measurement interval */
+} intel_stream_reservation_t;
+
+/**
+ * @brief Calculate Class A/B CBS parameters from stream reservations
+ * 
+ * Follows IEEE 802.1Q Annex L. Slopes are in bytes per second and credits
+ * in bytes; send_slope and lo_credit hold the magnitude of the (negative)
+ * standard values. A class without streams is returned disabled.
+ * 
+ * @param[in] streams Stream reservations
+ * @param[in] stream_count Number of reservations
+ * @param[in] link_speed_mbps Port transmit rate in Mbps
+ * @param[in] max_interference_size Largest interfering frame on the wire in
+ *            bytes (0 selects 1542: a 1522-byte frame with preamble and IPG)
+ * @param[out] class_a Parameters for INTEL_AVB_CLASS_A
+ * @param[out] class_b Parameters for INTEL_AVB_CLASS_B
+ * @return INTEL_HAL_SUCCESS on success, INTEL_HAL_ERROR_NO_BANDWIDTH if the
+ *         reservations exceed 75% of the link, error code otherwise
+ */
+intel_hal_result_t intel_hal_calculate_cbs(const intel_stream_reservation_t *streams, uint32_t stream_count,
+                                           uint32_t link_speed_mbps, uint32_t max_interference_size,
+                                           intel_cbs_config_t *class_a, intel_cbs_config_t *class_b);
+
+/**
+ * @brief Admit stream reservations and program the Class A/B shapers
+ * 
+ * Calculates the parameters with intel_hal_calculate_cbs() and applies them
+ * through intel_hal_configure_cbs(). Nothing is applied if admission fails.
+ * 
+ * @param[in] device Device handle
+ * @param[in] streams Stream reservations (all streams on the port)
+ * @param[in] stream_count Number of reservations
+ * @param[in] link_speed_mbps Port transmit rate in Mbps
+ * @return INTEL_HAL_SUCCESS on success, error code otherwise
+ */
+intel_hal_result_t intel_hal_apply_stream_reservations(intel_device_t *device, const intel_stream_reservation_t *streams,
+                                                       uint32_t stream_count, uint32_t link_speed_mbps);
+
+/* ============================================================================
+ * Device Status Snapshot
+ * ============================================================================ */
+
+/* Complete device status, filled by one intel_hal_get_status() call */
+typedef struct {
+    /* Link */
+    bool link_up;
+    uint32_t speed_mbps;                /* 0 if the link is down or unknown */
+    
+    /* Timestamping and clock */
+    bool timestamping_enabled;
+    bool phc_valid;                     /* phc_time was read successfully */
+    uint64_t phc_time;                  /* PHC time at the snapshot in nanoseconds */
+    
+    /* Clock servo (adjustments applied through the HAL) */
+    int32_t frequency_ppb;              /* Last frequency adjustment */
+    uint64_t frequency_adjustments;     /* Number of frequency adjustments */
+    uint64_t time_steps;                /* Number of PHC time steps */
+    
+    /* Time-Aware Shaper */
+    bool tas_enabled;
+    uint64_t tas_base_time;             /* Base time in nanoseconds */
+    uint64_t tas_cycle_time;            /* Cycle time in nanoseconds */
+    uint32_t tas_gate_count;            /* Gate control list entries */
+    
+    /* Frame Preemption */
+    bool fp_enabled;
+    uint8_t fp_preemptible_queues;      /* Bit field of preemptible queues */
+    
+    /* Credit-Based Shaper per traffic class */
+    intel_cbs_config_t cbs[8];
+} intel_device_status_t;
+
+/**
+ * @brief Get a complete device status snapshot
+ *
+ * Configuration state comes from the HAL's cache of applied settings; only
+ * the link state and the PHC are read from the device. Does not print.
+ *
+ * @param[in] device Device handle
+ * @param[out] status Status snapshot
+ * @return INTEL_HAL_SUCCESS on success (phc_valid reports whether the PHC
+ *         read succeeded), error code otherwise
+ */
+intel_hal_result_t intel_hal_get_status(intel_device_t *device, intel_device_status_t *status);
+
+/* ============================================================================
+ * Configuration Snapshot and Restore
+ * ============================================================================ */
+
+/* Current configuration snapshot format version */
+#define INTEL_HAL_CONFIG_VERSION 1
+
+/**
+ * @brief Serialize the configuration applied through the HAL
+ *
+ * Captures the VLAN filter table, priority map, CBS per traffic class,
+ * bandwidth allocation and rate limits, the TAS schedule and frame
+ * preemption into a compact versioned binary blob.
+ *
+ * @param[in] device Device handle
+ * @param[out] buffer Blob buffer (NULL to query the required size)
+ * @param[in,out] size Input: buffer size, Output: blob size
+ * @return INTEL_HAL_SUCCESS on success, INTEL_HAL_ERROR_NO_MEMORY if the
+ *         buffer is too small (size is set to the required size)
+ */
+intel_hal_result_t intel_hal_save_config(intel_device_t *device, void *buffer, size_t *size);
+
+/**
+ * @brief Re-apply a configuration blob from intel_hal_save_config()
+ *
+ * The blob is validated completely before anything is applied, and is then
+ * applied as one batch rather than one configure call per setting. TAS
+ * and frame preemption that were off when the blob was taken are disabled,
+ * replacing any schedule configured since. The device must be of the same
+ * family as the one the blob was taken from.
+ *
+ * @param[in] device Device handle
+ * @param[in] buffer Blob
+ * @param[in] size Blob size in bytes
+ * @return INTEL_HAL_SUCCESS on success, error code otherwise
+ */
+intel_hal_result_t intel_hal_restore_config(intel_device_t *device, const void *buffer, size_t size);
+
+/* ============================================================================
+ * Pre-validated Entry Points
+ *
+ * These variants skip the NULL and capability checks of their checked
+ * counterparts. The caller must guarantee a valid, open device handle, valid
+ * pointers and that the device has the required capability, e.g. by checking
+ * once after open or through the compile-time family traits of the C++ API
+ * (intel_ethernet_hal.hpp). Intended for hot loops.
+ * ============================================================================ */
+
+/**
+ * @brief Read current timestamp without validation (requires INTEL_CAP_BASIC_1588)
+ *
+ * @param[in] device Open device handle
+ * @param[out] timestamp Current hardware timestamp
+ * @return INTEL_HAL_SUCCESS on success, error code otherwise
+ */
+intel_hal_result_t intel_hal_read_timestamp_unchecked(intel_device_t *device, intel_timestamp_t *timestamp);
+
+/**
+ * @brief Set hardware timestamp without validation (requires INTEL_CAP_BASIC_1588)
+ *
+ * @param[in] device Open device handle
+ * @param[in] timestamp Timestamp to set
+ * @return INTEL_HAL_SUCCESS on success, error code otherwise
+ */
+intel_hal_result_t intel_hal_set_timestamp_unchecked(intel_device_t *device, const intel_timestamp_t *timestamp);
+
+/**
+ * @brief Adjust frequency without validation (requires INTEL_CAP_BASIC_1588)
+ *
+ * @param[in] device Open device handle
+ * @param[in] ppb_adjustment Parts per billion adjustment
+ * @return INTEL_HAL_SUCCESS on success, error code otherwise
+ */
+intel_hal_result_t intel_hal_adjust_frequency_unchecked(intel_device_t *device, int32_t ppb_adjustment);
+
+/**
+ * @brief Configure CBS without validation (requires INTEL_CAP_AVB_SHAPING, traffic_class 0-7)
+ *
+ * @param[in] device Open device handle
+ * @param[in] traffic_class Traffic class (0-7)
+ * @param[in] cbs_config CBS configuration
+ * @return INTEL_HAL_SUCCESS on success, error code otherwise
+ */
+intel_hal_result_t intel_hal_configure_cbs_unchecked(intel_device_t *device, uint8_t traffic_class, const intel_cbs_config_t *cbs_config);
+
+/**
+ * @brief Configure hardware Time-Aware Shaper without validation (requires INTEL_CAP_TSN_TAS)
+ *
+ * @param[in] device Open device handle
+ * @param[in] config TAS configuration
+ * @return INTEL_HAL_SUCCESS on success, error code otherwise
+ */
+intel_hal_result_t intel_hal_setup_time_aware_shaper_unchecked(intel_device_t *device, const intel_tas_config_t *config);
+
+/**
+ * @brief Configure Frame Preemption without validation (requires INTEL_CAP_TSN_FP)
+ *
+ * @param[in] device Open device handle
+ * @param[in] config Frame preemption configuration
+ * @return INTEL_HAL_SUCCESS on success, error code otherwise
+ */
+intel_hal_result_t intel_hal_setup_frame_preemption_unchecked(intel_device_t *device, const intel_frame_preemption_config_t *config);
+
+/* ============================================================================
+ * Multi-process Device Broker
+ *
+ * One process owns the devices and services requests that other processes
+ * place in a per-client lock-free ring in shared memory; completions return
+ * through a second ring. Steady-state submission and completion need no
+ * system call: the broker polls its rings and clients poll for completions.
+ * ============================================================================ */
+
+#define INTEL_BROKER_NAME_MAX              64     /* Maximum broker name length */
+#define INTEL_BROKER_MAX_CLIENTS           32     /* Maximum client slots per broker */
+#define INTEL_BROKER_RING_SIZE             64     /* Entries per ring (power of two) */
+#define INTEL_BROKER_MAX_FRAME_SIZE        1536   /* Largest frame carried by a timed transmit */
+
+/* Broker request operations */
+typedef enum {
+    INTEL_BROKER_OP_READ_TIMESTAMP = 1,
+    INTEL_BROKER_OP_ADJUST_FREQUENCY,
+    INTEL_BROKER_OP_CONFIGURE_VLAN_FILTER,
+    INTEL_BROKER_OP_CONFIGURE_PRIORITY_MAPPING,
+    INTEL_BROKER_OP_CONFIGURE_CBS,
+    INTEL_BROKER_OP_SETUP_TAS,
+    INTEL_BROKER_OP_SETUP_FRAME_PREEMPTION,
+    INTEL_BROKER_OP_XMIT_TIMED_PACKET
+} intel_broker_op_t;
+
+/* Broker request (copied into shared memory on submit) */
+typedef struct {
+    uint64_t request_id;                /* Caller cookie echoed in the completion */
+    uint32_t op;                        /* intel_broker_op_t */
+    uint32_t device_index;              /* Index into the broker's device list */
+    union {
+        int32_t ppb_adjustment;
+        struct {
+            uint16_t vlan_id;
+            bool enable;
+        } vlan_filter;
+        struct {
+            uint8_t priority;
+            uint8_t traffic_class;
+        } priority_mapping;
+        struct {
+            uint8_t traffic_class;
+            intel_cbs_config_t config;
+        } cbs;
+        intel_tas_config_t tas;
+        intel_frame_preemption_config_t frame_preemption;
+        struct {
+            uint64_t launch_time;       /* Launch time in nanoseconds */
+            uint16_t length;            /* Frame length (<= INTEL_BROKER_MAX_FRAME_SIZE) */
+            uint8_t queue;              /* Queue number */
+            uint8_t data[INTEL_BROKER_MAX_FRAME_SIZE];
+        } xmit;
+    } u;
+} intel_broker_request_t;
+
+/* Broker completion */
+typedef struct {
+    uint64_t request_id;                /* request_id of the completed request */
+    uint32_t op;                        /* intel_broker_op_t */
+    int32_t result;                     /* intel_hal_result_t */
+    intel_timestamp_t timestamp;        /* Result of INTEL_BROKER_OP_READ_TIMESTAMP */
+} intel_broker_completion_t;
+
+/* Broker and client handles (opaque) */
+typedef struct intel_broker intel_broker_t;
+typedef struct intel_broker_client intel_broker_client_t;
+
+/**
+ * @brief Create a broker that owns a set of open devices
+ *
+ * @param[in] name Broker name shared with clients (no '/' or '\\', < INTEL_BROKER_NAME_MAX)
+ * @param[in] devices Open devices; clients address them by index
+ * @param[in] device_count Number of devices
+ * @param[in] max_clients Number of client slots (1 - INTEL_BROKER_MAX_CLIENTS)
+ * @param[out] broker Broker handle
+ * @return INTEL_HAL_SUCCESS on success, INTEL_HAL_ERROR_DEVICE_BUSY if a live
+ *         broker already uses the name, error code otherwise
+ */
+intel_hal_result_t intel_hal_broker_create(const char *name, intel_device_t *const *devices, uint32_t device_count,
+                                           uint32_t max_clients, intel_broker_t **broker);
+
+/**
+ * @brief Service pending client requests
+ *
+ * Call from the owning process' service loop. A request is only taken when
+ * its client's completion ring has room, so completions are never dropped.
+ * Requests left in a reclaimed slot by its exited previous owner are
+ * discarded without being executed.
+ *
+ * @param[in] broker Broker handle
+ * @param[in] budget Maximum number of requests to service (0 = no limit)
+ * @return Number of requests serviced (discarded requests are not counted)
+ */
+uint32_t intel_hal_broker_poll(intel_broker_t *broker, uint32_t budget);
+
+/**
+ * @brief Destroy a broker and remove its shared memory
+ *
+ * @param[in] broker Broker handle
+ */
+void intel_hal_broker_destroy(intel_broker_t *broker);
+
+/**
+ * @brief Connect to a broker as a client
+ *
+ * Slots left behind by exited client processes are reclaimed here.
+ *
+ * @param[in] name Broker name
+ * @param[out] client Client handle
+ * @return INTEL_HAL_SUCCESS on success, INTEL_HAL_ERROR_NO_DEVICE if no broker
+ *         exists, INTEL_HAL_ERROR_DEVICE_BUSY if all slots are in use
+ */
+intel_hal_result_t intel_hal_broker_connect(const char *name, intel_broker_client_t **client);
+
+/**
+ * @brief Submit a request to the broker
+ *
+ * @param[in] client Client handle
+ * @param[in] request Request to copy into the request ring
+ * @return INTEL_HAL_SUCCESS on success, INTEL_HAL_ERROR_DEVICE_BUSY if the ring is full
+ */
+intel_hal_result_t intel_hal_broker_submit(intel_broker_client_t *client, const intel_broker_request_t *request);
+
+/**
+ * @brief Take the next completion, if any
+ *
+ * @param[in] client Client handle
+ * @param[out] completion Completion
+ * @return true if a completion was returned, false if none is pending
+ */
+bool intel_hal_broker_poll_completion(intel_broker_client_t *client, intel_broker_completion_t *completion);
+
+/**
+ * @brief Disconnect from the broker and release the client slot
+ *
+ * @param[in] client Client handle
+ */
+void intel_hal_broker_disconnect(intel_broker_client_t *client);
+
+/* ============================================================================
+ * Real-time Worker Threads
+ *
+ * Used by the HAL for its internal threads (schedulers, pollers) and
+ * available to applications. By default threads are pinned to the CPUs of
+ * the NIC's NUMA node so PHC reads and descriptor accesses stay local.
+ * ============================================================================ */
+
+#define INTEL_HAL_THREAD_CPU_WORDS         16     /* CPU mask words (1024 CPUs) */
+#define INTEL_HAL_NUMA_NODE_DEVICE         (-1)   /* Place on the NIC's NUMA node */
+#define INTEL_HAL_NUMA_NODE_ANY            (-2)   /* No CPU placement */
+
+/* Real-time thread attributes */
+typedef struct {
+    uint64_t cpu_mask[INTEL_HAL_THREAD_CPU_WORDS]; /* Explicit CPU set; all zero selects numa_node placement */
+    int32_t numa_node;                  /* Node number or INTEL_HAL_NUMA_NODE_* */
+    int32_t priority;                   /* SCHED_FIFO priority (1-99; TIME_CRITICAL on Windows); 0 keeps the default */
+    size_t stack_size;                  /* Stack size in bytes; 0 selects 256 KiB */
+    bool lock_memory;                   /* Lock process memory and pre-fault the thread stack */
+    const char *name;                   /* Thread name (optional, truncated to 15 characters) */
+} intel_hal_thread_attr_t;
+
+/* Thread entry point */
+typedef void (*intel_hal_thread_fn_t)(void *arg);
+
+/* Thread handle (opaque) */
+typedef struct intel_hal_thread intel_hal_thread_t;
+
+/**
+ * @brief Initialize thread attributes with defaults
+ *
+ * Defaults: NIC NUMA node placement, default scheduling policy, 256 KiB
+ * stack, memory not locked.
+ *
+ * @param[out] attr Attributes to initialize
+ */
+void intel_hal_thread_attr_init(intel_hal_thread_attr_t *attr);
+
+/**
+ * @brief Get the NUMA node a device is attached to
+ *
+ * @param[in] device Device handle
+ * @param[out] node NUMA node, or -1 if the platform reports none
+ * @return INTEL_HAL_SUCCESS on success, error code otherwise
+ */
+intel_hal_result_t intel_hal_get_numa_node(intel_device_t *device, int32_t *node);
+
+/**
+ * @brief Create a real-time worker thread
+ *
+ * @param[in] device Device whose NUMA node is used for INTEL_HAL_NUMA_NODE_DEVICE (may be NULL)
+ * @param[in] attr Thread attributes (NULL for defaults)
+ * @param[in] fn Thread entry point
+ * @param[in] arg Argument passed to fn
+ * @param[out] thread Thread handle, released by intel_hal_thread_join()
+ * @return INTEL_HAL_SUCCESS on success, INTEL_HAL_ERROR_ACCESS_DENIED if the
+ *         real-time policy or memory locking is not permitted, error code otherwise
+ */
+intel_hal_result_t intel_hal_thread_create(intel_device_t *device, const intel_hal_thread_attr_t *attr,
+                                           intel_hal_thread_fn_t fn, void *arg, intel_hal_thread_t **thread);
+
+/**
+ * @brief Wait for a thread to finish and release it
+ *
+ * @param[in] thread Thread handle
+ * @return INTEL_HAL_SUCCESS on success, error code otherwise
+ */
+intel_hal_result_t intel_hal_thread_join(intel_hal_thread_t *thread);
+
+/* ============================================================================
+ * PHC-time Scheduler
+ *
+ * Runs callbacks at absolute PHC times on a per-device scheduler thread.
+ * The thread sleeps on a system-clock timer whose deadline is derived from
+ * a PHC-to-system clock mapping re-sampled on every wakeup, then spins for
+ * the last few microseconds so callbacks start at fixed phases of the PHC
+ * (e.g. of a TAS cycle) rather than of the host clock.
+ * ============================================================================ */
+
+#define INTEL_HAL_SCHEDULE_INVALID_ID      0
+#define INTEL_HAL_SCHEDULER_DEFAULT_SPIN   20000  /* Default spin before a deadline (ns) */
+#define INTEL_HAL_SCHEDULER_DEFAULT_SIZE   1024   /* Default maximum pending callbacks */
+
+/* Scheduled callback handle */
+typedef uint64_t intel_hal_schedule_id_t;
+
+/* Scheduled callback; phc_time is the scheduled (not the observed) PHC time */
+typedef void (*intel_hal_schedule_fn_t)(intel_device_t *device, uint64_t phc_time, void *arg);
+
+/* Scheduler configuration */
+typedef struct {
+    uint32_t spin_ns;                   /* Busy-wait window before each deadline (0 selects default) */
+    uint32_t max_entries;               /* Maximum pending callbacks (0 selects default) */
+    intel_hal_thread_attr_t thread_attr; /* Scheduler thread placement and priority */
+} intel_hal_scheduler_config_t;
+
+/**
+ * @brief Initialize scheduler configuration with defaults
+ *
+ * @param[out] config Configuration to initialize
+ */
+void intel_hal_scheduler_config_init(intel_hal_scheduler_config_t *config);
+
+/**
+ * @brief Start the device scheduler with an explicit configuration
+ *
+ * Optional; the first intel_hal_schedule_at() or intel_hal_schedule_periodic()
+ * call starts the scheduler with defaults. The scheduler is stopped when the
+ * device is closed.
+ *
+ * @param[in] device Device handle
+ * @param[in] config Scheduler configuration (NULL for defaults)
+ * @return INTEL_HAL_SUCCESS on success, INTEL_HAL_ERROR_DEVICE_BUSY if already
+ *         started, error code otherwise
+ */
+intel_hal_result_t intel_hal_scheduler_start(intel_device_t *device, const intel_hal_scheduler_config_t *config);
+
+/**
+ * @brief Run a callback once at a PHC time
+ *
+ * Times already in the past run immediately. Callbacks run on the scheduler
+ * thread and may schedule or cancel other callbacks.
+ *
+ * @param[in] device Device handle
+ * @param[in] phc_time PHC time in nanoseconds
+ * @param[in] callback Callback function
+ * @param[in] arg Argument passed to callback
+ * @param[out] id Handle for intel_hal_schedule_cancel() (may be NULL)
+ * @return INTEL_HAL_SUCCESS on success, INTEL_HAL_ERROR_NO_MEMORY if the
+ *         scheduler is full, error code otherwise
+ */
+intel_hal_result_t intel_hal_schedule_at(intel_device_t *device, uint64_t phc_time,
+                                         intel_hal_schedule_fn_t callback, void *arg,
+                                         intel_hal_schedule_id_t *id);
+
+/**
+ * @brief Run a callback periodically on a PHC-time grid
+ *
+ * Runs at first_phc_time + n * period_ns. Missed periods (callback overran
+ * or the thread was delayed) are skipped, keeping the phase.
+ *
+ * @param[in] device Device handle
+ * @param[in] first_phc_time First PHC time in nanoseconds
+ * @param[in] period_ns Period in nanoseconds
+ * @param[in] callback Callback function
+ * @param[in] arg Argument passed to callback
+ * @param[out] id Handle for intel_hal_schedule_cancel() (may be NULL)
+ * @return INTEL_HAL_SUCCESS on success, error code otherwise
+ */
+intel_hal_result_t intel_hal_schedule_periodic(intel_device_t *device, uint64_t first_phc_time, uint64_t period_ns,
+                                               intel_hal_schedule_fn_t callback, void *arg,
+                                               intel_hal_schedule_id_t *id);
+
+/**
+ * @brief Cancel a scheduled callback
+ *
+ * Does not wait for an invocation already in progress on the scheduler thread.
+ *
+ * @param[in] device Device handle
+ * @param[in] id Handle from intel_hal_schedule_at() or intel_hal_schedule_periodic()
+ * @return INTEL_HAL_SUCCESS on success, INTEL_HAL_ERROR_INVALID_PARAM if the
+ *         callback already completed or was cancelled
+ */
+intel_hal_result_t intel_hal_schedule_cancel(intel_device_t *device, intel_hal_schedule_id_t id);
+
+/* ============================================================================
+ * Software Time-Aware Shaper
+ *
+ * On families without a hardware gate scheduler (I210/I219),
+ * intel_hal_setup_time_aware_shaper() runs the schedule in software on the
+ * device PHC-time scheduler. Frames submitted with intel_hal_soft_tas_enqueue()
+ * are held per traffic class and released at gate control entry starts,
+ * only if they complete before their gate closes, with launch times placing
+ * them back to back in the window. A frame queued while its gate is open
+ * waits for the next entry start. Best effort: release precision is that of
+ * the scheduler thread.
+ * ============================================================================ */
+
+#define INTEL_HAL_SOFT_TAS_QUEUE_DEPTH  64      /* Frames held per traffic class */
+#define INTEL_HAL_SOFT_TAS_MAX_FRAME    1526    /* Largest frame (VLAN-tagged, without FCS) */
+
+/* Software TAS counters per traffic class */
+typedef struct {
+    uint64_t enqueued[8];
+    uint64_t sent[8];
+    uint64_t dropped[8];                /* Queue full, transmit failure or schedule disabled */
+    uint32_t queued[8];                 /* Frames currently held */
+} intel_soft_tas_stats_t;
+
+/**
+ * @brief Queue a frame for release by the software Time-Aware Shaper
+ *
+ * @param[in] device Device handle
+ * @param[in] traffic_class Traffic class (0-7, bit in gate_states)
+ * @param[in] frame Frame data (copied)
+ * @param[in] length Frame length in bytes
+ * @return INTEL_HAL_SUCCESS on success, INTEL_HAL_ERROR_NO_MEMORY if the
+ *         class queue is full, INTEL_HAL_ERROR_NOT_SUPPORTED if no software
+ *         schedule is configured or it was disabled (held frames are then
+ *         counted as dropped), error code otherwise
+ */
+intel_hal_result_t intel_hal_soft_tas_enqueue(intel_device_t *device, uint8_t traffic_class,
+                                              const void *frame, size_t length);
+
+/**
+ * @brief Get software Time-Aware Shaper counters
+ *
+ * @param[in] device Device handle
+ * @param[out] stats Counters
+ * @return INTEL_HAL_SUCCESS on success, error code otherwise
+ */
+intel_hal_result_t intel_hal_soft_tas_get_stats(intel_device_t *device, intel_soft_tas_stats_t *stats);
+
+/* ============================================================================
+ * Packet Buffer Pools
+ *
+ * Fixed-size, cache-line aligned transmit buffers from hugepage memory
+ * (regular pages when no hugepages are reserved), handed out from per-thread
+ * caches backed by a lock-free free list. A pool buffer passed to
+ * intel_hal_launch_submit() is taken without a copy: on success the HAL owns
+ * it and returns it to its pool once transmitted. Pools still open when the
+ * device is closed are destroyed with it.
+ * ============================================================================ */
+
+#define INTEL_HAL_MAX_PACKET_POOLS      8       /* Pools per device */
+#define INTEL_HAL_PACKET_POOL_MAX_SIZE  16384   /* Largest buffer size in bytes */
+
+/* Packet buffer pool handle */
+typedef struct intel_hal_packet_pool intel_hal_packet_pool_t;
+
+/* Packet pool information */
+typedef struct {
+    uint32_t buffer_count;
+    uint32_t buffer_size;               /* Requested buffer size */
+    uint32_t buffer_stride;             /* Distance between buffers (cache-line multiple) */
+    uint32_t free_buffers;              /* Approximate while other threads allocate */
+    bool hugepages;                     /* Backed by explicit hugepages */
+} intel_hal_packet_pool_info_t;
+
+/**
+ * @brief Create a packet buffer pool for a device
+ *
+ * @param[in] device Device handle
+ * @param[in] count Number of buffers
+ * @param[in] size Buffer size in bytes
+ * @param[out] pool Pool handle
+ * @return INTEL_HAL_SUCCESS on success, INTEL_HAL_ERROR_NO_MEMORY if the
+ *         memory cannot be allocated or the device has no free pool slot,
+ *         error code otherwise
+ */
+intel_hal_result_t intel_hal_packet_pool_create(intel_device_t *device, uint32_t count, uint32_t size,
+                                                intel_hal_packet_pool_t **pool);
+
+/**
+ * @brief Destroy a packet buffer pool
+ *
+ * Refused while the launch scheduler still holds buffers of the pool; the
+ * pool is then left intact and can be destroyed once they are transmitted.
+ * Buffers allocated by the caller must have been returned.
+ *
+ * @param[in] pool Pool handle
+ * @return INTEL_HAL_SUCCESS on success, INTEL_HAL_ERROR_DEVICE_BUSY if
+ *         submitted buffers are still pending, error code otherwise
+ */
+intel_hal_result_t intel_hal_packet_pool_destroy(intel_hal_packet_pool_t *pool);
+
+/**
+ * @brief Take a buffer from a pool
+ *
+ * @param[in] pool Pool handle
+ * @return Buffer, or NULL if the pool is exhausted
+ */
+void *intel_hal_packet_alloc(intel_hal_packet_pool_t *pool);
+
+/**
+ * @brief Return a buffer to its pool
+ *
+ * @param[in] pool Pool handle
+ * @param[in] buffer Buffer from intel_hal_packet_alloc()
+ */
+void intel_hal_packet_free(intel_hal_packet_pool_t *pool, void *buffer);
+
+/**
+ * @brief Get packet pool information
+ *
+ * @param[in] pool Pool handle
+ * @param[out] info Pool information
+ * @return INTEL_HAL_SUCCESS on success, error code otherwise
+ */
+intel_hal_result_t intel_hal_packet_pool_get_info(intel_hal_packet_pool_t *pool, intel_hal_packet_pool_info_t *info);
+
+/* ============================================================================
+ * Launch-time Transmit Scheduler
+ *
+ * Timed packets submitted with intel_hal_launch_submit() are held in a
+ * timing wheel and passed to intel_hal_xmit_timed_packet() a lead time
+ * before their launch time, so far-future frames never sit in the shallow
+ * FIFO hardware launch queues ahead of earlier ones. Submission is O(1) and
+ * may be in any order; releases run on the device PHC-time scheduler.
+ * Launch times handed to a hardware queue never decrease: a frame submitted
+ * after a later frame of the same queue was released goes out right after it.
+ * ============================================================================ */
+
+#define INTEL_HAL_LAUNCH_DEFAULT_LEAD   500000  /* Default release lead before launch time (ns) */
+#define INTEL_HAL_LAUNCH_DEFAULT_SIZE   4096    /* Default maximum pending packets */
+#define INTEL_HAL_LAUNCH_MAX_FRAME      1526    /* Largest frame (VLAN-tagged, without FCS) */
+
+/* Launch scheduler configuration */
+typedef struct {
+    uint32_t lead_ns;                   /* Release lead before launch time (0 selects default) */
+    uint32_t max_packets;               /* Maximum pending packets (0 selects default) */
+} intel_hal_launch_config_t;
+
+/* Launch scheduler counters */
+typedef struct {
+    uint64_t submitted;
+    uint64_t released;                  /* Handed to the hardware queue */
+    uint64_t failed;                    /* Transmit failures on release */
+    uint64_t rejected;                  /* Submissions refused because the scheduler was full */
+    uint64_t clamped;                   /* Launch time raised to keep the queue monotonic */
+    uint64_t late;                      /* Released with a launch time already due */
+    uint32_t pending;                   /* Packets currently held */
+} intel_hal_launch_stats_t;
+
+/**
+ * @brief Initialize launch scheduler configuration with defaults
+ *
+ * @param[out] config Configuration to initialize
+ */
+void intel_hal_launch_config_init(intel_hal_launch_config_t *config);
+
+/**
+ * @brief Start the device launch scheduler with an explicit configuration
+ *
+ * Optional; the first intel_hal_launch_submit() call starts the launch
+ * scheduler with defaults. It is stopped when the device is closed.
+ *
+ * @param[in] device Device handle
+ * @param[in] config Launch scheduler configuration (NULL for defaults)
+ * @return INTEL_HAL_SUCCESS on success, INTEL_HAL_ERROR_DEVICE_BUSY if already
+ *         started, error code otherwise
+ */
+intel_hal_result_t intel_hal_launch_scheduler_start(intel_device_t *device, const intel_hal_launch_config_t *config);
+
+/**
+ * @brief Submit a timed packet for release before its launch time
+ *
+ * @param[in] device Device handle
+ * @param[in] packet Timed packet (data copied unless it is a pool buffer,
+ *                   which the HAL then owns)
+ * @return INTEL_HAL_SUCCESS on success, INTEL_HAL_ERROR_NO_MEMORY if the
+ *         launch scheduler is full, error code otherwise
+ */
+intel_hal_result_t intel_hal_launch_submit(intel_device_t *device, const intel_timed_packet_t *packet);
+
+/**
+ * @brief Get launch scheduler counters (all zero before it is started)
+ *
+ * @param[in] device Device handle
+ * @param[out] stats Counters
+ * @return INTEL_HAL_SUCCESS on success, error code otherwise
+ */
+intel_hal_result_t intel_hal_launch_get_stats(intel_device_t *device, intel_hal_launch_stats_t *stats);
+
+/* ============================================================================
+ * IEEE 1722 AVTP Talker
+ *
+ * Per-stream VLAN-tagged Ethernet + AVTP common stream header templates.
+ * The caller writes the payload at INTEL_AVTP_HEADER_SIZE into its frame
+ * buffer (ideally a packet pool buffer); preparing the frame fills in the
+ * header with the next sequence number and the presentation time
+ * (launch time + transit time) as 32-bit gPTP time. No per-frame allocation.
+ * ============================================================================ */
+
+#define INTEL_AVTP_HEADER_SIZE          42          /* Ethernet + VLAN tag + AVTP common stream header */
+#define INTEL_AVTP_DEFAULT_TRANSIT      2000000     /* Class A maximum transit time (ns) */
+
+/* AVTP subtypes (IEEE 1722-2016 Table 6) */
+#define INTEL_AVTP_SUBTYPE_61883_IIDC   0x00
+#define INTEL_AVTP_SUBTYPE_AAF          0x02
+#define INTEL_AVTP_SUBTYPE_CVF          0x03
+#define INTEL_AVTP_SUBTYPE_CRF          0x04
+
+/* AVTP stream configuration */
+typedef struct {
+    uint8_t dest_mac[6];                /* Stream destination address */
+    uint8_t src_mac[6];
+    uint16_t vlan_id;
+    uint8_t vlan_pcp;                   /* SR class priority */
+    uint8_t subtype;                    /* INTEL_AVTP_SUBTYPE_* */
+    uint64_t stream_id;
+    uint32_t format_specific_1;         /* Bytes 12-15 of the AVTPDU (e.g. AAF format, nsr, channels, bit depth) */
+    uint16_t format_specific_2;         /* Bytes 18-19 of the AVTPDU (e.g. AAF sp, evt) */
+    uint8_t queue;                      /* Transmit queue */
+    uint32_t launch_offset_ns;          /* Launch time after the PHC reading in intel_hal_avtp_transmit() */
+    uint32_t transit_time_ns;           /* Presentation time after launch (0 selects Class A default) */
+} intel_avtp_stream_config_t;
+
+/* AVTP stream state, filled by intel_hal_avtp_stream_init() */
+typedef struct {
+    uint8_t header[INTEL_AVTP_HEADER_SIZE];
+    uint8_t sequence;
+    uint8_t queue;
+    uint32_t launch_offset_ns;
+    uint32_t transit_time_ns;
+} intel_avtp_stream_t;
+
+/**
+ * @brief Build the header template of an AVTP stream
+ *
+ * @param[out] stream Stream state
+ * @param[in] config Stream configuration
+ * @return INTEL_HAL_SUCCESS on success, error code otherwise
+ */
+intel_hal_result_t intel_hal_avtp_stream_init(intel_avtp_stream_t *stream, const intel_avtp_stream_config_t *config);
+
+/**
+ * @brief Fill in the header of a stream frame for a launch time
+ *
+ * Advances the stream sequence number. The resulting packet can be passed
+ * to intel_hal_xmit_timed_packet() or intel_hal_launch_submit().
+ *
+ * @param[in] stream Stream state
+ * @param[in,out] frame Frame buffer with the payload at INTEL_AVTP_HEADER_SIZE
+ * @param[in] payload_length Payload length in bytes (stream_data_length)
+ * @param[in] launch_time Launch time in nanoseconds (PHC time)
+ * @param[out] packet Timed packet describing the frame
+ * @return INTEL_HAL_SUCCESS on success, error code otherwise
+ */
+intel_hal_result_t intel_hal_avtp_prepare(intel_avtp_stream_t *stream, void *frame, size_t payload_length,
+                                          uint64_t launch_time, intel_timed_packet_t *packet);
+
+/**
+ * @brief Prepare and transmit a stream frame
+ *
+ * @param[in] device Device handle
+ * @param[in] stream Stream state
+ * @param[in,out] frame Frame buffer with the payload at INTEL_AVTP_HEADER_SIZE
+ * @param[in] payload_length Payload length in bytes
+ * @param[in] launch_time Launch time in nanoseconds, or 0 for the current
+ *                        PHC time plus the stream launch offset
+ * @return INTEL_HAL_SUCCESS on success, error code otherwise
+ */
+intel_hal_result_t intel_hal_avtp_transmit(intel_device_t *device, intel_avtp_stream_t *stream,
+                                           void *frame, size_t payload_length, uint64_t launch_time);
+
+/* ============================================================================
+ * AVTP Clock Reference Format Generator
+ *
+ * Emits CRF PDUs whose timestamps follow a media clock locked to the PHC:
+ * the clock grid is anchored once at start and advanced exactly, so the
+ * timestamps carry no per-frame clock read jitter. Each PDU is sent at the
+ * media clock event of its first timestamp; timestamps are event time plus
+ * transit time. Batches are built on the device PHC-time scheduler and
+ * queued with the launch-time scheduler; stop generators before closing
+ * the device.
+ * ============================================================================ */
+
+#define INTEL_CRF_HEADER_SIZE           38          /* Ethernet + VLAN tag + CRF header */
+#define INTEL_CRF_MAX_TIMESTAMPS        16          /* Timestamps per PDU */
+#define INTEL_CRF_DEFAULT_LEAD          1000000     /* Default time a batch is built before launch (ns) */
+
+/* CRF types */
+#define INTEL_CRF_TYPE_AUDIO_SAMPLE     1
+#define INTEL_CRF_TYPE_VIDEO_FRAME      2
+#define INTEL_CRF_TYPE_VIDEO_LINE       3
+#define INTEL_CRF_TYPE_MACHINE_CYCLE    4
+
+/* CRF stream configuration */
+typedef struct {
+    uint8_t dest_mac[6];
+    uint8_t src_mac[6];
+    uint16_t vlan_id;
+    uint8_t vlan_pcp;
+    uint64_t stream_id;
+    uint8_t crf_type;                   /* INTEL_CRF_TYPE_* */
+    uint32_t base_frequency;            /* Media clock base frequency in Hz (29 bits) */
+    uint8_t pull;                       /* Multiplier code: 0 x1, 1 x1/1.001, 2 x1.001, 3 x24/25, 4 x25/24, 5 x1/8 */
+    uint16_t timestamp_interval;        /* Media clock events between timestamps */
+    uint8_t timestamps_per_pdu;         /* 1 to INTEL_CRF_MAX_TIMESTAMPS */
+    uint8_t pdus_per_batch;             /* PDUs built per scheduler wakeup (0 selects 1) */
+    uint8_t queue;                      /* Transmit queue */
+    uint32_t transit_time_ns;           /* Timestamp offset from the event (0 selects Class A default) */
+    uint32_t lead_ns;                   /* Batch built this long before its first launch (0 selects default) */
+} intel_crf_config_t;
+
+/* CRF generator counters */
+typedef struct {
+    uint64_t pdus_sent;
+    uint64_t pdus_failed;
+    uint64_t next_event_ns;             /* Media clock event of the next timestamp */
+    bool stalled;                       /* Rescheduling failed; no further PDUs */
+} intel_crf_stats_t;
+
+/* CRF generator handle */
+typedef struct intel_crf_generator intel_crf_generator_t;
+
+/**
+ * @brief Start a CRF stream
+ *
+ * @param[in] device Device handle
+ * @param[in] config Stream configuration
+ * @param[out] generator Generator handle
+ * @return INTEL_HAL_SUCCESS on success, error code otherwise
+ */
+intel_hal_result_t intel_hal_crf_start(intel_device_t *device, const intel_crf_config_t *config,
+                                       intel_crf_generator_t **generator);
+
+/**
+ * @brief Stop a CRF stream and release the generator
+ *
+ * Waits for a batch being built to finish. Must not be called from a
+ * PHC-time scheduler callback. PDUs already queued for launch are still sent.
+ *
+ * @param[in] generator Generator handle
+ */
+void intel_hal_crf_stop(intel_crf_generator_t *generator);
+
+/**
+ * @brief Get CRF generator counters
+ *
+ * @param[in] generator Generator handle
+ * @param[out] stats Counters
+ * @return INTEL_HAL_SUCCESS on success, error code otherwise
+ */
+intel_hal_result_t intel_hal_crf_get_stats(intel_crf_generator_t *generator, intel_crf_stats_t *stats);
+
+/* ============================================================================
+ * Media Clock Recovery
+ *
+ * Listener-side software PLL recovering a talker media clock from AVTP
+ * presentation times or CRF timestamps, which are gPTP times and so
+ * directly comparable with the PHC. The result is the media clock rate
+ * (and its ratio to nominal) in PHC time and the predicted time of media
+ * clock events. The caller owns the state; updates do not allocate.
+ * ============================================================================ */
+
+#define INTEL_MCR_DEFAULT_BANDWIDTH         1.0         /* Loop bandwidth (Hz) */
+#define INTEL_MCR_DEFAULT_LOCK_THRESHOLD    1000        /* Phase error for lock (ns) */
+#define INTEL_MCR_DEFAULT_RESET_THRESHOLD   1000000     /* Phase error that restarts acquisition (ns) */
+
+/* Recovery state */
+typedef enum {
+    INTEL_MCR_IDLE = 0,                 /* No measurement yet */
+    INTEL_MCR_ACQUIRING,
+    INTEL_MCR_LOCKED
+} intel_mcr_lock_state_t;
+
+/* Media clock recovery configuration */
+typedef struct {
+    double nominal_rate_hz;             /* Nominal media clock (event) rate, e.g. 48000 */
+    double bandwidth_hz;                /* PLL natural frequency */
+    double damping;                     /* PLL damping factor */
+    uint32_t lock_threshold_ns;
+    uint32_t reset_threshold_ns;
+} intel_mcr_config_t;
+
+/* Media clock recovery state (filled by intel_hal_mcr_init()) */
+typedef struct {
+    intel_mcr_config_t config;
+    intel_mcr_lock_state_t state;
+    double nominal_period_ns;
+    double period_ns;                   /* Recovered event period */
+    uint64_t last_event_ns;             /* Recovered time of the last measured event */
+    double last_event_frac;             /* Fractional nanoseconds of last_event_ns */
+    int64_t phase_error_ns;
+    uint32_t in_lock;
+    uint64_t updates;
+    uint64_t resets;
+    uint64_t late;
+} intel_mcr_t;
+
+/* Media clock recovery output */
+typedef struct {
+    intel_mcr_lock_state_t state;
+    double rate_hz;                     /* Recovered rate in PHC time */
+    double rate_ratio;                  /* Recovered rate / nominal rate */
+    int64_t phase_error_ns;             /* Last measurement minus prediction */
+    uint64_t last_event_ns;
+    uint64_t updates;
+    uint64_t resets;                    /* Acquisition restarts after phase errors */
+    uint64_t late;                      /* Presentation times already past on reception */
+} intel_mcr_state_t;
+
+/**
+ * @brief Initialize media clock recovery configuration with defaults
+ *
+ * @param[out] config Configuration to initialize
+ */
+void intel_hal_mcr_config_init(intel_mcr_config_t *config);
+
+/**
+ * @brief Initialize media clock recovery
+ *
+ * @param[out] mcr Recovery state
+ * @param[in] config Configuration
+ * @return INTEL_HAL_SUCCESS on success, error code otherwise
+ */
+intel_hal_result_t intel_hal_mcr_init(intel_mcr_t *mcr, const intel_mcr_config_t *config);
+
+/**
+ * @brief Feed the presentation time of a received AVTP stream frame
+ *
+ * @param[in,out] mcr Recovery state
+ * @param[in] avtp_timestamp 32-bit avtp_timestamp of the frame
+ * @param[in] rx_time_ns Hardware receive timestamp of the frame (PHC time)
+ * @param[in] event_delta Media clock events (e.g. samples) since the previous frame
+ * @return INTEL_HAL_SUCCESS on success, error code otherwise
+ */
+intel_hal_result_t intel_hal_mcr_feed_avtp(intel_mcr_t *mcr, uint32_t avtp_timestamp, uint64_t rx_time_ns,
+                                           uint32_t event_delta);
+
+/**
+ * @brief Feed the timestamps of a received CRF PDU
+ *
+ * Lost PDUs are bridged by counting whole timestamp intervals.
+ *
+ * @param[in,out] mcr Recovery state
+ * @param[in] timestamps CRF timestamps (host byte order)
+ * @param[in] count Number of timestamps
+ * @param[in] timestamp_interval Media clock events between timestamps
+ * @param[in] rx_time_ns Hardware receive timestamp of the PDU (PHC time)
+ * @return INTEL_HAL_SUCCESS on success, error code otherwise
+ */
+intel_hal_result_t intel_hal_mcr_feed_crf(intel_mcr_t *mcr, const uint64_t *timestamps, uint32_t count,
+                                          uint32_t timestamp_interval, uint64_t rx_time_ns);
+
+/**
+ * @brief Get the recovered media clock
+ *
+ * @param[in] mcr Recovery state
+ * @param[out] state Recovered rate, phase and counters
+ * @return INTEL_HAL_SUCCESS on success, error code otherwise
+ */
+intel_hal_result_t intel_hal_mcr_get_state(const intel_mcr_t *mcr, intel_mcr_state_t *state);
+
+/**
+ * @brief Predict the PHC time of a media clock event
+ *
+ * @param[in] mcr Recovery state
+ * @param[in] events_ahead Events after the last measured one (may be negative)
+ * @return Predicted PHC time in nanoseconds
+ */
+uint64_t intel_hal_mcr_event_time(const intel_mcr_t *mcr, int64_t events_ahead);
+
+/* ============================================================================
+ * Egress Pipeline Simulation
+ *
+ * Discrete-event model of the I225/I226 transmit path in virtual
+ * nanosecond time: per-class FIFO queues with launch-time gating, TAS
+ * gates (a frame starts only if it ends before its gate closes), CBS
+ * credits, strict priority by traffic class and frame preemption of
+ * preemptible classes by express ones. Takes the same configuration
+ * structures as the device calls; nothing touches hardware.
+ * ============================================================================ */
+
+/* Simulated port configuration */
+typedef struct {
+    uint32_t link_speed_mbps;
+    bool tas_enabled;
+    intel_tas_config_t tas;             /* Intervals must sum to cycle_time */
+    intel_cbs_config_t cbs[8];          /* Per traffic class */
+    bool fp_enabled;
+    intel_frame_preemption_config_t fp; /* Bit n of preemptible_queues = class n */
+} intel_egress_sim_config_t;
+
+/* Simulated frame; packet.queue is the traffic class, launch_time 0 for none */
+typedef struct {
+    uint64_t arrival_ns;                /* Time the frame is queued */
+    intel_timed_packet_t packet;        /* packet_data is not accessed */
+} intel_egress_sim_frame_t;
+
+/* Departure of one frame */
+typedef struct {
+    uint64_t start_ns;                  /* First bit of the preamble on the wire */
+    uint64_t end_ns;                    /* Last bit of the FCS */
+    uint32_t preemptions;
+    bool dropped;                       /* Longer than every gate window of its class */
+    bool blocked;                       /* Never eligible to start; start_ns and end_ns are 0 */
+} intel_egress_sim_result_t;
+
+/* Per-traffic-class simulation results */
+typedef struct {
+    uint64_t frames;                    /* Transmitted */
+    uint64_t dropped;
+    uint64_t blocked;
+    uint64_t preemptions;
+    uint64_t min_latency_ns;            /* Arrival to end of frame */
+    uint64_t max_latency_ns;
+    double mean_latency_ns;
+    uint64_t max_launch_delay_ns;       /* Start after the requested launch time */
+} intel_egress_sim_tc_stats_t;
+
+/* Simulation results */
+typedef struct {
+    intel_egress_sim_tc_stats_t tc[8];
+    uint64_t end_time_ns;               /* Last bit of the last frame */
+    uint64_t busy_ns;                   /* Time the link was transmitting */
+} intel_egress_sim_stats_t;
+
+/**
+ * @brief Initialize a simulated port with all gates open and no shaping
+ *
+ * @param[out] config Configuration to initialize
+ * @param[in] link_speed_mbps Link speed in Mbps
+ */
+void intel_hal_egress_sim_config_init(intel_egress_sim_config_t *config, uint32_t link_speed_mbps);
+
+/**
+ * @brief Simulate the egress of a frame sequence
+ *
+ * Frames of one class leave in arrival order. Express classes go before
+ * preemptible ones, higher classes first within each. A preemptible frame
+ * is interrupted when an express frame becomes eligible, once the minimum
+ * fragment has been sent and a minimum fragment remains. CBS credit
+ * accrues while a class has frames queued or negative credit. Runs in
+ * O(frames * classes * log entries).
+ *
+ * @param[in] config Simulated port
+ * @param[in] frames Frames sorted by arrival time
+ * @param[in] count Number of frames
+ * @param[out] results Departure of each frame (count entries)
+ * @param[out] stats Per-class latency (may be NULL)
+ * @return INTEL_HAL_SUCCESS on success, error code otherwise
+ */
+intel_hal_result_t intel_hal_egress_simulate(const intel_egress_sim_config_t *config,
+                                             const intel_egress_sim_frame_t *frames, uint32_t count,
+                                             intel_egress_sim_result_t *results, intel_egress_sim_stats_t *stats);
+
+/* ============================================================================
+ * Scheduled Configuration Changes
+ *
+ * Configuration changes applied at a PHC time. TAS changes on families with
+ * a hardware gate scheduler (I225/I226) are programmed immediately with the
+ * activation time as base time and staged like intel_hal_tas_stage_update(),
+ * so status queries report the running schedule until then; all other
+ * changes are applied by the device PHC-time scheduler. Each change that is not cancelled produces one
+ * completion, signalled on the device configuration event.
+ * ============================================================================ */
+
+#define INTEL_HAL_CONFIG_COMPLETION_DEPTH  256    /* Completions kept before the oldest are dropped */
+
+/* Waitable completion event: eventfd on Linux, auto-reset event on Windows */
+#ifdef INTEL_HAL_WINDOWS
+typedef HANDLE intel_hal_event_handle_t;
+#else
+typedef int intel_hal_event_handle_t;
+#endif
+
+typedef enum {
+    INTEL_HAL_CHANGE_VLAN_FILTER = 0,
+    INTEL_HAL_CHANGE_PRIORITY_MAP,
+    INTEL_HAL_CHANGE_CBS,
+    INTEL_HAL_CHANGE_TAS
+} intel_hal_change_type_t;
+
+/* One configuration change */
+typedef struct {
+    intel_hal_change_type_t type;
+    union {
+        struct {
+            uint16_t vlan_id;
+            bool enable;
+        } vlan;
+        struct {
+            uint8_t priority;
+            uint8_t traffic_class;
+        } priority_map;
+        struct {
+            uint8_t traffic_class;
+            intel_cbs_config_t config;
+        } cbs;
+        intel_tas_config_t tas;         /* base_time is moved to the first cycle start at or after activation */
+    } u;
+} intel_hal_config_change_t;
+
+/* Completion of a scheduled change */
+typedef struct {
+    uint64_t change_id;
+    intel_hal_result_t result;
+    uint64_t activation_time;           /* Requested PHC time (TAS: base time programmed) */
+    uint64_t applied_time;              /* PHC time the change took effect */
+} intel_hal_config_completion_t;
+
+/**
+ * @brief Submit a configuration change to take effect at a PHC time
+ *
+ * Parameters and device capabilities are checked at submit time. Times
+ * already in the past are applied immediately.
+ *
+ * @param[in] device Device handle
+ * @param[in] change Configuration change
+ * @param[in] activation_time PHC time in nanoseconds
+ * @param[out] change_id Identifier reported in the completion (may be NULL)
+ * @return INTEL_HAL_SUCCESS on success, error code otherwise
+ */
+intel_hal_result_t intel_hal_submit_config_change(intel_device_t *device, const intel_hal_config_change_t *change,
+                                                  uint64_t activation_time, uint64_t *change_id);
+
+/**
+ * @brief Cancel a scheduled configuration change before it takes effect
+ *
+ * A cancelled change produces no completion. Waits for a change being
+ * applied concurrently and then fails, as that change completes normally.
+ * Must not be called from a PHC-time scheduler callback.
+ *
+ * @param[in] device Device handle
+ * @param[in] change_id Identifier returned by intel_hal_submit_config_change()
+ * @return INTEL_HAL_SUCCESS if cancelled, INTEL_HAL_ERROR_NOT_SUPPORTED for TAS
+ *         changes already programmed into a hardware gate scheduler,
+ *         INTEL_HAL_ERROR_INVALID_PARAM if unknown or already applied
+ */
+intel_hal_result_t intel_hal_cancel_config_change(intel_device_t *device, uint64_t change_id);
+
+/**
+ * @brief Get the event signalled when configuration changes complete
+ *
+ * The event is owned by the device and closed by intel_hal_close_device().
+ *
+ * @param[in] device Device handle
+ * @param[out] event Event handle to poll or wait on
+ * @return INTEL_HAL_SUCCESS on success, error code otherwise
+ */
+intel_hal_result_t intel_hal_get_config_event(intel_device_t *device, intel_hal_event_handle_t *event);
+
+/**
+ * @brief Read completed configuration changes (non-blocking)
+ *
+ * @param[in] device Device handle
+ * @param[out] completions Completion array
+ * @param[in] max_completions Size of completions array
+ * @param[out] count Number of completions returned
+ * @return INTEL_HAL_SUCCESS on success, error code otherwise
+ */
+intel_hal_result_t intel_hal_read_config_completions(intel_device_t *device, intel_hal_config_completion_t *completions,
+                                                     uint32_t max_completions, uint32_t *count);
+
 /**
  * @brief Get HAL version string
  * 
@@ -0,0 +1,348 @@
+/******************************************************************************
+
+  Copyright (c) 2025, Intel Corporation
+  All rights reserved.
+
+  Intel Ethernet HAL - C++ API
+
+  Header-only C++ layer over intel_ethernet_hal.h. intel::device<Family> is a
+  move-only owner of an open device handle whose capabilities are known at
+  compile time from intel::family_traits. Calls a family cannot support fail
+  to compile; supported calls use the pre-validated C entry points and skip
+  the per-call runtime capability checks. intel::phc_clock adapts a device
+  PHC to std::chrono.
+
+******************************************************************************/
+
+#ifndef INTEL_ETHERNET_HAL_HPP
+#define INTEL_ETHERNET_HAL_HPP
+
+#include "intel_ethernet_hal.h"
+
+#include <chrono>
+#include <ratio>
+
+#ifdef INTEL_HAL_LINUX
+#include <time.h>
+#endif
+
+namespace intel {
+
+namespace detail {
+
+constexpr uint32_t family_capabilities(intel_device_family_t family)
+{
+    return family == INTEL_FAMILY_I210 ? INTEL_FAMILY_I210_CAPABILITIES :
+           family == INTEL_FAMILY_I219 ? INTEL_FAMILY_I219_CAPABILITIES :
+           family == INTEL_FAMILY_I225 ? INTEL_FAMILY_I225_CAPABILITIES :
+           family == INTEL_FAMILY_I226 ? INTEL_FAMILY_I226_CAPABILITIES : 0;
+}
+
+} // namespace detail
+
+/**
+ * @brief Compile-time capabilities of a device family
+ *
+ * Mirrors the per-family entries of the HAL device database
+ * (INTEL_FAMILY_*_CAPABILITIES).
+ */
+template <intel_device_family_t Family>
+struct family_traits {
+    static_assert(Family != INTEL_FAMILY_UNKNOWN, "intel::family_traits requires a known device family");
+
+    static constexpr intel_device_family_t family = Family;
+    static constexpr uint32_t capabilities = detail::family_capabilities(Family);
+
+    static constexpr bool has_basic_1588 = (capabilities & INTEL_CAP_BASIC_1588) != 0;
+    static constexpr bool has_enhanced_ts = (capabilities & INTEL_CAP_ENHANCED_TS) != 0;
+    static constexpr bool has_tas = (capabilities & INTEL_CAP_TSN_TAS) != 0;
+    static constexpr bool has_fp = (capabilities & INTEL_CAP_TSN_FP) != 0;
+    static constexpr bool has_ptm = (capabilities & INTEL_CAP_PCIe_PTM) != 0;
+    static constexpr bool has_vlan_filter = (capabilities & INTEL_CAP_VLAN_FILTER) != 0;
+    static constexpr bool has_qos_priority = (capabilities & INTEL_CAP_QOS_PRIORITY) != 0;
+    static constexpr bool has_cbs = (capabilities & INTEL_CAP_AVB_SHAPING) != 0;
+    static constexpr bool has_advanced_qos = (capabilities & INTEL_CAP_ADVANCED_QOS) != 0;
+
+    /** Maximum link speed in Mbps */
+    static constexpr uint32_t max_speed = (capabilities & INTEL_CAP_2_5G) != 0 ? 2500 : 1000;
+};
+
+/**
+ * @brief Move-only owner of an open device of a known family
+ *
+ * The family is verified once in open(); afterwards every call whose
+ * capability is proven by family_traits goes straight to the hardware path.
+ */
+template <intel_device_family_t Family>
+class device {
+public:
+    typedef family_traits<Family> traits;
+
+    device() noexcept : handle_(nullptr) {}
+    ~device() { reset(); }
+
+    device(const device &) = delete;
+    device &operator=(const device &) = delete;
+
+    device(device &&other) noexcept : handle_(other.handle_) { other.handle_ = nullptr; }
+
+    device &operator=(device &&other) noexcept
+    {
+        if (this != &other) {
+            reset();
+            handle_ = other.handle_;
+            other.handle_ = nullptr;
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Open a device and bind it to this family
+     *
+     * @param[in] device_id PCI device ID or interface name (see intel_hal_open_device)
+     * @param[out] out Receives the open device; any previously owned device is closed
+     * @return INTEL_HAL_SUCCESS on success, INTEL_HAL_ERROR_NOT_SUPPORTED if the
+     *         device is not of family Family, error code otherwise
+     */
+    static intel_hal_result_t open(const char *device_id, device &out)
+    {
+        intel_device_t *handle = nullptr;
+        intel_device_info_t info;
+        intel_hal_result_t result = intel_hal_open_device(device_id, &handle);
+        if (result != INTEL_HAL_SUCCESS) {
+            return result;
+        }
+
+        result = intel_hal_get_device_info(handle, &info);
+        if (result == INTEL_HAL_SUCCESS && info.family != Family) {
+            result = INTEL_HAL_ERROR_NOT_SUPPORTED;
+        }
+        if (result != INTEL_HAL_SUCCESS) {
+            intel_hal_close_device(handle);
+            return result;
+        }
+
+        out.reset();
+        out.handle_ = handle;
+        return INTEL_HAL_SUCCESS;
+    }
+
+    /** @brief Close the owned device, if any */
+    void reset() noexcept
+    {
+        if (handle_) {
+            intel_hal_close_device(handle_);
+            handle_ = nullptr;
+        }
+    }
+
+    /** @brief Underlying C handle for calls not covered by this wrapper */
+    intel_device_t *get() const noexcept { return handle_; }
+
+    explicit operator bool() const noexcept { return handle_ != nullptr; }
+
+    intel_hal_result_t read_timestamp(intel_timestamp_t &timestamp) const
+    {
+        static_assert(traits::has_basic_1588, "device family does not support IEEE 1588 timestamping");
+        return intel_hal_read_timestamp_unchecked(handle_, &timestamp);
+    }
+
+    intel_hal_result_t set_timestamp(const intel_timestamp_t &timestamp) const
+    {
+        static_assert(traits::has_basic_1588, "device family does not support IEEE 1588 timestamping");
+        return intel_hal_set_timestamp_unchecked(handle_, &timestamp);
+    }
+
+    intel_hal_result_t adjust_frequency(int32_t ppb_adjustment) const
+    {
+        static_assert(traits::has_basic_1588, "device family does not support frequency adjustment");
+        return intel_hal_adjust_frequency_unchecked(handle_, ppb_adjustment);
+    }
+
+    /**
+     * @brief Configure the Credit-Based Shaper of a traffic class
+     *
+     * @param[in] traffic_class Traffic class (0-7); not range-checked
+     * @param[in] config CBS configuration
+     */
+    intel_hal_result_t configure_cbs(uint8_t traffic_class, const intel_cbs_config_t &config) const
+    {
+        static_assert(traits::has_cbs, "device family does not support the Credit-Based Shaper");
+        return intel_hal_configure_cbs_unchecked(handle_, traffic_class, &config);
+    }
+
+    intel_hal_result_t setup_time_aware_shaper(const intel_tas_config_t &config) const
+    {
+        static_assert(traits::has_tas, "device family does not support hardware Time-Aware Shaping (I225/I226 only)");
+        return intel_hal_setup_time_aware_shaper_unchecked(handle_, &config);
+    }
+
+    intel_hal_result_t setup_frame_preemption(const intel_frame_preemption_config_t &config) const
+    {
+        static_assert(traits::has_fp, "device family does not support Frame Preemption (I225/I226 only)");
+        return intel_hal_setup_frame_preemption_unchecked(handle_, &config);
+    }
+
+private:
+    intel_device_t *handle_;
+};
+
+/* ============================================================================
+ * PHC clock adapter
+ * ============================================================================ */
+
+/** @brief Nanosecond duration of an intel_timestamp_t (sub-ns fraction dropped) */
+inline std::chrono::nanoseconds to_duration(const intel_timestamp_t &timestamp) noexcept
+{
+    return std::chrono::nanoseconds(static_cast<int64_t>(timestamp.seconds) * 1000000000LL +
+                                    static_cast<int64_t>(timestamp.nanoseconds));
+}
+
+/** @brief intel_timestamp_t of a non-negative nanosecond duration */
+inline intel_timestamp_t to_timestamp(std::chrono::nanoseconds duration) noexcept
+{
+    intel_timestamp_t timestamp;
+    int64_t ns = duration.count();
+    timestamp.seconds = static_cast<uint64_t>(ns / 1000000000LL);
+    timestamp.nanoseconds = static_cast<uint32_t>(ns % 1000000000LL);
+    timestamp.fractional_ns = 0;
+    return timestamp;
+}
+
+/**
+ * @brief std::chrono TrivialClock over a device PTP hardware clock
+ *
+ * The epoch is the PHC epoch, which is TAI when the PHC is disciplined by
+ * gPTP. std::chrono requires a static now(), so each clock type is bound to
+ * one device with bind(); use distinct Tag types for several PHCs. bind()
+ * must happen before now() is used from other threads.
+ *
+ * now() uses the cheapest read path available: on Linux the PHC character
+ * device is read directly through its dynamic POSIX clock id; otherwise the
+ * pre-validated intel_hal_read_timestamp_unchecked() path is used.
+ */
+template <typename Tag = void>
+class basic_phc_clock {
+public:
+    typedef int64_t rep;
+    typedef std::nano period;
+    typedef std::chrono::duration<rep, period> duration;
+    typedef std::chrono::time_point<basic_phc_clock> time_point;
+    static constexpr bool is_steady = false;   /* PHC is stepped and slewed by the servo */
+
+    /**
+     * @brief Bind the clock to a device
+     *
+     * @param[in] device Open device with INTEL_CAP_BASIC_1588, or NULL to unbind
+     * @return INTEL_HAL_SUCCESS on success, error code otherwise
+     */
+    static intel_hal_result_t bind(intel_device_t *device)
+    {
+        state &st = get_state();
+        if (!device) {
+            st.device = nullptr;
+            return INTEL_HAL_SUCCESS;
+        }
+        if (!intel_hal_has_capability(device, INTEL_CAP_BASIC_1588)) {
+            return INTEL_HAL_ERROR_NOT_SUPPORTED;
+        }
+#ifdef INTEL_HAL_LINUX
+        intel_device_info_t info;
+        intel_hal_result_t result = intel_hal_get_device_info(device, &info);
+        if (result != INTEL_HAL_SUCCESS) {
+            return result;
+        }
+        st.has_clock_id = info.linux.has_phc && info.linux.ptp_fd >= 0;
+        st.clock_id = st.has_clock_id ? fd_to_clock_id(info.linux.ptp_fd) : CLOCK_REALTIME;
+#endif
+        st.device = device;
+        return INTEL_HAL_SUCCESS;
+    }
+
+    /** @brief Current PHC time; the epoch (zero) if unbound or the read fails */
+    static time_point now() noexcept
+    {
+        const state &st = get_state();
+#ifdef INTEL_HAL_LINUX
+        if (st.has_clock_id && st.device) {
+            struct timespec ts;
+            if (clock_gettime(st.clock_id, &ts) != 0) {
+                return time_point();
+            }
+            return time_point(duration(static_cast<rep>(ts.tv_sec) * 1000000000LL + ts.tv_nsec));
+        }
+#endif
+        intel_timestamp_t timestamp;
+        if (!st.device || intel_hal_read_timestamp_unchecked(st.device, &timestamp) != INTEL_HAL_SUCCESS) {
+            return time_point();
+        }
+        return from_timestamp(timestamp);
+    }
+
+    static time_point from_timestamp(const intel_timestamp_t &timestamp) noexcept
+    {
+        return time_point(to_duration(timestamp));
+    }
+
+    static intel_timestamp_t to_timestamp(time_point tp) noexcept
+    {
+        return intel::to_timestamp(tp.time_since_epoch());
+    }
+
+    /**
+     * @brief Convert PHC (TAI) time to system_clock (UTC) time
+     *
+     * @param[in] tp PHC time point
+     * @param[in] tai_utc_offset TAI - UTC (37 s since 2017-01-01)
+     */
+    static std::chrono::system_clock::time_point to_sys(time_point tp,
+                                                        std::chrono::seconds tai_utc_offset = std::chrono::seconds(37))
+    {
+        return std::chrono::system_clock::time_point(
+            std::chrono::duration_cast<std::chrono::system_clock::duration>(tp.time_since_epoch() - tai_utc_offset));
+    }
+
+    /** @brief Convert system_clock (UTC) time to PHC (TAI) time */
+    static time_point from_sys(std::chrono::system_clock::time_point tp,
+                               std::chrono::seconds tai_utc_offset = std::chrono::seconds(37))
+    {
+        return time_point(std::chrono::duration_cast<duration>(tp.time_since_epoch() + tai_utc_offset));
+    }
+
+private:
+    struct state {
+        intel_device_t *device;
+#ifdef INTEL_HAL_LINUX
+        bool has_clock_id;
+        clockid_t clock_id;
+#endif
+    };
+
+    static state &get_state() noexcept
+    {
+        static state st;
+        return st;
+    }
+
+#ifdef INTEL_HAL_LINUX
+    /* Dynamic POSIX clock id of a PHC character device (FD_TO_CLOCKID) */
+    static clockid_t fd_to_clock_id(int fd) noexcept
+    {
+        return static_cast<clockid_t>((~static_cast<unsigned int>(fd) << 3) | 3);
+    }
+#endif
+};
+
+template <typename Tag>
+constexpr bool basic_phc_clock<Tag>::is_steady;
+
+typedef basic_phc_clock<> phc_clock;
+
+typedef device<INTEL_FAMILY_I210> i210_device;
+typedef device<INTEL_FAMILY_I219> i219_device;
+typedef device<INTEL_FAMILY_I225> i225_device;
+typedef device<INTEL_FAMILY_I226> i226_device;
+
+} // namespace intel
+
+#endif /* INTEL_ETHERNET_HAL_HPP */
@@ -0,0 +1,363 @@
+/******************************************************************************
+
+  Copyright (c) 2025, Intel Corporation
+  All rights reserved.
+
+  Intel Ethernet HAL - IEEE 1722 AVTP Stream Packetizer
+
+  Talker-side framing for AVTP streams. Each stream keeps a prebuilt
+  VLAN-tagged Ethernet + AVTP common stream header; preparing a frame
+  copies that template in front of the caller's payload and patches only
+  the sequence number, presentation time and data length. The AVTP
+  timestamp is the low 32 bits of the presentation time in gPTP
+  nanoseconds, which is what the PHC counts.
+
+  Also generates Clock Reference Format streams: the media clock is a grid
+  anchored once to the PHC and advanced with exact rational arithmetic, so
+  the timestamps carry no read jitter. Batches of PDUs are built by the
+  device PHC-time scheduler and handed to the launch-time scheduler, so
+  PDUs due later in a batch do not sit in the hardware launch queue.
+
+******************************************************************************/
+
+#include "../include/intel_ethernet_hal.h"
+#include "../intel_hal_private.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define AVTP_ETHERTYPE_VLAN         0x8100
+#define AVTP_ETHERTYPE              0x22F0
+
+/* Offsets in the frame template */
+#define AVTP_OFF_TCI                14
+#define AVTP_OFF_SUBTYPE            18
+#define AVTP_OFF_FLAGS              19      /* sv, version, mr, gv, tv */
+#define AVTP_OFF_SEQUENCE           20
+#define AVTP_OFF_TU                 21
+#define AVTP_OFF_STREAM_ID          22
+#define AVTP_OFF_TIMESTAMP          30
+#define AVTP_OFF_FORMAT_1           34
+#define AVTP_OFF_DATA_LENGTH        38
+#define AVTP_OFF_FORMAT_2           40
+
+#define AVTP_FLAG_SV                0x80    /* stream_id valid */
+#define AVTP_FLAG_TV                0x01    /* avtp_timestamp valid */
+
+/* CRF PDU offsets (IEEE 1722-2016 clause 10) */
+#define CRF_OFF_TYPE                21
+#define CRF_OFF_FREQUENCY           30      /* pull (3 bits) | base_frequency (29 bits) */
+#define CRF_OFF_DATA_LENGTH         34
+#define CRF_OFF_INTERVAL            36
+
+static void put_be16(uint8_t *p, uint16_t value)
+{
+    p[0] = (uint8_t)(value >> 8);
+    p[1] = (uint8_t)value;
+}
+
+static void put_be32(uint8_t *p, uint32_t value)
+{
+    p[0] = (uint8_t)(value >> 24);
+    p[1] = (uint8_t)(value >> 16);
+    p[2] = (uint8_t)(value >> 8);
+    p[3] = (uint8_t)value;
+}
+
+intel_hal_result_t intel_hal_avtp_stream_init(intel_avtp_stream_t *stream, const intel_avtp_stream_config_t *config)
+{
+    uint8_t *h;
+    int i;
+
+    if (!stream || !config || config->vlan_id > 4095 || config->vlan_pcp > 7 ||
+        (config->subtype & 0x80)) {
+        intel_hal_set_error("Invalid parameters for AVTP stream");
+        return INTEL_HAL_ERROR_INVALID_PARAM;
+    }
+
+    memset(stream, 0, sizeof(*stream));
+    stream->queue = config->queue;
+    stream->launch_offset_ns = config->launch_offset_ns;
+    stream->transit_time_ns = config->transit_time_ns ? config->transit_time_ns : INTEL_AVTP_DEFAULT_TRANSIT;
+
+    h = stream->header;
+    memcpy(h, config->dest_mac, 6);
+    memcpy(h + 6, config->src_mac, 6);
+    put_be16(h + 12, AVTP_ETHERTYPE_VLAN);
+    put_be16(h + AVTP_OFF_TCI, (uint16_t)(config->vlan_pcp << 13 | config->vlan_id));
+    put_be16(h + 16, AVTP_ETHERTYPE);
+
+    h[AVTP_OFF_SUBTYPE] = config->subtype;
+    h[AVTP_OFF_FLAGS] = AVTP_FLAG_SV | AVTP_FLAG_TV;    /* version 0 */
+    for (i = 0; i < 8; i++) {
+        h[AVTP_OFF_STREAM_ID + i] = (uint8_t)(config->stream_id >> (56 - 8 * i));
+    }
+    put_be32(h + AVTP_OFF_FORMAT_1, config->format_specific_1);
+    put_be16(h + AVTP_OFF_FORMAT_2, config->format_specific_2);
+
+    return INTEL_HAL_SUCCESS;
+}
+
+intel_hal_result_t intel_hal_avtp_prepare(intel_avtp_stream_t *stream, void *frame, size_t payload_length,
+                                          uint64_t launch_time, intel_timed_packet_t *packet)
+{
+    uint8_t *h = (uint8_t *)frame;
+    uint64_t presentation;
+
+    if (!stream || !frame || !packet || payload_length > UINT16_MAX) {
+        intel_hal_set_error("Invalid parameters for AVTP frame");
+        return INTEL_HAL_ERROR_INVALID_PARAM;
+    }
+
+    presentation = launch_time + stream->transit_time_ns;
+
+    memcpy(h, stream->header, INTEL_AVTP_HEADER_SIZE);
+    h[AVTP_OFF_SEQUENCE] = stream->sequence++;
+    put_be32(h + AVTP_OFF_TIMESTAMP, (uint32_t)presentation);
+    put_be16(h + AVTP_OFF_DATA_LENGTH, (uint16_t)payload_length);
+
+    packet->packet_data = frame;
+    packet->packet_length = INTEL_AVTP_HEADER_SIZE + payload_length;
+    packet->launch_time = launch_time;
+    packet->queue = stream->queue;
+    return INTEL_HAL_SUCCESS;
+}
+
+intel_hal_result_t intel_hal_avtp_transmit(intel_device_t *device, intel_avtp_stream_t *stream,
+                                           void *frame, size_t payload_length, uint64_t launch_time)
+{
+    intel_timed_packet_t packet;
+    intel_timestamp_t now;
+    intel_hal_result_t result;
+
+    if (!device) {
+        intel_hal_set_error("Invalid device");
+        return INTEL_HAL_ERROR_INVALID_PARAM;
+    }
+
+    if (launch_time == 0) {
+        result = intel_hal_read_timestamp_unchecked(device, &now);
+        if (result != INTEL_HAL_SUCCESS) {
+            return result;
+        }
+        launch_time = now.seconds * 1000000000ULL + now.nanoseconds + (stream ? stream->launch_offset_ns : 0);
+    }
+
+    result = intel_hal_avtp_prepare(stream, frame, payload_length, launch_time, &packet);
+    if (result != INTEL_HAL_SUCCESS) {
+        return result;
+    }
+
+    return intel_hal_xmit_timed_packet(device, &packet);
+}
+
+/* ============================================================================
+ * Clock Reference Format Generator
+ * ============================================================================ */
+
+/* Pull multipliers (numerator / denominator) by pull code */
+static const uint32_t crf_pull[6][2] = {
+    { 1, 1 }, { 1000, 1001 }, { 1001, 1000 }, { 24, 25 }, { 25, 24 }, { 1, 8 }
+};
+
+struct intel_crf_generator {
+    intel_hal_mutex_t lock;
+    intel_device_t *device;
+    intel_crf_config_t config;
+    uint8_t header[INTEL_CRF_HEADER_SIZE];
+    uint8_t *frames;                    /* pdus_per_batch frames */
+    size_t frame_size;
+    uint8_t sequence;
+    uint64_t event_ns;                  /* Media clock event of the next timestamp */
+    uint64_t event_frac;                /* Fractional nanoseconds, in units of 1 / step_divisor */
+    uint64_t step_ns;                   /* Timestamp spacing = step_ns + step_rem / step_divisor */
+    uint64_t step_rem;
+    uint64_t step_divisor;
+    intel_hal_schedule_id_t id;
+    bool stopped;
+    intel_crf_stats_t stats;
+};
+
+static void crf_advance(struct intel_crf_generator *gen)
+{
+    gen->event_ns += gen->step_ns;
+    gen->event_frac += gen->step_rem;
+    if (gen->event_frac >= gen->step_divisor) {
+        gen->event_frac -= gen->step_divisor;
+        gen->event_ns++;
+    }
+}
+
+static void crf_callback(intel_device_t *device, uint64_t phc_time, void *arg)
+{
+    struct intel_crf_generator *gen = (struct intel_crf_generator *)arg;
+    uint32_t pdu;
+    uint32_t i;
+
+    (void)phc_time;
+
+    intel_hal_mutex_lock(&gen->lock);
+    if (gen->stopped) {
+        intel_hal_mutex_unlock(&gen->lock);     /* Stop is waiting for this invocation to return */
+        return;
+    }
+
+    /* Timestamps of the whole batch come from the media clock grid, not from PHC reads */
+    for (pdu = 0; pdu < gen->config.pdus_per_batch; pdu++) {
+        uint8_t *frame = gen->frames + pdu * gen->frame_size;
+        intel_timed_packet_t packet;
+
+        memcpy(frame, gen->header, INTEL_CRF_HEADER_SIZE);
+        frame[AVTP_OFF_SEQUENCE] = gen->sequence++;
+
+        packet.launch_time = gen->event_ns;
+        for (i = 0; i < gen->config.timestamps_per_pdu; i++) {
+            uint64_t timestamp = gen->event_ns + gen->config.transit_time_ns;
+            put_be32(frame + INTEL_CRF_HEADER_SIZE + 8 * i, (uint32_t)(timestamp >> 32));
+            put_be32(frame + INTEL_CRF_HEADER_SIZE + 8 * i + 4, (uint32_t)timestamp);
+            crf_advance(gen);
+        }
+
+        packet.packet_data = frame;
+        packet.packet_length = gen->frame_size;
+        packet.queue = gen->config.queue;
+        if (intel_hal_launch_submit(device, &packet) == INTEL_HAL_SUCCESS) {
+            gen->stats.pdus_sent++;
+        } else {
+            gen->stats.pdus_failed++;
+        }
+    }
+
+    /* Next batch starts at the event of its first timestamp */
+    if (intel_hal_schedule_at(device, gen->event_ns - gen->config.lead_ns, crf_callback, gen, &gen->id) != INTEL_HAL_SUCCESS) {
+        gen->id = INTEL_HAL_SCHEDULE_INVALID_ID;
+        gen->stats.stalled = true;
+    }
+    intel_hal_mutex_unlock(&gen->lock);
+}
+
+intel_hal_result_t intel_hal_crf_start(intel_device_t *device, const intel_crf_config_t *config,
+                                       intel_crf_generator_t **generator)
+{
+    struct intel_crf_generator *gen;
+    intel_timestamp_t now;
+    intel_hal_result_t result;
+    uint64_t divisor;
+    uint64_t start;
+    uint8_t *h;
+    int i;
+
+    if (!device || !config || !generator || config->vlan_id > 4095 || config->vlan_pcp > 7 ||
+        config->base_frequency == 0 || config->base_frequency >= (1u << 29) || config->pull > 5 ||
+        config->timestamp_interval == 0 || config->timestamps_per_pdu == 0 ||
+        config->timestamps_per_pdu > INTEL_CRF_MAX_TIMESTAMPS) {
+        intel_hal_set_error("Invalid parameters for CRF stream");
+        return INTEL_HAL_ERROR_INVALID_PARAM;
+    }
+
+    result = intel_hal_read_timestamp_unchecked(device, &now);
+    if (result != INTEL_HAL_SUCCESS) {
+        return result;
+    }
+
+    gen = (struct intel_crf_generator *)calloc(1, sizeof(*gen));
+    if (!gen) {
+        intel_hal_set_error("Out of memory creating CRF generator");
+        return INTEL_HAL_ERROR_NO_MEMORY;
+    }
+    gen->device = device;
+    gen->config = *config;
+    if (gen->config.pdus_per_batch == 0) {
+        gen->config.pdus_per_batch = 1;
+    }
+    if (gen->config.lead_ns == 0) {
+        gen->config.lead_ns = INTEL_CRF_DEFAULT_LEAD;
+    }
+    if (gen->config.transit_time_ns == 0) {
+        gen->config.transit_time_ns = INTEL_AVTP_DEFAULT_TRANSIT;
+    }
+    gen->frame_size = INTEL_CRF_HEADER_SIZE + 8u * gen->config.timestamps_per_pdu;
+    gen->frames = (uint8_t *)malloc(gen->frame_size * gen->config.pdus_per_batch);
+    if (!gen->frames) {
+        free(gen);
+        intel_hal_set_error("Out of memory creating CRF generator");
+        return INTEL_HAL_ERROR_NO_MEMORY;
+    }
+    intel_hal_mutex_init(&gen->lock);
+
+    /* Timestamp spacing: timestamp_interval events at base_frequency * pull */
+    divisor = (uint64_t)config->base_frequency * crf_pull[config->pull][0];
+    gen->step_divisor = divisor;
+    gen->step_ns = (uint64_t)config->timestamp_interval * 1000000000ULL * crf_pull[config->pull][1] / divisor;
+    gen->step_rem = (uint64_t)config->timestamp_interval * 1000000000ULL * crf_pull[config->pull][1] % divisor;
+
+    h = gen->header;
+    memcpy(h, config->dest_mac, 6);
+    memcpy(h + 6, config->src_mac, 6);
+    put_be16(h + 12, AVTP_ETHERTYPE_VLAN);
+    put_be16(h + AVTP_OFF_TCI, (uint16_t)(config->vlan_pcp << 13 | config->vlan_id));
+    put_be16(h + 16, AVTP_ETHERTYPE);
+    h[AVTP_OFF_SUBTYPE] = INTEL_AVTP_SUBTYPE_CRF;
+    h[AVTP_OFF_FLAGS] = AVTP_FLAG_SV;
+    h[CRF_OFF_TYPE] = config->crf_type;
+    for (i = 0; i < 8; i++) {
+        h[AVTP_OFF_STREAM_ID + i] = (uint8_t)(config->stream_id >> (56 - 8 * i));
+    }
+    put_be32(h + CRF_OFF_FREQUENCY, (uint32_t)config->pull << 29 | config->base_frequency);
+    put_be16(h + CRF_OFF_DATA_LENGTH, (uint16_t)(8u * config->timestamps_per_pdu));
+    put_be16(h + CRF_OFF_INTERVAL, config->timestamp_interval);
+
+    /* Anchor the media clock on the next whole millisecond after two lead times */
+    start = now.seconds * 1000000000ULL + now.nanoseconds + 2ULL * gen->config.lead_ns;
+    gen->event_ns = (start / 1000000ULL + 1) * 1000000ULL;
+
+    intel_hal_mutex_lock(&gen->lock);
+    result = intel_hal_schedule_at(device, gen->event_ns - gen->config.lead_ns, crf_callback, gen, &gen->id);
+    intel_hal_mutex_unlock(&gen->lock);
+    if (result != INTEL_HAL_SUCCESS) {
+        intel_hal_mutex_destroy(&gen->lock);
+        free(gen->frames);
+        free(gen);
+        return result;
+    }
+
+    *generator = gen;
+    return INTEL_HAL_SUCCESS;
+}
+
+void intel_hal_crf_stop(intel_crf_generator_t *generator)
+{
+    intel_hal_schedule_id_t id;
+
+    if (!generator) {
+        return;
+    }
+
+    intel_hal_mutex_lock(&generator->lock);
+    generator->stopped = true;
+    id = generator->id;
+    intel_hal_mutex_unlock(&generator->lock);
+
+    /* Waits out an invocation in progress; it sees 'stopped' and does not re-arm */
+    if (id != INTEL_HAL_SCHEDULE_INVALID_ID) {
+        intel_scheduler_cancel_sync(generator->device, id, NULL);
+    }
+
+    intel_hal_mutex_destroy(&generator->lock);
+    free(generator->frames);
+    free(generator);
+}
+
+intel_hal_result_t intel_hal_crf_get_stats(intel_crf_generator_t *generator, intel_crf_stats_t *stats)
+{
+    if (!generator || !stats) {
+        intel_hal_set_error("Invalid parameters");
+        return INTEL_HAL_ERROR_INVALID_PARAM;
+    }
+
+    intel_hal_mutex_lock(&generator->lock);
+    *stats = generator->stats;
+    stats->next_event_ns = generator->event_ns;
+    intel_hal_mutex_unlock(&generator->lock);
+    return INTEL_HAL_SUCCESS;
+}
@@ -0,0 +1,596 @@
+/******************************************************************************
+
+  Copyright (c) 2025, Intel Corporation
+  All rights reserved.
+
+  Intel Ethernet HAL - Multi-process Device Broker
+
+  One process owns the devices; client processes place requests in a
+  single-producer/single-consumer ring in a shared memory segment and read
+  completions from a second ring. Ring indices are free-running 32-bit
+  counters published with release/acquire ordering, so neither side needs a
+  lock or a system call in the steady state.
+
+******************************************************************************/
+
+#include "../include/intel_ethernet_hal.h"
+#include "../intel_hal_private.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef INTEL_HAL_LINUX
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#define INTEL_BROKER_MAGIC          0x42484E49u  /* "INHB" */
+#define INTEL_BROKER_VERSION        1u
+#define INTEL_BROKER_RING_MASK      (INTEL_BROKER_RING_SIZE - 1u)
+
+#define INTEL_BROKER_SLOT_FREE      0u
+#define INTEL_BROKER_SLOT_CLAIMED   1u
+
+/* Producer and consumer indices on separate cache lines */
+typedef struct {
+    volatile uint32_t head;             /* Written by the producer */
+    uint8_t pad0[60];
+    volatile uint32_t tail;             /* Written by the consumer */
+    uint8_t pad1[60];
+} intel_broker_ring_ctl_t;
+
+/* Request ring entry; generation filters out requests of a previous slot owner */
+typedef struct {
+    uint32_t generation;
+    uint32_t reserved;
+    intel_broker_request_t request;
+} intel_broker_request_entry_t;
+
+typedef struct {
+    uint32_t generation;
+    uint32_t reserved;
+    intel_broker_completion_t completion;
+} intel_broker_completion_entry_t;
+
+typedef struct {
+    volatile uint32_t state;            /* INTEL_BROKER_SLOT_* */
+    volatile uint32_t generation;       /* Incremented on every claim */
+    volatile uint32_t owner_pid;        /* Client process, for reclaiming */
+    uint8_t pad[52];
+    intel_broker_ring_ctl_t request_ctl;
+    intel_broker_ring_ctl_t completion_ctl;
+    intel_broker_request_entry_t requests[INTEL_BROKER_RING_SIZE];
+    intel_broker_completion_entry_t completions[INTEL_BROKER_RING_SIZE];
+} intel_broker_slot_t;
+
+/* Shared memory segment layout */
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t ring_size;
+    uint32_t request_size;              /* sizeof(intel_broker_request_t), guards ABI mismatch */
+    uint32_t max_clients;
+    uint32_t device_count;
+    volatile uint32_t broker_pid;
+    uint8_t pad[36];
+    intel_broker_slot_t slots[INTEL_BROKER_MAX_CLIENTS];
+} intel_broker_shm_t;
+
+/* Platform shared memory mapping */
+typedef struct {
+    intel_broker_shm_t *shm;
+    size_t size;
+#ifdef INTEL_HAL_WINDOWS
+    HANDLE mapping;
+#endif
+#ifdef INTEL_HAL_LINUX
+    char path[INTEL_BROKER_NAME_MAX + 16];
+#endif
+} intel_broker_mapping_t;
+
+struct intel_broker {
+    intel_broker_mapping_t map;
+    intel_device_t **devices;
+    uint32_t device_count;
+    uint32_t max_clients;               /* Private copy: clients can write the segment header */
+    uint32_t next_slot;                 /* Round-robin start for fairness */
+};
+
+struct intel_broker_client {
+    intel_broker_mapping_t map;
+    intel_broker_slot_t *slot;
+    uint32_t generation;
+};
+
+static size_t intel_broker_shm_size(uint32_t max_clients)
+{
+    return offsetof(intel_broker_shm_t, slots) + (size_t)max_clients * sizeof(intel_broker_slot_t);
+}
+
+static uint32_t intel_broker_current_pid(void)
+{
+#ifdef INTEL_HAL_WINDOWS
+    return (uint32_t)GetCurrentProcessId();
+#else
+    return (uint32_t)getpid();
+#endif
+}
+
+static bool intel_broker_pid_alive(uint32_t pid)
+{
+#ifdef INTEL_HAL_WINDOWS
+    HANDLE process;
+    bool alive;
+
+    process = OpenProcess(SYNCHRONIZE, FALSE, (DWORD)pid);
+    if (!process) {
+        return GetLastError() == ERROR_ACCESS_DENIED;
+    }
+    alive = WaitForSingleObject(process, 0) == WAIT_TIMEOUT;
+    CloseHandle(process);
+    return alive;
+#else
+    return pid != 0 && (kill((pid_t)pid, 0) == 0 || errno != ESRCH);
+#endif
+}
+
+static bool intel_broker_valid_name(const char *name)
+{
+    size_t length;
+
+    if (!name) {
+        return false;
+    }
+    length = strlen(name);
+    return length > 0 && length < INTEL_BROKER_NAME_MAX &&
+           !strchr(name, '/') && !strchr(name, '\\');
+}
+
+/**
+ * @brief Create (broker) or open (client) the shared memory segment
+ */
+static intel_hal_result_t intel_broker_map(intel_broker_mapping_t *map, const char *name, bool create, size_t size)
+{
+    memset(map, 0, sizeof(*map));
+
+#ifdef INTEL_HAL_WINDOWS
+    char path[INTEL_BROKER_NAME_MAX + 32];
+    snprintf(path, sizeof(path), "Local\\intel_hal_broker_%s", name);
+
+    if (create) {
+        map->mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE,
+                                          (DWORD)((uint64_t)size >> 32), (DWORD)size, path);
+        if (map->mapping && GetLastError() == ERROR_ALREADY_EXISTS) {
+            CloseHandle(map->mapping);
+            intel_hal_set_error("Broker '%s' already exists", name);
+            return INTEL_HAL_ERROR_DEVICE_BUSY;
+        }
+    } else {
+        map->mapping = OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, path);
+    }
+    if (!map->mapping) {
+        intel_hal_set_error("Broker shared memory '%s' unavailable: %u", path, (unsigned int)GetLastError());
+        return create ? INTEL_HAL_ERROR_OS_SPECIFIC : INTEL_HAL_ERROR_NO_DEVICE;
+    }
+
+    map->shm = (intel_broker_shm_t *)MapViewOfFile(map->mapping, FILE_MAP_ALL_ACCESS, 0, 0, create ? size : 0);
+    if (!map->shm) {
+        intel_hal_set_error("MapViewOfFile failed: %u", (unsigned int)GetLastError());
+        CloseHandle(map->mapping);
+        return INTEL_HAL_ERROR_OS_SPECIFIC;
+    }
+    if (!create) {
+        MEMORY_BASIC_INFORMATION region;
+        VirtualQuery(map->shm, &region, sizeof(region));
+        size = region.RegionSize;
+    }
+    map->size = size;
+    return INTEL_HAL_SUCCESS;
+#else
+    struct stat st;
+    int fd;
+
+    snprintf(map->path, sizeof(map->path), "/intel_hal_broker_%s", name);
+
+    if (create) {
+        fd = shm_open(map->path, O_RDWR | O_CREAT | O_EXCL, 0660);
+        if (fd < 0 && errno == EEXIST) {
+            /* Reuse the name only if the previous broker has exited */
+            intel_broker_mapping_t stale;
+            if (intel_broker_map(&stale, name, false, 0) == INTEL_HAL_SUCCESS) {
+                bool alive = stale.size >= offsetof(intel_broker_shm_t, slots) &&
+                             intel_broker_pid_alive(intel_atomic_load_u32(&stale.shm->broker_pid));
+                munmap(stale.shm, stale.size);
+                if (alive) {
+                    intel_hal_set_error("Broker '%s' already running", name);
+                    return INTEL_HAL_ERROR_DEVICE_BUSY;
+                }
+            }
+            shm_unlink(map->path);
+            fd = shm_open(map->path, O_RDWR | O_CREAT | O_EXCL, 0660);
+        }
+        if (fd >= 0 && ftruncate(fd, (off_t)size) != 0) {
+            close(fd);
+            shm_unlink(map->path);
+            fd = -1;
+        }
+    } else {
+        fd = shm_open(map->path, O_RDWR, 0);
+        if (fd >= 0 && fstat(fd, &st) == 0) {
+            size = (size_t)st.st_size;
+        }
+    }
+    if (fd < 0) {
+        intel_hal_set_error("Broker shared memory '%s' unavailable: %s", map->path, strerror(errno));
+        return create ? INTEL_HAL_ERROR_OS_SPECIFIC : INTEL_HAL_ERROR_NO_DEVICE;
+    }
+
+    map->shm = (intel_broker_shm_t *)mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map->shm == MAP_FAILED) {
+        map->shm = NULL;
+        intel_hal_set_error("mmap of broker shared memory failed: %s", strerror(errno));
+        return INTEL_HAL_ERROR_OS_SPECIFIC;
+    }
+    map->size = size;
+    return INTEL_HAL_SUCCESS;
+#endif
+}
+
+static void intel_broker_unmap(intel_broker_mapping_t *map, bool remove)
+{
+#ifdef INTEL_HAL_WINDOWS
+    (void)remove;
+    if (map->shm) {
+        UnmapViewOfFile(map->shm);
+    }
+    if (map->mapping) {
+        CloseHandle(map->mapping);
+    }
+#else
+    if (map->shm) {
+        munmap(map->shm, map->size);
+    }
+    if (remove) {
+        shm_unlink(map->path);
+    }
+#endif
+    map->shm = NULL;
+}
+
+/**
+ * @brief Execute one client request against the owned devices
+ */
+static void intel_broker_execute(intel_broker_t *broker, const intel_broker_request_t *request,
+                                 intel_broker_completion_t *completion)
+{
+    intel_device_t *device;
+    intel_hal_result_t result;
+
+    memset(completion, 0, sizeof(*completion));
+    completion->request_id = request->request_id;
+    completion->op = request->op;
+
+    if (request->device_index >= broker->device_count) {
+        completion->result = INTEL_HAL_ERROR_NO_DEVICE;
+        return;
+    }
+    device = broker->devices[request->device_index];
+
+    switch (request->op) {
+        case INTEL_BROKER_OP_READ_TIMESTAMP:
+            result = intel_hal_read_timestamp(device, &completion->timestamp);
+            break;
+        case INTEL_BROKER_OP_ADJUST_FREQUENCY:
+            result = intel_hal_adjust_frequency(device, request->u.ppb_adjustment);
+            break;
+        case INTEL_BROKER_OP_CONFIGURE_VLAN_FILTER:
+            result = intel_hal_configure_vlan_filter(device, request->u.vlan_filter.vlan_id,
+                                                     request->u.vlan_filter.enable);
+            break;
+        case INTEL_BROKER_OP_CONFIGURE_PRIORITY_MAPPING:
+            result = intel_hal_configure_priority_mapping(device, request->u.priority_mapping.priority,
+                                                          request->u.priority_mapping.traffic_class);
+            break;
+        case INTEL_BROKER_OP_CONFIGURE_CBS:
+            result = intel_hal_configure_cbs(device, request->u.cbs.traffic_class, &request->u.cbs.config);
+            break;
+        case INTEL_BROKER_OP_SETUP_TAS:
+            result = intel_hal_setup_time_aware_shaper(device, &request->u.tas);
+            break;
+        case INTEL_BROKER_OP_SETUP_FRAME_PREEMPTION:
+            result = intel_hal_setup_frame_preemption(device, &request->u.frame_preemption);
+            break;
+        case INTEL_BROKER_OP_XMIT_TIMED_PACKET: {
+            intel_timed_packet_t packet;
+            if (request->u.xmit.length == 0 || request->u.xmit.length > INTEL_BROKER_MAX_FRAME_SIZE) {
+                result = INTEL_HAL_ERROR_INVALID_PARAM;
+                break;
+            }
+            packet.packet_data = (void *)request->u.xmit.data;
+            packet.packet_length = request->u.xmit.length;
+            packet.launch_time = request->u.xmit.launch_time;
+            packet.queue = request->u.xmit.queue;
+            result = intel_hal_xmit_timed_packet(device, &packet);
+            break;
+        }
+        default:
+            result = INTEL_HAL_ERROR_INVALID_PARAM;
+            break;
+    }
+
+    completion->result = result;
+}
+
+intel_hal_result_t intel_hal_broker_create(const char *name, intel_device_t *const *devices, uint32_t device_count,
+                                           uint32_t max_clients, intel_broker_t **broker)
+{
+    intel_broker_t *new_broker;
+    intel_hal_result_t result;
+    uint32_t i;
+
+    if (!intel_broker_valid_name(name) || !broker || (device_count > 0 && !devices) ||
+        max_clients == 0 || max_clients > INTEL_BROKER_MAX_CLIENTS) {
+        intel_hal_set_error("Invalid parameters for broker creation");
+        return INTEL_HAL_ERROR_INVALID_PARAM;
+    }
+
+    for (i = 0; i < device_count; i++) {
+        if (!devices[i]) {
+            intel_hal_set_error("Broker device %u is NULL", i);
+            return INTEL_HAL_ERROR_INVALID_PARAM;
+        }
+    }
+
+    new_broker = (intel_broker_t *)calloc(1, sizeof(*new_broker));
+    if (!new_broker) {
+        intel_hal_set_error("Out of memory creating broker");
+        return INTEL_HAL_ERROR_NO_MEMORY;
+    }
+
+    new_broker->devices = (intel_device_t **)calloc(device_count ? device_count : 1, sizeof(intel_device_t *));
+    if (!new_broker->devices) {
+        free(new_broker);
+        intel_hal_set_error("Out of memory creating broker");
+        return INTEL_HAL_ERROR_NO_MEMORY;
+    }
+    if (device_count > 0) {
+        memcpy(new_broker->devices, devices, device_count * sizeof(intel_device_t *));
+    }
+    new_broker->device_count = device_count;
+    new_broker->max_clients = max_clients;
+
+    result = intel_broker_map(&new_broker->map, name, true, intel_broker_shm_size(max_clients));
+    if (result != INTEL_HAL_SUCCESS) {
+        free(new_broker->devices);
+        free(new_broker);
+        return result;
+    }
+
+    /* Fresh segments are zero-filled; publish the header last */
+    new_broker->map.shm->ring_size = INTEL_BROKER_RING_SIZE;
+    new_broker->map.shm->request_size = (uint32_t)sizeof(intel_broker_request_t);
+    new_broker->map.shm->max_clients = max_clients;
+    new_broker->map.shm->device_count = device_count;
+    new_broker->map.shm->version = INTEL_BROKER_VERSION;
+    intel_atomic_store_u32(&new_broker->map.shm->broker_pid, intel_broker_current_pid());
+    intel_atomic_store_u32(&new_broker->map.shm->magic, INTEL_BROKER_MAGIC);
+
+    printf("HAL: Broker '%s' serving %u device(s), %u client slot(s)\n", name, device_count, max_clients);
+
+    *broker = new_broker;
+    return INTEL_HAL_SUCCESS;
+}
+
+uint32_t intel_hal_broker_poll(intel_broker_t *broker, uint32_t budget)
+{
+    intel_broker_shm_t *shm;
+    uint32_t serviced = 0;
+    uint32_t n;
+
+    if (!broker) {
+        return 0;
+    }
+
+    shm = broker->map.shm;
+    for (n = 0; n < broker->max_clients; n++) {
+        uint32_t index = (broker->next_slot + n) % broker->max_clients;
+        intel_broker_slot_t *slot = &shm->slots[index];
+        uint32_t req_head, req_tail, cmpl_head, cmpl_tail, generation;
+
+        if (intel_atomic_load_u32(&slot->state) != INTEL_BROKER_SLOT_CLAIMED) {
+            continue;
+        }
+
+        req_head = intel_atomic_load_u32(&slot->request_ctl.head);
+        req_tail = slot->request_ctl.tail;
+        cmpl_head = slot->completion_ctl.head;
+        cmpl_tail = intel_atomic_load_u32(&slot->completion_ctl.tail);
+
+        generation = intel_atomic_load_u32(&slot->generation);
+
+        while (req_tail != req_head && cmpl_head - cmpl_tail < INTEL_BROKER_RING_SIZE) {
+            const intel_broker_request_entry_t *entry = &slot->requests[req_tail & INTEL_BROKER_RING_MASK];
+            intel_broker_completion_entry_t *out = &slot->completions[cmpl_head & INTEL_BROKER_RING_MASK];
+
+            if (entry->generation != generation) {
+                /* Left behind by an exited owner of a reclaimed slot: drop without executing */
+                intel_atomic_store_u32(&slot->request_ctl.tail, ++req_tail);
+                continue;
+            }
+
+            intel_broker_execute(broker, &entry->request, &out->completion);
+            out->generation = entry->generation;
+
+            req_tail++;
+            cmpl_head++;
+            intel_atomic_store_u32(&slot->request_ctl.tail, req_tail);
+            intel_atomic_store_u32(&slot->completion_ctl.head, cmpl_head);
+
+            if (++serviced == budget) {
+                broker->next_slot = index;
+                return serviced;
+            }
+        }
+    }
+
+    broker->next_slot = (broker->next_slot + 1) % broker->max_clients;
+    return serviced;
+}
+
+void intel_hal_broker_destroy(intel_broker_t *broker)
+{
+    if (!broker) {
+        return;
+    }
+
+    intel_atomic_store_u32(&broker->map.shm->broker_pid, 0);
+    intel_atomic_store_u32(&broker->map.shm->magic, 0);
+    intel_broker_unmap(&broker->map, true);
+    free(broker->devices);
+    free(broker);
+}
+
+intel_hal_result_t intel_hal_broker_connect(const char *name, intel_broker_client_t **client)
+{
+    intel_broker_client_t *new_client;
+    intel_broker_shm_t *shm;
+    intel_hal_result_t result;
+    uint32_t pid = intel_broker_current_pid();
+    uint32_t i;
+
+    if (!intel_broker_valid_name(name) || !client) {
+        intel_hal_set_error("Invalid parameters for broker connect");
+        return INTEL_HAL_ERROR_INVALID_PARAM;
+    }
+
+    new_client = (intel_broker_client_t *)calloc(1, sizeof(*new_client));
+    if (!new_client) {
+        intel_hal_set_error("Out of memory connecting to broker");
+        return INTEL_HAL_ERROR_NO_MEMORY;
+    }
+
+    result = intel_broker_map(&new_client->map, name, false, 0);
+    if (result != INTEL_HAL_SUCCESS) {
+        free(new_client);
+        return result;
+    }
+
+    shm = new_client->map.shm;
+    if (new_client->map.size < offsetof(intel_broker_shm_t, slots) ||
+        intel_atomic_load_u32(&shm->magic) != INTEL_BROKER_MAGIC ||
+        shm->version != INTEL_BROKER_VERSION || shm->ring_size != INTEL_BROKER_RING_SIZE ||
+        shm->request_size != sizeof(intel_broker_request_t) ||
+        new_client->map.size < intel_broker_shm_size(shm->max_clients)) {
+        intel_hal_set_error("Broker '%s' is not ready or uses an incompatible layout", name);
+        intel_broker_unmap(&new_client->map, false);
+        free(new_client);
+        return INTEL_HAL_ERROR_NO_DEVICE;
+    }
+
+    for (i = 0; i < shm->max_clients && !new_client->slot; i++) {
+        intel_broker_slot_t *slot = &shm->slots[i];
+        uint32_t state = intel_atomic_load_u32(&slot->state);
+
+        if (state == INTEL_BROKER_SLOT_CLAIMED && !intel_broker_pid_alive(intel_atomic_load_u32(&slot->owner_pid))) {
+            /* Reclaim the slot of an exited client */
+            if (intel_atomic_cas_u32(&slot->state, INTEL_BROKER_SLOT_CLAIMED, INTEL_BROKER_SLOT_FREE)) {
+                state = INTEL_BROKER_SLOT_FREE;
+            }
+        }
+
+        if (state == INTEL_BROKER_SLOT_FREE &&
+            intel_atomic_cas_u32(&slot->state, INTEL_BROKER_SLOT_FREE, INTEL_BROKER_SLOT_CLAIMED)) {
+            new_client->slot = slot;
+            new_client->generation = slot->generation + 1;
+            intel_atomic_store_u32(&slot->generation, new_client->generation);
+            intel_atomic_store_u32(&slot->owner_pid, pid);
+        }
+    }
+
+    if (!new_client->slot) {
+        intel_hal_set_error("All %u client slots of broker '%s' are in use", shm->max_clients, name);
+        intel_broker_unmap(&new_client->map, false);
+        free(new_client);
+        return INTEL_HAL_ERROR_DEVICE_BUSY;
+    }
+
+    *client = new_client;
+    return INTEL_HAL_SUCCESS;
+}
+
+intel_hal_result_t intel_hal_broker_submit(intel_broker_client_t *client, const intel_broker_request_t *request)
+{
+    intel_broker_slot_t *slot;
+    intel_broker_request_entry_t *entry;
+    uint32_t head, tail;
+
+    if (!client || !request) {
+        intel_hal_set_error("Invalid parameters for broker submit");
+        return INTEL_HAL_ERROR_INVALID_PARAM;
+    }
+
+    slot = client->slot;
+    head = slot->request_ctl.head;
+    tail = intel_atomic_load_u32(&slot->request_ctl.tail);
+    if (head - tail >= INTEL_BROKER_RING_SIZE) {
+        return INTEL_HAL_ERROR_DEVICE_BUSY;
+    }
+
+    entry = &slot->requests[head & INTEL_BROKER_RING_MASK];
+    entry->generation = client->generation;
+    if (request->op == INTEL_BROKER_OP_XMIT_TIMED_PACKET && request->u.xmit.length <= INTEL_BROKER_MAX_FRAME_SIZE) {
+        /* Copy only the used part of the frame buffer */
+        memcpy(&entry->request, request, offsetof(intel_broker_request_t, u.xmit.data) + request->u.xmit.length);
+    } else {
+        memcpy(&entry->request, request, sizeof(*request));
+    }
+
+    intel_atomic_store_u32(&slot->request_ctl.head, head + 1);
+    return INTEL_HAL_SUCCESS;
+}
+
+bool intel_hal_broker_poll_completion(intel_broker_client_t *client, intel_broker_completion_t *completion)
+{
+    intel_broker_slot_t *slot;
+    uint32_t head, tail;
+
+    if (!client || !completion) {
+        return false;
+    }
+
+    slot = client->slot;
+    head = intel_atomic_load_u32(&slot->completion_ctl.head);
+    tail = slot->completion_ctl.tail;
+
+    while (tail != head) {
+        const intel_broker_completion_entry_t *entry = &slot->completions[tail & INTEL_BROKER_RING_MASK];
+        bool ours = entry->generation == client->generation;
+
+        if (ours) {
+            *completion = entry->completion;
+        }
+        intel_atomic_store_u32(&slot->completion_ctl.tail, ++tail);
+        if (ours) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void intel_hal_broker_disconnect(intel_broker_client_t *client)
+{
+    if (!client) {
+        return;
+    }
+
+    intel_atomic_store_u32(&client->slot->owner_pid, 0);
+    intel_atomic_store_u32(&client->slot->state, INTEL_BROKER_SLOT_FREE);
+    intel_broker_unmap(&client->map, false);
+    free(client);
+}
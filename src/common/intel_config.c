@@ -0,0 +1,378 @@
+/******************************************************************************
+
+  Copyright (c) 2025, Intel Corporation
+  All rights reserved.
+
+  Intel Ethernet HAL - Configuration Snapshot and Restore
+
+  Serializes the device configuration cache into a versioned little-endian
+  blob. Only configured entries are stored (non-zero VFTA words, enabled
+  traffic classes, the used part of the gate control list), so a typical
+  port snapshot is well under a kilobyte. Restore validates the whole blob
+  before touching the device, then applies it in one pass: one TAS and one
+  preemption write and a single update of the configuration cache instead
+  of one configure call per setting.
+
+******************************************************************************/
+
+#include "../include/intel_ethernet_hal.h"
+#include "../intel_hal_private.h"
+#include <stdio.h>
+#include <string.h>
+
+#define CONFIG_MAGIC            0x46434849u     /* "IHCF" */
+#define CONFIG_HEADER_SIZE      16
+
+#define CONFIG_FLAG_TIMESTAMPING    0x01
+#define CONFIG_FLAG_TAS             0x02
+#define CONFIG_FLAG_FP              0x04
+
+/* Upper bound of a serialized blob, used to size the query result */
+#define CONFIG_MAX_SIZE (CONFIG_HEADER_SIZE + 1 + 8 + \
+                         1 + 8 * 17 +           /* CBS */ \
+                         1 + 8 * 5 +            /* Bandwidth and rate limit */ \
+                         1 + 128 * 5 +          /* VLAN filter */ \
+                         17 + 8 * 5 +           /* TAS */ \
+                         10)                    /* Frame preemption */
+
+typedef struct {
+    uint8_t *data;
+    size_t size;
+    size_t offset;
+} config_writer_t;
+
+typedef struct {
+    const uint8_t *data;
+    size_t size;
+    size_t offset;
+    bool overrun;
+} config_reader_t;
+
+static void put_u8(config_writer_t *w, uint8_t value)
+{
+    w->data[w->offset++] = value;
+}
+
+static void put_u16(config_writer_t *w, uint16_t value)
+{
+    put_u8(w, (uint8_t)value);
+    put_u8(w, (uint8_t)(value >> 8));
+}
+
+static void put_u32(config_writer_t *w, uint32_t value)
+{
+    put_u16(w, (uint16_t)value);
+    put_u16(w, (uint16_t)(value >> 16));
+}
+
+static void put_u64(config_writer_t *w, uint64_t value)
+{
+    put_u32(w, (uint32_t)value);
+    put_u32(w, (uint32_t)(value >> 32));
+}
+
+static uint8_t get_u8(config_reader_t *r)
+{
+    if (r->offset >= r->size) {
+        r->overrun = true;
+        return 0;
+    }
+    return r->data[r->offset++];
+}
+
+static uint16_t get_u16(config_reader_t *r)
+{
+    uint16_t low = get_u8(r);
+    return (uint16_t)(low | ((uint16_t)get_u8(r) << 8));
+}
+
+static uint32_t get_u32(config_reader_t *r)
+{
+    uint32_t low = get_u16(r);
+    return low | ((uint32_t)get_u16(r) << 16);
+}
+
+static uint64_t get_u64(config_reader_t *r)
+{
+    uint64_t low = get_u32(r);
+    return low | ((uint64_t)get_u32(r) << 32);
+}
+
+/* FNV-1a over the payload */
+static uint32_t config_checksum(const uint8_t *data, size_t size)
+{
+    uint32_t hash = 0x811C9DC5u;
+    size_t i;
+
+    for (i = 0; i < size; i++) {
+        hash ^= data[i];
+        hash *= 0x01000193u;
+    }
+    return hash;
+}
+
+static void serialize_state(config_writer_t *w, const intel_device_state_t *state)
+{
+    uint8_t flags = 0;
+    uint8_t mask;
+    uint32_t count;
+    uint32_t i;
+
+    if (state->timestamping_enabled) flags |= CONFIG_FLAG_TIMESTAMPING;
+    if (state->tas_enabled) flags |= CONFIG_FLAG_TAS;
+    if (state->fp_enabled) flags |= CONFIG_FLAG_FP;
+    put_u8(w, flags);
+
+    for (i = 0; i < 8; i++) {
+        put_u8(w, state->priority_map[i]);
+    }
+
+    /* CBS: traffic class mask, then the configured classes in order */
+    for (mask = 0, i = 0; i < 8; i++) {
+        const intel_cbs_config_t *cbs = &state->cbs[i];
+        if (cbs->enabled || cbs->send_slope || cbs->idle_slope || cbs->hi_credit || cbs->lo_credit) {
+            mask |= (uint8_t)(1u << i);
+        }
+    }
+    put_u8(w, mask);
+    for (i = 0; i < 8; i++) {
+        if (mask & (1u << i)) {
+            put_u8(w, state->cbs[i].enabled ? 1 : 0);
+            put_u32(w, state->cbs[i].send_slope);
+            put_u32(w, state->cbs[i].idle_slope);
+            put_u32(w, state->cbs[i].hi_credit);
+            put_u32(w, state->cbs[i].lo_credit);
+        }
+    }
+
+    /* Bandwidth allocation and rate limit */
+    for (mask = 0, i = 0; i < 8; i++) {
+        if (state->bandwidth_percent[i] || state->rate_limit_mbps[i]) {
+            mask |= (uint8_t)(1u << i);
+        }
+    }
+    put_u8(w, mask);
+    for (i = 0; i < 8; i++) {
+        if (mask & (1u << i)) {
+            put_u8(w, (uint8_t)state->bandwidth_percent[i]);
+            put_u32(w, state->rate_limit_mbps[i]);
+        }
+    }
+
+    /* VLAN filter: non-zero VFTA words as (index, value) */
+    for (count = 0, i = 0; i < 128; i++) {
+        count += state->vlan_filter[i] != 0;
+    }
+    put_u8(w, (uint8_t)count);
+    for (i = 0; i < 128; i++) {
+        if (state->vlan_filter[i]) {
+            put_u8(w, (uint8_t)i);
+            put_u32(w, state->vlan_filter[i]);
+        }
+    }
+
+    if (state->tas_enabled) {
+        put_u64(w, state->tas.cycle_time);
+        put_u64(w, state->tas.base_time);
+        put_u8(w, (uint8_t)state->tas.gate_control_list_length);
+        for (i = 0; i < state->tas.gate_control_list_length; i++) {
+            put_u8(w, state->tas.gate_control_list[i].gate_states);
+            put_u32(w, state->tas.gate_control_list[i].time_interval);
+        }
+    }
+
+    if (state->fp_enabled) {
+        put_u8(w, state->fp.preemptible_queues);
+        put_u32(w, state->fp.additional_fragment_size);
+        put_u8(w, state->fp.verify_disable ? 1 : 0);
+        put_u32(w, state->fp.verify_time);
+    }
+}
+
+static bool deserialize_state(config_reader_t *r, intel_device_state_t *state)
+{
+    uint8_t flags;
+    uint8_t mask;
+    uint32_t count;
+    uint32_t i;
+
+    memset(state, 0, sizeof(*state));
+
+    flags = get_u8(r);
+    state->timestamping_enabled = (flags & CONFIG_FLAG_TIMESTAMPING) != 0;
+    state->tas_enabled = (flags & CONFIG_FLAG_TAS) != 0;
+    state->fp_enabled = (flags & CONFIG_FLAG_FP) != 0;
+
+    for (i = 0; i < 8; i++) {
+        state->priority_map[i] = get_u8(r);
+        if (state->priority_map[i] > 7) {
+            return false;
+        }
+    }
+
+    mask = get_u8(r);
+    for (i = 0; i < 8; i++) {
+        state->cbs[i].traffic_class = (uint8_t)i;
+        if (mask & (1u << i)) {
+            state->cbs[i].enabled = get_u8(r) != 0;
+            state->cbs[i].send_slope = get_u32(r);
+            state->cbs[i].idle_slope = get_u32(r);
+            state->cbs[i].hi_credit = get_u32(r);
+            state->cbs[i].lo_credit = get_u32(r);
+        }
+    }
+
+    mask = get_u8(r);
+    for (i = 0; i < 8; i++) {
+        if (mask & (1u << i)) {
+            state->bandwidth_percent[i] = get_u8(r);
+            state->rate_limit_mbps[i] = get_u32(r);
+            if (state->bandwidth_percent[i] > 100) {
+                return false;
+            }
+        }
+    }
+
+    count = get_u8(r);
+    if (count > 128) {
+        return false;
+    }
+    for (i = 0; i < count; i++) {
+        uint8_t index = get_u8(r);
+        uint32_t value = get_u32(r);
+        if (index >= 128) {
+            return false;
+        }
+        state->vlan_filter[index] = value;
+    }
+
+    if (state->tas_enabled) {
+        state->tas.cycle_time = get_u64(r);
+        state->tas.base_time = get_u64(r);
+        state->tas.gate_control_list_length = get_u8(r);
+        if (state->tas.gate_control_list_length == 0 || state->tas.gate_control_list_length > INTEL_HAL_TAS_MAX_ENTRIES) {
+            return false;
+        }
+        for (i = 0; i < state->tas.gate_control_list_length; i++) {
+            state->tas.gate_control_list[i].gate_states = get_u8(r);
+            state->tas.gate_control_list[i].time_interval = get_u32(r);
+        }
+    }
+
+    if (state->fp_enabled) {
+        state->fp.preemptible_queues = get_u8(r);
+        state->fp.additional_fragment_size = get_u32(r);
+        state->fp.verify_disable = get_u8(r) != 0;
+        state->fp.verify_time = get_u32(r);
+    }
+
+    return !r->overrun && r->offset == r->size;
+}
+
+intel_hal_result_t intel_hal_save_config(intel_device_t *device, void *buffer, size_t *size)
+{
+    uint8_t blob[CONFIG_MAX_SIZE];
+    config_writer_t w = { blob, sizeof(blob), CONFIG_HEADER_SIZE };
+    size_t payload_size;
+
+    if (!device || !size) {
+        intel_hal_set_error("Invalid parameters for configuration save");
+        return INTEL_HAL_ERROR_INVALID_PARAM;
+    }
+
+    intel_hal_mutex_lock(&device->state_lock);
+    serialize_state(&w, &device->state);
+    intel_hal_mutex_unlock(&device->state_lock);
+
+    payload_size = w.offset - CONFIG_HEADER_SIZE;
+    w.offset = 0;
+    put_u32(&w, CONFIG_MAGIC);
+    put_u16(&w, INTEL_HAL_CONFIG_VERSION);
+    put_u16(&w, device->info.device_id);
+    put_u32(&w, (uint32_t)payload_size);
+    put_u32(&w, config_checksum(blob + CONFIG_HEADER_SIZE, payload_size));
+
+    if (!buffer || *size < CONFIG_HEADER_SIZE + payload_size) {
+        *size = CONFIG_HEADER_SIZE + payload_size;
+        if (!buffer) {
+            return INTEL_HAL_SUCCESS;
+        }
+        intel_hal_set_error("Configuration buffer too small (%zu bytes required)", *size);
+        return INTEL_HAL_ERROR_NO_MEMORY;
+    }
+
+    *size = CONFIG_HEADER_SIZE + payload_size;
+    memcpy(buffer, blob, *size);
+    return INTEL_HAL_SUCCESS;
+}
+
+intel_hal_result_t intel_hal_restore_config(intel_device_t *device, const void *buffer, size_t size)
+{
+    config_reader_t r = { (const uint8_t *)buffer, size, 0, false };
+    intel_device_state_t state;
+    intel_device_state_t previous;
+    intel_device_family_t family;
+    uint32_t magic, payload_size, checksum;
+    uint16_t version, device_id;
+    intel_hal_result_t result;
+
+    if (!device || !buffer || size < CONFIG_HEADER_SIZE) {
+        intel_hal_set_error("Invalid parameters for configuration restore");
+        return INTEL_HAL_ERROR_INVALID_PARAM;
+    }
+
+    magic = get_u32(&r);
+    version = get_u16(&r);
+    device_id = get_u16(&r);
+    payload_size = get_u32(&r);
+    checksum = get_u32(&r);
+
+    if (magic != CONFIG_MAGIC || version == 0 || version > INTEL_HAL_CONFIG_VERSION) {
+        intel_hal_set_error("Not a configuration snapshot or unsupported version %u", version);
+        return INTEL_HAL_ERROR_INVALID_PARAM;
+    }
+    if (payload_size != size - CONFIG_HEADER_SIZE ||
+        config_checksum(r.data + CONFIG_HEADER_SIZE, payload_size) != checksum) {
+        intel_hal_set_error("Configuration snapshot is truncated or corrupt");
+        return INTEL_HAL_ERROR_INVALID_PARAM;
+    }
+    if (!intel_device_lookup(device_id, &family, NULL) || family != device->info.family) {
+        intel_hal_set_error("Configuration snapshot was taken on device 0x%04x (different family)", device_id);
+        return INTEL_HAL_ERROR_NOT_SUPPORTED;
+    }
+    if (!deserialize_state(&r, &state)) {
+        intel_hal_set_error("Configuration snapshot contains invalid settings");
+        return INTEL_HAL_ERROR_INVALID_PARAM;
+    }
+
+    /* Claims are committed first so an oversubscribed snapshot changes nothing */
+    intel_hal_mutex_lock(&device->state_lock);
+    previous = device->state;
+    intel_hal_mutex_unlock(&device->state_lock);
+    result = intel_ledger_load(device, &state);
+    if (result != INTEL_HAL_SUCCESS) {
+        return result;
+    }
+
+    /* Everything is validated; program the shapers that reach hardware once each.
+     * A snapshot with TAS or preemption off disables them (empty list, no
+     * preemptible queues) rather than leaving the current schedule running.
+     * The TAS setup records the schedule and its gate index, replacing any
+     * staged one. */
+    result = intel_hal_setup_time_aware_shaper(device, &state.tas);
+    if (result == INTEL_HAL_SUCCESS && intel_device_has_capability(device, INTEL_CAP_TSN_FRAME_PREEMPTION)) {
+        result = intel_hal_setup_frame_preemption_unchecked(device, &state.fp);
+    }
+    if (result != INTEL_HAL_SUCCESS) {
+        intel_ledger_load(device, &previous);   /* Back to the claims of the configuration in place */
+        return result;
+    }
+
+    /* Register-shadowed settings (VFTA, priority map, CBS, bandwidth) in one update */
+    intel_hal_mutex_lock(&device->state_lock);
+    device->state = state;
+    intel_hal_mutex_unlock(&device->state_lock);
+
+    printf("HAL: Restored configuration snapshot (%zu bytes) on device 0x%04x\n", size, device->info.device_id);
+    return INTEL_HAL_SUCCESS;
+}
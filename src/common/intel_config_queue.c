@@ -0,0 +1,458 @@
+/******************************************************************************
+
+  Copyright (c) 2025, Intel Corporation
+  All rights reserved.
+
+  Intel Ethernet HAL - Scheduled Configuration Changes
+
+  Configuration changes submitted with a PHC activation time. TAS changes
+  on families with a hardware gate scheduler are programmed immediately
+  with the activation time as base time, so the hardware switches at the
+  exact instant, and staged as the admin schedule so the state cache
+  reports the running one until then; all other changes are applied by the
+  PHC-time scheduler.
+  Completions are queued per device and signalled on an event (eventfd on
+  Linux, auto-reset event on Windows). Changes still pending are tracked
+  so they can be cancelled and are released when the device closes.
+
+******************************************************************************/
+
+#include "../include/intel_ethernet_hal.h"
+#include "../intel_hal_private.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef INTEL_HAL_LINUX
+#include <errno.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#endif
+
+struct pending_change;
+
+struct intel_config_queue {
+    intel_hal_mutex_t lock;
+    struct pending_change *pending;     /* Changes not yet completed */
+    intel_hal_config_completion_t completions[INTEL_HAL_CONFIG_COMPLETION_DEPTH];
+    uint32_t head;                      /* Next completion to read */
+    uint32_t count;                     /* Queued completions */
+#ifdef INTEL_HAL_LINUX
+    int event_fd;
+#endif
+#ifdef INTEL_HAL_WINDOWS
+    HANDLE event;
+#endif
+};
+
+/* Pending change, owned by the scheduler callback until it runs or is cancelled */
+typedef struct pending_change {
+    struct pending_change *next;        /* Queue pending list, under queue->lock */
+    struct pending_change *prev;
+    struct intel_config_queue *queue;
+    intel_hal_config_change_t change;
+    uint64_t change_id;
+    uint64_t activation_time;
+    bool hardware_timed;                /* Already programmed; callback only reports completion */
+} pending_change_t;
+
+/**
+ * @brief Remove a change from the pending list (queue lock held)
+ */
+static void unlink_pending(struct intel_config_queue *queue, pending_change_t *pending)
+{
+    if (pending->prev) {
+        pending->prev->next = pending->next;
+    } else {
+        queue->pending = pending->next;
+    }
+    if (pending->next) {
+        pending->next->prev = pending->prev;
+    }
+}
+
+void intel_config_queue_destroy(struct intel_config_queue *queue)
+{
+    if (!queue) {
+        return;
+    }
+
+    /* The device scheduler is already stopped: changes still listed will never run */
+    while (queue->pending) {
+        pending_change_t *pending = queue->pending;
+        queue->pending = pending->next;
+        free(pending);
+    }
+
+#ifdef INTEL_HAL_LINUX
+    if (queue->event_fd >= 0) {
+        close(queue->event_fd);
+    }
+#endif
+#ifdef INTEL_HAL_WINDOWS
+    if (queue->event) {
+        CloseHandle(queue->event);
+    }
+#endif
+
+    intel_hal_mutex_destroy(&queue->lock);
+    free(queue);
+}
+
+/**
+ * @brief Get the device configuration queue, creating it if needed
+ */
+static intel_hal_result_t get_queue(intel_device_t *device, struct intel_config_queue **out)
+{
+    struct intel_config_queue *queue;
+
+    queue = (struct intel_config_queue *)intel_atomic_load_ptr((void *const volatile *)&device->config_queue);
+    if (queue) {
+        *out = queue;
+        return INTEL_HAL_SUCCESS;
+    }
+
+    queue = (struct intel_config_queue *)calloc(1, sizeof(*queue));
+    if (!queue) {
+        intel_hal_set_error("Out of memory creating configuration queue");
+        return INTEL_HAL_ERROR_NO_MEMORY;
+    }
+    intel_hal_mutex_init(&queue->lock);
+
+#ifdef INTEL_HAL_LINUX
+    queue->event_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (queue->event_fd < 0) {
+        intel_hal_set_error("Cannot create configuration event: %s", strerror(errno));
+        intel_config_queue_destroy(queue);
+        return INTEL_HAL_ERROR_OS_SPECIFIC;
+    }
+#endif
+#ifdef INTEL_HAL_WINDOWS
+    queue->event = CreateEventW(NULL, FALSE, FALSE, NULL);
+    if (!queue->event) {
+        intel_hal_set_error("Cannot create configuration event: %u", (unsigned int)GetLastError());
+        intel_config_queue_destroy(queue);
+        return INTEL_HAL_ERROR_OS_SPECIFIC;
+    }
+#endif
+
+    /* Another thread may have created the queue concurrently */
+    if (!intel_atomic_cas_ptr((void *volatile *)&device->config_queue, NULL, queue)) {
+        intel_config_queue_destroy(queue);
+        queue = (struct intel_config_queue *)intel_atomic_load_ptr((void *const volatile *)&device->config_queue);
+    }
+
+    *out = queue;
+    return INTEL_HAL_SUCCESS;
+}
+
+static void post_completion(struct intel_config_queue *queue, uint64_t change_id, intel_hal_result_t result,
+                            uint64_t activation_time, uint64_t applied_time)
+{
+    intel_hal_config_completion_t *completion;
+
+    intel_hal_mutex_lock(&queue->lock);
+    if (queue->count == INTEL_HAL_CONFIG_COMPLETION_DEPTH) {
+        /* Reader fell behind: drop the oldest completion */
+        queue->head = (queue->head + 1) % INTEL_HAL_CONFIG_COMPLETION_DEPTH;
+        queue->count--;
+    }
+    completion = &queue->completions[(queue->head + queue->count) % INTEL_HAL_CONFIG_COMPLETION_DEPTH];
+    completion->change_id = change_id;
+    completion->result = result;
+    completion->activation_time = activation_time;
+    completion->applied_time = applied_time;
+    queue->count++;
+    intel_hal_mutex_unlock(&queue->lock);
+
+#ifdef INTEL_HAL_LINUX
+    {
+        uint64_t one = 1;
+        if (write(queue->event_fd, &one, sizeof(one)) < 0) {
+            /* Counter saturated: the reader is already signalled */
+        }
+    }
+#endif
+#ifdef INTEL_HAL_WINDOWS
+    SetEvent(queue->event);
+#endif
+}
+
+static intel_hal_result_t apply_change(intel_device_t *device, const intel_hal_config_change_t *change)
+{
+    switch (change->type) {
+        case INTEL_HAL_CHANGE_VLAN_FILTER:
+            return intel_hal_configure_vlan_filter(device, change->u.vlan.vlan_id, change->u.vlan.enable);
+        case INTEL_HAL_CHANGE_PRIORITY_MAP:
+            return intel_hal_configure_priority_mapping(device, change->u.priority_map.priority,
+                                                        change->u.priority_map.traffic_class);
+        case INTEL_HAL_CHANGE_CBS:
+            return intel_hal_configure_cbs_unchecked(device, change->u.cbs.traffic_class, &change->u.cbs.config);
+        case INTEL_HAL_CHANGE_TAS:
+            return intel_hal_setup_time_aware_shaper(device, &change->u.tas);
+        default:
+            return INTEL_HAL_ERROR_INVALID_PARAM;
+    }
+}
+
+static void change_callback(intel_device_t *device, uint64_t phc_time, void *arg)
+{
+    pending_change_t *pending = (pending_change_t *)arg;
+    intel_hal_result_t result = INTEL_HAL_SUCCESS;
+    uint64_t applied_time = phc_time;
+    uint64_t change_id;
+
+    if (!pending->hardware_timed) {
+        intel_timestamp_t ts;
+        result = apply_change(device, &pending->change);
+        if (intel_hal_read_timestamp_unchecked(device, &ts) == INTEL_HAL_SUCCESS) {
+            applied_time = ts.seconds * 1000000000ULL + ts.nanoseconds;
+        }
+    }
+
+    /* The submitter publishes change_id under the queue lock */
+    intel_hal_mutex_lock(&pending->queue->lock);
+    change_id = pending->change_id;
+    unlink_pending(pending->queue, pending);
+    intel_hal_mutex_unlock(&pending->queue->lock);
+
+    post_completion(pending->queue, change_id, result, pending->activation_time, applied_time);
+    free(pending);
+}
+
+/**
+ * @brief Check a change against the device up front so errors surface at submit time
+ */
+static intel_hal_result_t validate_change(intel_device_t *device, const intel_hal_config_change_t *change)
+{
+    switch (change->type) {
+        case INTEL_HAL_CHANGE_VLAN_FILTER:
+            if (change->u.vlan.vlan_id > 4095) {
+                break;
+            }
+            if (!intel_device_has_capability(device, INTEL_CAP_VLAN_FILTER)) {
+                intel_hal_set_error("Device does not support VLAN filtering");
+                return INTEL_HAL_ERROR_NOT_SUPPORTED;
+            }
+            return INTEL_HAL_SUCCESS;
+        case INTEL_HAL_CHANGE_PRIORITY_MAP:
+            if (change->u.priority_map.priority > 7 || change->u.priority_map.traffic_class > 7) {
+                break;
+            }
+            if (!intel_device_has_capability(device, INTEL_CAP_QOS_PRIORITY)) {
+                intel_hal_set_error("Device does not support QoS priority mapping");
+                return INTEL_HAL_ERROR_NOT_SUPPORTED;
+            }
+            return INTEL_HAL_SUCCESS;
+        case INTEL_HAL_CHANGE_CBS:
+            if (change->u.cbs.traffic_class > 7) {
+                break;
+            }
+            if (!intel_device_has_capability(device, INTEL_CAP_AVB_SHAPING)) {
+                intel_hal_set_error("Device does not support Credit-Based Shaper");
+                return INTEL_HAL_ERROR_NOT_SUPPORTED;
+            }
+            return INTEL_HAL_SUCCESS;
+        case INTEL_HAL_CHANGE_TAS:
+            if (change->u.tas.gate_control_list_length > INTEL_HAL_TAS_MAX_ENTRIES || change->u.tas.cycle_time == 0) {
+                break;
+            }
+            return INTEL_HAL_SUCCESS;
+        default:
+            break;
+    }
+
+    intel_hal_set_error("Invalid scheduled configuration change");
+    return INTEL_HAL_ERROR_INVALID_PARAM;
+}
+
+intel_hal_result_t intel_hal_submit_config_change(intel_device_t *device, const intel_hal_config_change_t *change,
+                                                  uint64_t activation_time, uint64_t *change_id)
+{
+    struct intel_config_queue *queue;
+    pending_change_t *pending;
+    intel_hal_schedule_id_t id = INTEL_HAL_SCHEDULE_INVALID_ID;
+    intel_hal_result_t result;
+
+    if (!device || !change) {
+        intel_hal_set_error("Invalid parameters for scheduled configuration change");
+        return INTEL_HAL_ERROR_INVALID_PARAM;
+    }
+
+    result = validate_change(device, change);
+    if (result != INTEL_HAL_SUCCESS) {
+        return result;
+    }
+
+    result = get_queue(device, &queue);
+    if (result != INTEL_HAL_SUCCESS) {
+        return result;
+    }
+
+    pending = (pending_change_t *)malloc(sizeof(*pending));
+    if (!pending) {
+        intel_hal_set_error("Out of memory queuing configuration change");
+        return INTEL_HAL_ERROR_NO_MEMORY;
+    }
+    pending->queue = queue;
+    pending->change = *change;
+    pending->activation_time = activation_time;
+    pending->hardware_timed = false;
+
+    /* Hardware gate schedulers switch at base time: program now, report at activation */
+    if (change->type == INTEL_HAL_CHANGE_TAS &&
+        intel_device_has_capability(device, INTEL_CAP_TSN_TIME_AWARE_SHAPER)) {
+        intel_tas_config_t *tas = &pending->change.u.tas;
+        if (tas->base_time < activation_time) {
+            /* Keep the schedule phase: first cycle start at or after activation */
+            tas->base_time += (activation_time - tas->base_time + tas->cycle_time - 1) / tas->cycle_time * tas->cycle_time;
+        }
+        pending->activation_time = tas->base_time;
+        result = intel_hal_tas_program_staged(device, tas);
+        if (result != INTEL_HAL_SUCCESS) {
+            free(pending);
+            return result;
+        }
+        pending->hardware_timed = true;
+    }
+
+    intel_hal_mutex_lock(&queue->lock);
+    result = intel_hal_schedule_at(device, pending->activation_time, change_callback, pending, &id);
+    pending->change_id = id;
+    if (result == INTEL_HAL_SUCCESS) {
+        pending->prev = NULL;
+        pending->next = queue->pending;
+        if (queue->pending) {
+            queue->pending->prev = pending;
+        }
+        queue->pending = pending;
+    }
+    intel_hal_mutex_unlock(&queue->lock);
+
+    if (result != INTEL_HAL_SUCCESS) {
+        free(pending);
+        return result;
+    }
+
+    if (change_id) {
+        *change_id = id;
+    }
+    return INTEL_HAL_SUCCESS;
+}
+
+intel_hal_result_t intel_hal_cancel_config_change(intel_device_t *device, uint64_t change_id)
+{
+    struct intel_config_queue *queue;
+    pending_change_t *pending;
+    intel_hal_result_t result;
+    bool started = false;
+
+    if (!device) {
+        intel_hal_set_error("Invalid device");
+        return INTEL_HAL_ERROR_INVALID_PARAM;
+    }
+
+    queue = (struct intel_config_queue *)intel_atomic_load_ptr((void *const volatile *)&device->config_queue);
+    if (!queue) {
+        intel_hal_set_error("Unknown configuration change");
+        return INTEL_HAL_ERROR_INVALID_PARAM;
+    }
+
+    intel_hal_mutex_lock(&queue->lock);
+    pending = queue->pending;
+    while (pending && pending->change_id != change_id) {
+        pending = pending->next;
+    }
+    if (pending && pending->hardware_timed) {
+        intel_hal_mutex_unlock(&queue->lock);
+        intel_hal_set_error("Configuration change already programmed into the hardware gate scheduler");
+        return INTEL_HAL_ERROR_NOT_SUPPORTED;
+    }
+    intel_hal_mutex_unlock(&queue->lock);
+    if (!pending) {
+        intel_hal_set_error("Configuration change unknown or already applied");
+        return INTEL_HAL_ERROR_INVALID_PARAM;
+    }
+
+    /* Once the callback has started it owns the change and reports its completion */
+    result = intel_scheduler_cancel_sync(device, change_id, &started);
+    if (result != INTEL_HAL_SUCCESS || started) {
+        intel_hal_set_error("Configuration change already applied");
+        return INTEL_HAL_ERROR_INVALID_PARAM;
+    }
+
+    intel_hal_mutex_lock(&queue->lock);
+    unlink_pending(queue, pending);
+    intel_hal_mutex_unlock(&queue->lock);
+    free(pending);
+    return INTEL_HAL_SUCCESS;
+}
+
+intel_hal_result_t intel_hal_get_config_event(intel_device_t *device, intel_hal_event_handle_t *event)
+{
+    struct intel_config_queue *queue;
+    intel_hal_result_t result;
+
+    if (!device || !event) {
+        intel_hal_set_error("Invalid parameters");
+        return INTEL_HAL_ERROR_INVALID_PARAM;
+    }
+
+    result = get_queue(device, &queue);
+    if (result != INTEL_HAL_SUCCESS) {
+        return result;
+    }
+
+#ifdef INTEL_HAL_LINUX
+    *event = queue->event_fd;
+#endif
+#ifdef INTEL_HAL_WINDOWS
+    *event = queue->event;
+#endif
+    return INTEL_HAL_SUCCESS;
+}
+
+intel_hal_result_t intel_hal_read_config_completions(intel_device_t *device, intel_hal_config_completion_t *completions,
+                                                     uint32_t max_completions, uint32_t *count)
+{
+    struct intel_config_queue *queue;
+    uint32_t n = 0;
+
+    if (!device || !completions || !count) {
+        intel_hal_set_error("Invalid parameters");
+        return INTEL_HAL_ERROR_INVALID_PARAM;
+    }
+
+    queue = (struct intel_config_queue *)intel_atomic_load_ptr((void *const volatile *)&device->config_queue);
+    if (queue) {
+#ifdef INTEL_HAL_LINUX
+        uint64_t value;
+        if (read(queue->event_fd, &value, sizeof(value)) < 0) {
+            /* Not signalled: nothing new */
+        }
+#endif
+        intel_hal_mutex_lock(&queue->lock);
+        while (n < max_completions && queue->count > 0) {
+            completions[n++] = queue->completions[queue->head];
+            queue->head = (queue->head + 1) % INTEL_HAL_CONFIG_COMPLETION_DEPTH;
+            queue->count--;
+        }
+#ifdef INTEL_HAL_WINDOWS
+        if (queue->count > 0) {
+            SetEvent(queue->event);     /* Keep the event signalled while completions remain */
+        }
+#endif
+#ifdef INTEL_HAL_LINUX
+        if (queue->count > 0) {
+            uint64_t one = 1;
+            if (write(queue->event_fd, &one, sizeof(one)) < 0) {
+                /* Already signalled */
+            }
+        }
+#endif
+        intel_hal_mutex_unlock(&queue->lock);
+    }
+
+    *count = n;
+    return INTEL_HAL_SUCCESS;
+}
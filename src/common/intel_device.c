@@ -28,70 +28,49 @@ typedef struct {
 static const intel_device_entry_t intel_device_database[] = {
     /* I210 Family */
     { INTEL_DEVICE_I210_1533, INTEL_FAMILY_I210,
-      INTEL_CAP_BASIC_1588 | INTEL_CAP_MMIO | INTEL_CAP_DMA | INTEL_CAP_NATIVE_OS |
-      INTEL_CAP_VLAN_FILTER | INTEL_CAP_QOS_PRIORITY | INTEL_CAP_AVB_SHAPING,
+      INTEL_FAMILY_I210_CAPABILITIES,
       "I210", "Intel I210 Gigabit Network Connection" },
     { INTEL_DEVICE_I210_1536, INTEL_FAMILY_I210,
-      INTEL_CAP_BASIC_1588 | INTEL_CAP_MMIO | INTEL_CAP_DMA | INTEL_CAP_NATIVE_OS |
-      INTEL_CAP_VLAN_FILTER | INTEL_CAP_QOS_PRIORITY | INTEL_CAP_AVB_SHAPING,
+      INTEL_FAMILY_I210_CAPABILITIES,
       "I210-T1", "Intel I210-T1 Gigabit Network Connection" },
     { INTEL_DEVICE_I210_1537, INTEL_FAMILY_I210,
-      INTEL_CAP_BASIC_1588 | INTEL_CAP_MMIO | INTEL_CAP_DMA | INTEL_CAP_NATIVE_OS |
-      INTEL_CAP_VLAN_FILTER | INTEL_CAP_QOS_PRIORITY | INTEL_CAP_AVB_SHAPING,
+      INTEL_FAMILY_I210_CAPABILITIES,
       "I210-IS", "Intel I210-IS Gigabit Network Connection" },
     
     /* I219 Family */
     { INTEL_DEVICE_I219_15B7, INTEL_FAMILY_I219,
-      INTEL_CAP_BASIC_1588 | INTEL_CAP_MDIO | INTEL_CAP_NATIVE_OS | 
-      INTEL_CAP_VLAN_FILTER | INTEL_CAP_QOS_PRIORITY | INTEL_CAP_AVB_SHAPING | INTEL_CAP_ADVANCED_QOS,
+      INTEL_FAMILY_I219_CAPABILITIES,
       "I219-LM", "Intel I219-LM Gigabit Network Connection" },
     { INTEL_DEVICE_I219_15B8, INTEL_FAMILY_I219,
-      INTEL_CAP_BASIC_1588 | INTEL_CAP_MDIO | INTEL_CAP_NATIVE_OS |
-      INTEL_CAP_VLAN_FILTER | INTEL_CAP_QOS_PRIORITY | INTEL_CAP_AVB_SHAPING | INTEL_CAP_ADVANCED_QOS,
+      INTEL_FAMILY_I219_CAPABILITIES,
       "I219-V", "Intel I219-V Gigabit Network Connection" },
     { INTEL_DEVICE_I219_15D6, INTEL_FAMILY_I219,
-      INTEL_CAP_BASIC_1588 | INTEL_CAP_MDIO | INTEL_CAP_NATIVE_OS |
-      INTEL_CAP_VLAN_FILTER | INTEL_CAP_QOS_PRIORITY | INTEL_CAP_AVB_SHAPING | INTEL_CAP_ADVANCED_QOS,
+      INTEL_FAMILY_I219_CAPABILITIES,
       "I219-V", "Intel I219-V Gigabit Network Connection" },
     { INTEL_DEVICE_I219_15D7, INTEL_FAMILY_I219,
-      INTEL_CAP_BASIC_1588 | INTEL_CAP_MDIO | INTEL_CAP_NATIVE_OS |
-      INTEL_CAP_VLAN_FILTER | INTEL_CAP_QOS_PRIORITY | INTEL_CAP_AVB_SHAPING | INTEL_CAP_ADVANCED_QOS,
+      INTEL_FAMILY_I219_CAPABILITIES,
       "I219-LM", "Intel I219-LM Gigabit Network Connection" },
     { INTEL_DEVICE_I219_15D8, INTEL_FAMILY_I219,
-      INTEL_CAP_BASIC_1588 | INTEL_CAP_MDIO | INTEL_CAP_NATIVE_OS |
-      INTEL_CAP_VLAN_FILTER | INTEL_CAP_QOS_PRIORITY | INTEL_CAP_AVB_SHAPING | INTEL_CAP_ADVANCED_QOS,
+      INTEL_FAMILY_I219_CAPABILITIES,
       "I219-V", "Intel I219-V Gigabit Network Connection" },
     { INTEL_DEVICE_I219_0DC7, INTEL_FAMILY_I219,
-      INTEL_CAP_BASIC_1588 | INTEL_CAP_MDIO | INTEL_CAP_NATIVE_OS |
-      INTEL_CAP_VLAN_FILTER | INTEL_CAP_QOS_PRIORITY | INTEL_CAP_AVB_SHAPING | INTEL_CAP_ADVANCED_QOS,
+      INTEL_FAMILY_I219_CAPABILITIES,
       "I219-LM", "Intel I219-LM Gigabit Network Connection (Gen 22)" },
     
     /* I225 Family */
     { INTEL_DEVICE_I225_15F2, INTEL_FAMILY_I225,
-      INTEL_CAP_BASIC_1588 | INTEL_CAP_ENHANCED_TS | INTEL_CAP_TSN_TAS | 
-      INTEL_CAP_TSN_FP | INTEL_CAP_PCIe_PTM | INTEL_CAP_2_5G | 
-      INTEL_CAP_MMIO | INTEL_CAP_DMA | INTEL_CAP_NATIVE_OS |
-      INTEL_CAP_VLAN_FILTER | INTEL_CAP_QOS_PRIORITY | INTEL_CAP_AVB_SHAPING | INTEL_CAP_ADVANCED_QOS,
+      INTEL_FAMILY_I225_CAPABILITIES,
       "I225-LM", "Intel I225-LM 2.5 Gigabit Network Connection" },
     { INTEL_DEVICE_I225_15F3, INTEL_FAMILY_I225,
-      INTEL_CAP_BASIC_1588 | INTEL_CAP_ENHANCED_TS | INTEL_CAP_TSN_TAS | 
-      INTEL_CAP_TSN_FP | INTEL_CAP_PCIe_PTM | INTEL_CAP_2_5G | 
-      INTEL_CAP_MMIO | INTEL_CAP_DMA | INTEL_CAP_NATIVE_OS |
-      INTEL_CAP_VLAN_FILTER | INTEL_CAP_QOS_PRIORITY | INTEL_CAP_AVB_SHAPING | INTEL_CAP_ADVANCED_QOS,
+      INTEL_FAMILY_I225_CAPABILITIES,
       "I225-V", "Intel I225-V 2.5 Gigabit Network Connection" },
     
     /* I226 Family */
     { INTEL_DEVICE_I226_125B, INTEL_FAMILY_I226,
-      INTEL_CAP_BASIC_1588 | INTEL_CAP_ENHANCED_TS | INTEL_CAP_TSN_TAS | 
-      INTEL_CAP_TSN_FP | INTEL_CAP_PCIe_PTM | INTEL_CAP_2_5G | 
-      INTEL_CAP_MMIO | INTEL_CAP_DMA | INTEL_CAP_NATIVE_OS |
-      INTEL_CAP_VLAN_FILTER | INTEL_CAP_QOS_PRIORITY | INTEL_CAP_AVB_SHAPING | INTEL_CAP_ADVANCED_QOS,
+      INTEL_FAMILY_I226_CAPABILITIES,
       "I226-LM", "Intel I226-LM 2.5 Gigabit Network Connection" },
     { INTEL_DEVICE_I226_125C, INTEL_FAMILY_I226,
-      INTEL_CAP_BASIC_1588 | INTEL_CAP_ENHANCED_TS | INTEL_CAP_TSN_TAS | 
-      INTEL_CAP_TSN_FP | INTEL_CAP_PCIe_PTM | INTEL_CAP_2_5G | 
-      INTEL_CAP_MMIO | INTEL_CAP_DMA | INTEL_CAP_NATIVE_OS |
-      INTEL_CAP_VLAN_FILTER | INTEL_CAP_QOS_PRIORITY | INTEL_CAP_AVB_SHAPING | INTEL_CAP_ADVANCED_QOS,
+      INTEL_FAMILY_I226_CAPABILITIES,
       "I226-V", "Intel I226-V 2.5 Gigabit Network Connection" },
     
     /* Terminator */
@@ -114,6 +93,28 @@ static const intel_device_entry_t *intel_lookup_device(uint16_t device_id)
     return NULL;
 }
 
+/**
+ * @brief Look up family, capabilities and static model name of a device ID
+ *
+ * @return Model name (static storage), or NULL if the device is not supported
+ */
+const char *intel_device_lookup(uint16_t device_id, intel_device_family_t *family, uint32_t *capabilities)
+{
+    const intel_device_entry_t *entry = intel_lookup_device(device_id);
+    
+    if (!entry) {
+        return NULL;
+    }
+    
+    if (family) {
+        *family = entry->family;
+    }
+    if (capabilities) {
+        *capabilities = entry->capabilities;
+    }
+    return entry->name;
+}
+
 /**
  * @brief Initialize device info structure from device database
  */
@@ -171,6 +172,8 @@ intel_device_t *intel_device_create(uint16_t device_id)
     device->is_open = false;
     device->ref_count = 1;
     device->platform_data = NULL;
+    intel_hal_mutex_init(&device->state_lock);
+    intel_ledger_init(device);
     
     return device;
 }
@@ -197,6 +200,8 @@ void intel_device_destroy(intel_device_t *device)
         free(device->platform_data);
     }
     
+    intel_hal_mutex_destroy(&device->state_lock);
+    intel_ledger_destroy(device);
     free(device);
 }
 
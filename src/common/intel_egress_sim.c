@@ -0,0 +1,418 @@
+/******************************************************************************
+
+  Copyright (c) 2025, Intel Corporation
+  All rights reserved.
+
+  Intel Ethernet HAL - Egress Pipeline Simulation
+
+  Discrete-event model of the I225/I226 transmit path. Time only advances
+  to the next event that can change the transmit decision: a frame arrival,
+  a launch time, a gate opening or a CBS credit reaching zero. Gate lookups
+  use the TAS lookup index, CBS credits are updated lazily, and queues are
+  index links into the caller's frame array, so no per-frame allocation
+  is made.
+
+******************************************************************************/
+
+#include "../include/intel_ethernet_hal.h"
+#include "../intel_hal_private.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define SIM_NONE                UINT32_MAX
+#define SIM_NEVER               UINT64_MAX
+#define SIM_PREAMBLE_BYTES      8           /* Preamble and start delimiter */
+#define SIM_IPG_BYTES           12
+#define SIM_MCRC_BYTES          4           /* mCRC ending a preempted fragment */
+#define SIM_MIN_FRAGMENT_BYTES  64
+#define SIM_CREDIT_EPSILON      1e-6        /* Credit rounding tolerance in bytes */
+
+typedef struct {
+    const intel_egress_sim_config_t *config;
+    const intel_egress_sim_frame_t *frames;
+    intel_egress_sim_result_t *results;
+    uint32_t count;
+    uint32_t arrived;                       /* Frames queued so far (arrival order) */
+    uint32_t done;
+    uint32_t *next;                         /* Queue links */
+    uint32_t head[8];
+    uint32_t tail[8];
+    uint32_t queued[8];
+    uint64_t head_remaining[8];             /* Wire bytes left of a preempted head (0 if not started) */
+    double credit[8];                       /* CBS credit in bytes */
+    uint64_t credit_time[8];
+    uint32_t busy_tc;                       /* Class on the wire, 8 if idle */
+    uint64_t byte_ps;                       /* Wire time of one byte in picoseconds */
+    uint8_t express_mask;
+    intel_tas_index_t index;
+    uint64_t max_window[8];
+} sim_t;
+
+static uint64_t wire_ns(const sim_t *sim, uint64_t bytes)
+{
+    return (bytes * sim->byte_ps + 999) / 1000;
+}
+
+static uint64_t frame_wire_bytes(const intel_egress_sim_frame_t *frame)
+{
+    return SIM_PREAMBLE_BYTES + frame->packet.packet_length + SIM_IPG_BYTES;
+}
+
+/**
+ * @brief Bring the CBS credit of a class up to a time (not while it transmits)
+ */
+static void cbs_update(sim_t *sim, uint32_t tc, uint64_t time)
+{
+    const intel_cbs_config_t *cbs = &sim->config->cbs[tc];
+
+    if (!cbs->enabled || time <= sim->credit_time[tc]) {
+        return;
+    }
+
+    if (sim->queued[tc] > 0 || sim->credit[tc] < 0) {
+        sim->credit[tc] += (double)cbs->idle_slope * (double)(time - sim->credit_time[tc]) * 1e-9;
+    }
+    if (sim->queued[tc] == 0 && sim->credit[tc] > 0) {
+        sim->credit[tc] = 0;            /* Positive credit is lost when the queue empties */
+    }
+    if (sim->credit[tc] > cbs->hi_credit) {
+        sim->credit[tc] = cbs->hi_credit;
+    }
+    sim->credit_time[tc] = time;
+}
+
+/**
+ * @brief Charge the CBS credit of a class for transmitting from start to end
+ */
+static void cbs_transmit(sim_t *sim, uint32_t tc, uint64_t start, uint64_t end)
+{
+    const intel_cbs_config_t *cbs = &sim->config->cbs[tc];
+
+    if (!cbs->enabled) {
+        return;
+    }
+
+    sim->credit[tc] -= (double)cbs->send_slope * (double)(end - start) * 1e-9;
+    if (cbs->lo_credit > 0 && sim->credit[tc] < -(double)cbs->lo_credit) {
+        sim->credit[tc] = -(double)cbs->lo_credit;
+    }
+    if (sim->queued[tc] == 0 && sim->credit[tc] > 0) {
+        sim->credit[tc] = 0;
+    }
+    sim->credit_time[tc] = end;
+}
+
+/**
+ * @brief Queue the frames that arrived by a time
+ */
+static void enqueue_until(sim_t *sim, uint64_t time)
+{
+    while (sim->arrived < sim->count && sim->frames[sim->arrived].arrival_ns <= time) {
+        uint32_t id = sim->arrived++;
+        const intel_egress_sim_frame_t *frame = &sim->frames[id];
+        uint32_t tc = frame->packet.queue;
+
+        if (sim->config->tas_enabled && wire_ns(sim, frame_wire_bytes(frame)) > sim->max_window[tc]) {
+            sim->results[id].dropped = true;
+            sim->done++;
+            continue;
+        }
+
+        if (tc != sim->busy_tc) {
+            cbs_update(sim, tc, frame->arrival_ns);
+        }
+        sim->next[id] = SIM_NONE;
+        if (sim->queued[tc]++ == 0) {
+            sim->head[tc] = id;
+        } else {
+            sim->next[sim->tail[tc]] = id;
+        }
+        sim->tail[tc] = id;
+    }
+}
+
+/**
+ * @brief Check that a class gate is open and stays open for a transmission
+ *
+ * @param[out] next Earliest time the transmission could start otherwise
+ */
+static bool gate_allows(const sim_t *sim, uint32_t tc, uint64_t time, uint64_t bytes, uint64_t *next)
+{
+    intel_tas_gate_info_t info;
+
+    if (!sim->config->tas_enabled) {
+        return true;
+    }
+
+    intel_hal_tas_index_query(&sim->index, time, (uint8_t)tc, &info);
+    if (info.open && info.window_start <= time) {
+        if (time + wire_ns(sim, bytes) <= info.window_end) {
+            return true;
+        }
+        intel_hal_tas_index_query(&sim->index, info.window_end, (uint8_t)tc, &info);
+    }
+    *next = info.window_start;
+    return false;
+}
+
+/**
+ * @brief Select the class to transmit next, express classes first
+ *
+ * @param[out] next Earliest time a blocked class could become eligible
+ * @return Traffic class, or 8 if none is eligible
+ */
+static uint32_t select_class(sim_t *sim, uint64_t time, bool express_only, uint64_t *next)
+{
+    int pass;
+    int tc;
+
+    *next = SIM_NEVER;
+    for (pass = 0; pass < (express_only ? 1 : 2); pass++) {
+        for (tc = 7; tc >= 0; tc--) {
+            const intel_egress_sim_frame_t *frame;
+            uint64_t candidate = SIM_NEVER;
+            uint64_t bytes;
+
+            if (sim->queued[tc] == 0 || (uint32_t)tc == sim->busy_tc ||
+                ((sim->express_mask >> tc) & 1) != (pass == 0)) {
+                continue;
+            }
+            frame = &sim->frames[sim->head[tc]];
+
+            if (frame->packet.launch_time > time && sim->head_remaining[tc] == 0) {
+                candidate = frame->packet.launch_time;
+            } else {
+                if (sim->config->cbs[tc].enabled) {
+                    cbs_update(sim, (uint32_t)tc, time);
+                    if (sim->credit[tc] < -SIM_CREDIT_EPSILON) {
+                        double wait = -sim->credit[tc] * 1e9 / sim->config->cbs[tc].idle_slope;
+                        candidate = time + (uint64_t)wait + 1;
+                    }
+                }
+                bytes = sim->head_remaining[tc] ? sim->head_remaining[tc] : frame_wire_bytes(frame);
+                if (candidate == SIM_NEVER && gate_allows(sim, (uint32_t)tc, time, bytes, &candidate)) {
+                    return (uint32_t)tc;
+                }
+            }
+            if (candidate < *next) {
+                *next = candidate;
+            }
+        }
+    }
+    return 8;
+}
+
+/**
+ * @brief Put the head frame of a class on the wire, until done or preempted
+ */
+static void transmit(sim_t *sim, uint32_t tc, uint64_t *time)
+{
+    const intel_egress_sim_config_t *config = sim->config;
+    uint32_t id = sim->head[tc];
+    intel_egress_sim_result_t *result = &sim->results[id];
+    const intel_egress_sim_frame_t *frame = &sim->frames[id];
+    uint64_t start = *time;
+    uint64_t bytes = sim->head_remaining[tc] ? sim->head_remaining[tc] : frame_wire_bytes(frame);
+    uint64_t end = start + wire_ns(sim, bytes);
+    uint64_t min_fragment = SIM_MIN_FRAGMENT_BYTES * (1 + (uint64_t)config->fp.additional_fragment_size);
+
+    if (sim->head_remaining[tc] == 0) {
+        result->start_ns = start;
+    }
+    sim->busy_tc = tc;
+
+    /* A preemptible frame runs until an express frame is eligible and the fragment rules allow a cut */
+    if (config->fp_enabled && !((sim->express_mask >> tc) & 1) &&
+        bytes >= SIM_PREAMBLE_BYTES + min_fragment + SIM_MIN_FRAGMENT_BYTES + SIM_IPG_BYTES) {
+        uint64_t now = start;
+        uint64_t earliest = start + wire_ns(sim, SIM_PREAMBLE_BYTES + min_fragment);
+        uint64_t latest = end - wire_ns(sim, SIM_MIN_FRAGMENT_BYTES + SIM_IPG_BYTES);
+
+        while (now < end) {
+            uint64_t event;
+            uint64_t arrival = sim->arrived < sim->count ? sim->frames[sim->arrived].arrival_ns : SIM_NEVER;
+            uint32_t express = select_class(sim, now, true, &event);
+
+            if (express < 8) {
+                if (now > latest) {
+                    break;              /* Too little left to cut */
+                }
+                if (now >= earliest) {
+                    uint64_t sent = (now - start) * 1000 / sim->byte_ps;
+                    uint64_t cut = now + wire_ns(sim, SIM_MCRC_BYTES + SIM_IPG_BYTES);
+
+                    sim->head_remaining[tc] = bytes - sent + SIM_PREAMBLE_BYTES;
+                    result->preemptions++;
+                    cbs_transmit(sim, tc, start, cut);
+                    sim->busy_tc = 8;
+                    *time = cut;
+                    return;
+                }
+                event = earliest;
+            }
+            if (arrival < event) {
+                event = arrival;
+            }
+            if (event >= end) {
+                break;
+            }
+            now = event > now ? event : now + 1;
+            enqueue_until(sim, now);
+        }
+    }
+
+    /* Frame complete; the inter-packet gap follows the FCS */
+    result->end_ns = end - wire_ns(sim, SIM_IPG_BYTES);
+    sim->head_remaining[tc] = 0;
+    sim->head[tc] = sim->next[id];
+    sim->queued[tc]--;
+    sim->done++;
+    cbs_transmit(sim, tc, start, end);
+    sim->busy_tc = 8;
+    *time = end;
+}
+
+void intel_hal_egress_sim_config_init(intel_egress_sim_config_t *config, uint32_t link_speed_mbps)
+{
+    uint32_t tc;
+
+    if (!config) {
+        return;
+    }
+
+    memset(config, 0, sizeof(*config));
+    config->link_speed_mbps = link_speed_mbps;
+    for (tc = 0; tc < 8; tc++) {
+        config->cbs[tc].traffic_class = (uint8_t)tc;
+    }
+}
+
+intel_hal_result_t intel_hal_egress_simulate(const intel_egress_sim_config_t *config,
+                                             const intel_egress_sim_frame_t *frames, uint32_t count,
+                                             intel_egress_sim_result_t *results, intel_egress_sim_stats_t *stats)
+{
+    sim_t sim;
+    uint64_t time;
+    uint64_t busy = 0;
+    double latency_sum[8] = {0};
+    uint32_t tc;
+    uint32_t i;
+
+    if (!config || (!frames && count > 0) || (!results && count > 0) || config->link_speed_mbps == 0) {
+        intel_hal_set_error("Invalid parameters for egress simulation");
+        return INTEL_HAL_ERROR_INVALID_PARAM;
+    }
+    for (i = 0; i < count; i++) {
+        if (frames[i].packet.queue > 7 || frames[i].packet.packet_length == 0 ||
+            (i > 0 && frames[i].arrival_ns < frames[i - 1].arrival_ns)) {
+            intel_hal_set_error("Frame %u has an invalid class or length or is out of arrival order", i);
+            return INTEL_HAL_ERROR_INVALID_PARAM;
+        }
+    }
+    for (tc = 0; tc < 8; tc++) {
+        if (config->cbs[tc].enabled && config->cbs[tc].idle_slope == 0) {
+            intel_hal_set_error("CBS of traffic class %u has no idle slope", tc);
+            return INTEL_HAL_ERROR_INVALID_PARAM;
+        }
+    }
+
+    memset(&sim, 0, sizeof(sim));
+    if (config->tas_enabled) {
+        if (intel_hal_tas_index_build(&config->tas, &sim.index) != INTEL_HAL_SUCCESS) {
+            return INTEL_HAL_ERROR_INVALID_PARAM;
+        }
+        for (tc = 0; tc < 8; tc++) {
+            for (i = 0; i < sim.index.window_count[tc]; i++) {
+                uint64_t length = sim.index.window_end[tc][i] - (uint64_t)sim.index.window_start[tc][i];
+                if (length > sim.max_window[tc]) {
+                    sim.max_window[tc] = length;
+                }
+            }
+        }
+    }
+
+    sim.next = (uint32_t *)malloc((count ? count : 1) * sizeof(*sim.next));
+    if (!sim.next) {
+        intel_hal_set_error("Out of memory in egress simulation");
+        return INTEL_HAL_ERROR_NO_MEMORY;
+    }
+    memset(results, 0, count * sizeof(*results));
+    sim.config = config;
+    sim.frames = frames;
+    sim.results = results;
+    sim.count = count;
+    sim.busy_tc = 8;
+    sim.byte_ps = 8000000ULL / config->link_speed_mbps;
+    sim.express_mask = config->fp_enabled ? (uint8_t)~config->fp.preemptible_queues : 0xFF;
+
+    time = count > 0 ? frames[0].arrival_ns : 0;
+    while (sim.done < count) {
+        uint64_t next;
+
+        enqueue_until(&sim, time);
+        tc = select_class(&sim, time, false, &next);
+        if (tc < 8) {
+            uint64_t start = time;
+            transmit(&sim, tc, &time);
+            busy += time - start;
+            continue;
+        }
+
+        if (sim.arrived < count && sim.frames[sim.arrived].arrival_ns < next) {
+            next = sim.frames[sim.arrived].arrival_ns;
+        }
+        if (next == SIM_NEVER) {
+            break;                      /* Nothing can change any more */
+        }
+        time = next > time ? next : time + 1;
+    }
+    for (i = 0; sim.done < count && i < count; i++) {
+        if (!results[i].dropped && results[i].end_ns == 0) {
+            results[i].blocked = true;  /* No gate, credit or launch time ever lets it start */
+        }
+    }
+
+    if (stats) {
+        memset(stats, 0, sizeof(*stats));
+        for (i = 0; i < count; i++) {
+            const intel_egress_sim_result_t *result = &results[i];
+            intel_egress_sim_tc_stats_t *tc_stats = &stats->tc[frames[i].packet.queue];
+            uint64_t latency;
+
+            if (result->dropped) {
+                tc_stats->dropped++;
+                continue;
+            }
+            if (result->blocked) {
+                tc_stats->blocked++;
+                continue;
+            }
+            latency = result->end_ns - frames[i].arrival_ns;
+            if (tc_stats->frames == 0 || latency < tc_stats->min_latency_ns) {
+                tc_stats->min_latency_ns = latency;
+            }
+            if (latency > tc_stats->max_latency_ns) {
+                tc_stats->max_latency_ns = latency;
+            }
+            if (frames[i].packet.launch_time > 0 && result->start_ns > frames[i].packet.launch_time &&
+                result->start_ns - frames[i].packet.launch_time > tc_stats->max_launch_delay_ns) {
+                tc_stats->max_launch_delay_ns = result->start_ns - frames[i].packet.launch_time;
+            }
+            latency_sum[frames[i].packet.queue] += (double)latency;
+            tc_stats->preemptions += result->preemptions;
+            tc_stats->frames++;
+            if (result->end_ns > stats->end_time_ns) {
+                stats->end_time_ns = result->end_ns;
+            }
+        }
+        for (tc = 0; tc < 8; tc++) {
+            if (stats->tc[tc].frames > 0) {
+                stats->tc[tc].mean_latency_ns = latency_sum[tc] / (double)stats->tc[tc].frames;
+            }
+        }
+        stats->busy_ns = busy;
+    }
+
+    free(sim.next);
+    return INTEL_HAL_SUCCESS;
+}
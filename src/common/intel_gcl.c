@@ -0,0 +1,454 @@
+/******************************************************************************
+
+  Copyright (c) 2025, Intel Corporation
+  All rights reserved.
+
+  Intel Ethernet HAL - Gate Control List Processing
+
+  Reduces an arbitrary-length 802.1Qbv gate control list to the hardware
+  entry limit without changing the gate timeline: adjacent entries with
+  identical gate states are merged (including across the cycle boundary, by
+  moving the base time), and a list that repeats itself within the cycle is
+  folded onto the shorter sub-cycle. Lists that still do not fit are
+  rejected with the number of entries they need. Also provides the
+  per-traffic-class worst-case latency analysis of a programmed schedule
+  and a lookup index answering gate position and open-window queries by
+  binary search over entry and window boundaries.
+
+******************************************************************************/
+
+#include "../include/intel_ethernet_hal.h"
+#include "../intel_hal_private.h"
+#include <stdlib.h>
+#include <string.h>
+
+intel_hal_result_t intel_hal_gcl_validate(const intel_gcl_t *gcl)
+{
+    uint64_t total = 0;
+    uint32_t i;
+
+    if (!gcl || !gcl->entries || gcl->entry_count == 0 || gcl->cycle_time == 0) {
+        intel_hal_set_error("Gate control list is empty or has no cycle time");
+        return INTEL_HAL_ERROR_INVALID_PARAM;
+    }
+
+    for (i = 0; i < gcl->entry_count; i++) {
+        if (gcl->entries[i].time_interval == 0) {
+            intel_hal_set_error("Gate control entry %u has a zero interval", i);
+            return INTEL_HAL_ERROR_INVALID_PARAM;
+        }
+        total += gcl->entries[i].time_interval;
+    }
+
+    if (total != gcl->cycle_time) {
+        intel_hal_set_error("Gate control intervals sum to %llu ns but cycle time is %llu ns",
+                            (unsigned long long)total, (unsigned long long)gcl->cycle_time);
+        return INTEL_HAL_ERROR_INVALID_PARAM;
+    }
+
+    return INTEL_HAL_SUCCESS;
+}
+
+/**
+ * @brief Merge adjacent entries with identical gate states in place
+ *
+ * @return Number of entries left
+ */
+static uint32_t merge_entries(intel_gcl_entry_t *entries, uint32_t count)
+{
+    uint32_t out = 0;
+    uint32_t i;
+
+    for (i = 0; i < count; i++) {
+        if (out > 0 && entries[out - 1].gate_states == entries[i].gate_states &&
+            (uint64_t)entries[out - 1].time_interval + entries[i].time_interval <= UINT32_MAX) {
+            entries[out - 1].time_interval += entries[i].time_interval;
+        } else {
+            entries[out++] = entries[i];
+        }
+    }
+    return out;
+}
+
+/**
+ * @brief Merge the last entry into the first when their gate states match
+ *
+ * The cycle then starts at the last window, so the base time moves back by
+ * its interval.
+ *
+ * @return Number of entries left
+ */
+static uint32_t merge_wrap(intel_gcl_entry_t *entries, uint32_t count, uint64_t cycle_time, uint64_t *base_time)
+{
+    uint32_t tail;
+
+    if (count < 2 || entries[count - 1].gate_states != entries[0].gate_states ||
+        (uint64_t)entries[0].time_interval + entries[count - 1].time_interval > UINT32_MAX) {
+        return count;
+    }
+
+    tail = entries[count - 1].time_interval;
+    entries[0].time_interval += tail;
+    *base_time = *base_time >= tail ? *base_time - tail : *base_time + cycle_time - tail;
+    return count - 1;
+}
+
+/**
+ * @brief Find the shortest period with which the list repeats itself
+ *
+ * @return Entries per repetition (count if the list does not repeat)
+ */
+static uint32_t repeat_period(const intel_gcl_entry_t *entries, uint32_t count)
+{
+    uint32_t period;
+    uint32_t i;
+
+    for (period = 1; period < count; period++) {
+        if (count % period) {
+            continue;
+        }
+        for (i = period; i < count; i++) {
+            if (entries[i].gate_states != entries[i - period].gate_states ||
+                entries[i].time_interval != entries[i - period].time_interval) {
+                break;
+            }
+        }
+        if (i == count) {
+            return period;
+        }
+    }
+    return count;
+}
+
+intel_hal_result_t intel_hal_gcl_fit(const intel_gcl_t *gcl, intel_tas_config_t *config)
+{
+    intel_gcl_entry_t *entries;
+    uint64_t base_time;
+    uint64_t cycle_time;
+    uint32_t count;
+    uint32_t period;
+    uint32_t i;
+    intel_hal_result_t result;
+
+    if (!config) {
+        intel_hal_set_error("Invalid parameters for gate control list fit");
+        return INTEL_HAL_ERROR_INVALID_PARAM;
+    }
+
+    result = intel_hal_gcl_validate(gcl);
+    if (result != INTEL_HAL_SUCCESS) {
+        return result;
+    }
+
+    entries = (intel_gcl_entry_t *)malloc(gcl->entry_count * sizeof(intel_gcl_entry_t));
+    if (!entries) {
+        intel_hal_set_error("Out of memory fitting gate control list");
+        return INTEL_HAL_ERROR_NO_MEMORY;
+    }
+    memcpy(entries, gcl->entries, gcl->entry_count * sizeof(intel_gcl_entry_t));
+
+    base_time = gcl->base_time;
+    cycle_time = gcl->cycle_time;
+    count = merge_entries(entries, gcl->entry_count);
+    /* Before the period search: a run split by the cycle boundary hides the repetition */
+    count = merge_wrap(entries, count, cycle_time, &base_time);
+
+    /* A list made of identical sub-cycles runs the sub-cycle instead */
+    if (count > INTEL_HAL_TAS_MAX_ENTRIES) {
+        period = repeat_period(entries, count);
+        cycle_time /= count / period;
+        count = period;
+    }
+
+    if (count > INTEL_HAL_TAS_MAX_ENTRIES) {
+        free(entries);
+        intel_hal_set_error("Gate control list needs %u entries after merging (hardware limit %u)",
+                            count, INTEL_HAL_TAS_MAX_ENTRIES);
+        return INTEL_HAL_ERROR_NOT_SUPPORTED;
+    }
+
+    memset(config, 0, sizeof(*config));
+    config->gate_control_list_length = count;
+    config->cycle_time = cycle_time;
+    config->base_time = base_time;
+    for (i = 0; i < count; i++) {
+        config->gate_control_list[i].gate_states = entries[i].gate_states;
+        config->gate_control_list[i].time_interval = entries[i].time_interval;
+    }
+
+    free(entries);
+    return INTEL_HAL_SUCCESS;
+}
+
+intel_hal_result_t intel_hal_setup_gcl(intel_device_t *device, const intel_gcl_t *gcl)
+{
+    intel_tas_config_t config;
+    intel_hal_result_t result;
+
+    if (!device) {
+        intel_hal_set_error("Invalid device");
+        return INTEL_HAL_ERROR_INVALID_PARAM;
+    }
+
+    result = intel_hal_gcl_fit(gcl, &config);
+    if (result != INTEL_HAL_SUCCESS) {
+        return result;
+    }
+
+    return intel_hal_setup_time_aware_shaper(device, &config);
+}
+
+/**
+ * @brief Collect the open windows of one traffic class
+ *
+ * Consecutive open entries form one window; a window open at the end of the
+ * cycle continues into the first one. Window start times come from prefix
+ * sums of the intervals.
+ *
+ * @return Number of windows (0 if the gate never opens)
+ */
+static uint32_t collect_windows(const intel_tas_config_t *config, uint8_t tc_mask,
+                                uint64_t *starts, uint64_t *lengths)
+{
+    uint32_t count = 0;
+    uint64_t offset = 0;
+    bool open = false;
+    uint32_t i;
+
+    for (i = 0; i < config->gate_control_list_length; i++) {
+        uint32_t interval = config->gate_control_list[i].time_interval;
+        bool entry_open = (config->gate_control_list[i].gate_states & tc_mask) != 0;
+
+        if (entry_open) {
+            if (open) {
+                lengths[count - 1] += interval;
+            } else {
+                starts[count] = offset;
+                lengths[count] = interval;
+                count++;
+            }
+        }
+        open = entry_open;
+        offset += interval;
+    }
+
+    /* Fold the tail window into the first one, which then starts before the cycle */
+    if (count > 1 && open && starts[0] == 0) {
+        lengths[0] += lengths[count - 1];
+        starts[0] = starts[count - 1] - config->cycle_time;    /* Wraps; only used modulo the cycle */
+        count--;
+    }
+
+    return count;
+}
+
+intel_hal_result_t intel_hal_analyze_tas(const intel_tas_config_t *config, uint32_t link_speed_mbps,
+                                         const uint32_t frame_size[8], intel_tas_analysis_t *analysis)
+{
+    uint64_t starts[INTEL_HAL_TAS_MAX_ENTRIES];
+    uint64_t lengths[INTEL_HAL_TAS_MAX_ENTRIES];
+    uint64_t total = 0;
+    uint32_t tc;
+    uint32_t i;
+
+    if (!config || !frame_size || !analysis || link_speed_mbps == 0 ||
+        config->gate_control_list_length == 0 ||
+        config->gate_control_list_length > INTEL_HAL_TAS_MAX_ENTRIES) {
+        intel_hal_set_error("Invalid parameters for TAS analysis");
+        return INTEL_HAL_ERROR_INVALID_PARAM;
+    }
+
+    for (i = 0; i < config->gate_control_list_length; i++) {
+        total += config->gate_control_list[i].time_interval;
+    }
+    if (total != config->cycle_time) {
+        intel_hal_set_error("Gate control intervals sum to %llu ns but cycle time is %llu ns",
+                            (unsigned long long)total, (unsigned long long)config->cycle_time);
+        return INTEL_HAL_ERROR_INVALID_PARAM;
+    }
+
+    memset(analysis, 0, sizeof(*analysis));
+
+    for (tc = 0; tc < 8; tc++) {
+        intel_tas_tc_analysis_t *result = &analysis->tc[tc];
+        uint64_t frame_ns = intel_wire_time_ns(frame_size[tc], link_speed_mbps);
+        uint64_t frames = 0;
+        uint32_t count = collect_windows(config, (uint8_t)(1u << tc), starts, lengths);
+        uint32_t usable = 0;
+        uint64_t last_end = 0;      /* Latest start-of-transmission point of the previous usable window */
+        uint64_t first_start = 0;
+        bool have_first = false;
+
+        result->frame_time_ns = frame_ns;
+        result->worst_case_latency_ns = UINT64_MAX;
+
+        if (count == 0) {
+            result->max_closed_interval_ns = config->cycle_time;
+            continue;
+        }
+
+        /* Closed intervals are the gaps between consecutive windows, cyclically */
+        for (i = 0; i < count; i++) {
+            uint64_t next_start = i + 1 < count ? starts[i + 1] : starts[0] + config->cycle_time;
+            uint64_t gap = next_start - (starts[i] + lengths[i]);
+            result->open_time_ns += lengths[i];
+            if (gap > result->max_closed_interval_ns) {
+                result->max_closed_interval_ns = gap;
+            }
+        }
+
+        /*
+         * Worst case: the frame arrives just after the last point a frame can
+         * still start in one usable window and waits for the next one.
+         */
+        for (i = 0; i < count; i++) {
+            if (lengths[i] < frame_ns) {
+                continue;               /* Window too short for this frame */
+            }
+            frames += lengths[i] / frame_ns;
+            if (have_first) {
+                uint64_t latency = starts[i] - last_end + frame_ns;
+                if (result->worst_case_latency_ns == UINT64_MAX || latency > result->worst_case_latency_ns) {
+                    result->worst_case_latency_ns = latency;
+                }
+            } else {
+                first_start = starts[i];
+                have_first = true;
+            }
+            last_end = starts[i] + lengths[i] - frame_ns;
+            usable++;
+        }
+
+        if (usable > 0) {
+            /* Wrap from the last usable window to the first one of the next cycle */
+            uint64_t latency = first_start + config->cycle_time - last_end + frame_ns;
+            if (result->worst_case_latency_ns == UINT64_MAX || latency > result->worst_case_latency_ns) {
+                result->worst_case_latency_ns = latency;
+            }
+            result->guaranteed_bandwidth_bps = (uint64_t)((double)(frames * frame_size[tc] * 8ULL) * 1e9 / (double)config->cycle_time);
+        }
+    }
+
+    return INTEL_HAL_SUCCESS;
+}
+
+uint64_t intel_hal_tas_next_base_time(uint64_t reference_base, uint64_t cycle_time, uint64_t phc_time)
+{
+    if (cycle_time == 0) {
+        return phc_time;
+    }
+
+    return phc_time + (reference_base % cycle_time + cycle_time - phc_time % cycle_time) % cycle_time;
+}
+
+intel_hal_result_t intel_hal_tas_index_build(const intel_tas_config_t *config, intel_tas_index_t *index)
+{
+    uint64_t starts[INTEL_HAL_TAS_MAX_ENTRIES];
+    uint64_t lengths[INTEL_HAL_TAS_MAX_ENTRIES];
+    uint64_t offset = 0;
+    uint32_t tc;
+    uint32_t i;
+
+    if (!config || !index || config->gate_control_list_length == 0 ||
+        config->gate_control_list_length > INTEL_HAL_TAS_MAX_ENTRIES) {
+        intel_hal_set_error("Invalid parameters for TAS index");
+        return INTEL_HAL_ERROR_INVALID_PARAM;
+    }
+
+    memset(index, 0, sizeof(*index));
+    for (i = 0; i < config->gate_control_list_length; i++) {
+        index->entry_start[i] = offset;
+        index->gate_states[i] = config->gate_control_list[i].gate_states;
+        offset += config->gate_control_list[i].time_interval;
+    }
+    if (offset != config->cycle_time) {
+        intel_hal_set_error("Gate control intervals sum to %llu ns but cycle time is %llu ns",
+                            (unsigned long long)offset, (unsigned long long)config->cycle_time);
+        return INTEL_HAL_ERROR_INVALID_PARAM;
+    }
+    index->base_time = config->base_time;
+    index->cycle_time = config->cycle_time;
+    index->entry_count = config->gate_control_list_length;
+
+    for (tc = 0; tc < 8; tc++) {
+        uint32_t count = collect_windows(config, (uint8_t)(1u << tc), starts, lengths);
+        index->window_count[tc] = count;
+        for (i = 0; i < count; i++) {
+            index->window_start[tc][i] = (int64_t)starts[i];
+            index->window_end[tc][i] = starts[i] + lengths[i];  /* Wrapped first start cancels out */
+        }
+    }
+
+    return INTEL_HAL_SUCCESS;
+}
+
+intel_hal_result_t intel_hal_tas_index_query(const intel_tas_index_t *index, uint64_t phc_time,
+                                             uint8_t traffic_class, intel_tas_gate_info_t *info)
+{
+    const uint64_t *ends;
+    uint64_t time;
+    uint64_t offset;
+    uint64_t cycle_start;
+    int64_t start;
+    uint32_t count;
+    uint32_t low;
+    uint32_t high;
+
+    if (!index || !info || traffic_class > 7 || index->entry_count == 0 || index->cycle_time == 0) {
+        intel_hal_set_error("Invalid parameters for TAS index query");
+        return INTEL_HAL_ERROR_INVALID_PARAM;
+    }
+
+    memset(info, 0, sizeof(*info));
+    time = phc_time > index->base_time ? phc_time : index->base_time;
+    offset = (time - index->base_time) % index->cycle_time;
+    cycle_start = time - offset;
+
+    /* Last entry starting at or before the offset */
+    low = 0;
+    high = index->entry_count;
+    while (high - low > 1) {
+        uint32_t mid = (low + high) / 2;
+        if (index->entry_start[mid] <= offset) {
+            low = mid;
+        } else {
+            high = mid;
+        }
+    }
+    info->entry = low;
+    info->gate_states = index->gate_states[low];
+    info->cycle_start = cycle_start;
+    info->cycle_offset = offset;
+
+    count = index->window_count[traffic_class];
+    if (count == 0) {
+        return INTEL_HAL_SUCCESS;
+    }
+
+    /* First window ending after the offset, else the first one of the next cycle */
+    ends = index->window_end[traffic_class];
+    low = 0;
+    high = count;
+    while (low < high) {
+        uint32_t mid = (low + high) / 2;
+        if (ends[mid] <= offset) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    if (low == count) {
+        low = 0;
+        cycle_start += index->cycle_time;
+    }
+    start = index->window_start[traffic_class][low];
+    if (start < 0 && cycle_start - index->base_time < (uint64_t)-start) {
+        info->window_start = index->base_time;  /* Wrapped window before the schedule started */
+    } else {
+        info->window_start = cycle_start + (uint64_t)start;
+    }
+    info->window_end = cycle_start + ends[low];
+    info->open = info->window_start <= time;
+
+    return INTEL_HAL_SUCCESS;
+}
@@ -0,0 +1,341 @@
+/******************************************************************************
+
+  Copyright (c) 2025, Intel Corporation
+  All rights reserved.
+
+  Intel Ethernet HAL - Launch-time Transmit Scheduler
+
+  Holds timed packets in a timing wheel keyed by launch time and hands each
+  one to its hardware queue a lead time before it is due, so the shallow
+  FIFO launch queues only ever contain the next few frames. Submission is
+  O(1) and in any order; pool buffers are held without copying. Releases
+  are driven by one PHC-time scheduler callback armed at the earliest
+  pending release; each batch is sorted by launch time and clamped so
+  launch times never go backwards within a hardware queue.
+
+******************************************************************************/
+
+#include "../include/intel_ethernet_hal.h"
+#include "../intel_hal_private.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define LAUNCH_GRANULARITY_SHIFT    10          /* ~1 us wheel ticks */
+#define LAUNCH_NO_SLOT              UINT32_MAX
+#define LAUNCH_QUEUES               4
+
+typedef struct launch_slot {
+    intel_timer_node_t node;            /* Keyed by launch time; must be first */
+    uint8_t queue;
+    uint32_t length;
+    uint32_t next_free;
+    intel_hal_packet_pool_t *pool;      /* Owner of buffer, NULL for copied frames */
+    void *buffer;
+    struct launch_slot *next_run;       /* Released batch, in launch time order */
+} launch_slot_t;
+
+struct intel_launch {
+    intel_hal_mutex_t lock;
+    intel_timer_wheel_t wheel;
+    launch_slot_t *slots;
+    uint8_t *data;                      /* max_packets x INTEL_HAL_LAUNCH_MAX_FRAME */
+    uint32_t max_packets;
+    uint32_t free_head;
+    uint32_t lead_ns;
+    uint64_t armed_release;             /* Release time of the armed callback (UINT64_MAX if none) */
+    intel_hal_schedule_id_t armed_id;
+    uint64_t last_launch[LAUNCH_QUEUES];
+    intel_hal_launch_stats_t stats;
+};
+
+static void release_callback(intel_device_t *device, uint64_t phc_time, void *arg);
+
+/**
+ * @brief Arm the release callback for the earliest pending packet (lock held)
+ */
+static void arm(intel_device_t *device, struct intel_launch *launch)
+{
+    uint64_t next_launch;
+    uint64_t release;
+
+    if (!intel_timer_wheel_next_expiry(&launch->wheel, &next_launch)) {
+        return;
+    }
+    release = next_launch > launch->lead_ns ? next_launch - launch->lead_ns : 0;
+    if (release >= launch->armed_release) {
+        return;
+    }
+
+    if (launch->armed_id != INTEL_HAL_SCHEDULE_INVALID_ID) {
+        intel_hal_schedule_cancel(device, launch->armed_id);
+    }
+    launch->armed_id = INTEL_HAL_SCHEDULE_INVALID_ID;
+    launch->armed_release = UINT64_MAX;
+    if (intel_hal_schedule_at(device, release, release_callback, launch, &launch->armed_id) == INTEL_HAL_SUCCESS) {
+        launch->armed_release = release;
+    }
+}
+
+static void release_callback(intel_device_t *device, uint64_t phc_time, void *arg)
+{
+    struct intel_launch *launch = (struct intel_launch *)arg;
+    intel_timer_node_t expired;
+    intel_timer_node_t *node;
+    launch_slot_t *batch = NULL;
+
+    expired.next = expired.prev = &expired;
+
+    intel_hal_mutex_lock(&launch->lock);
+    launch->armed_id = INTEL_HAL_SCHEDULE_INVALID_ID;
+    launch->armed_release = UINT64_MAX;
+    intel_timer_wheel_advance(&launch->wheel, phc_time + launch->lead_ns, &expired);
+    intel_hal_mutex_unlock(&launch->lock);
+
+    /* Wheel slots are ~1 us wide; order the batch exactly by launch time */
+    node = expired.next;
+    while (node != &expired) {
+        launch_slot_t *slot = (launch_slot_t *)node;
+        launch_slot_t **link = &batch;
+
+        node = node->next;
+        while (*link && (*link)->node.expires <= slot->node.expires) {
+            link = &(*link)->next_run;
+        }
+        slot->next_run = *link;
+        *link = slot;
+    }
+
+    while (batch) {
+        launch_slot_t *slot = batch;
+        intel_timed_packet_t packet;
+        intel_timestamp_t ts;
+        uint64_t now;
+        bool clamped;
+        bool late;
+        bool sent;
+
+        batch = slot->next_run;
+
+        packet.packet_data = slot->buffer;
+        packet.packet_length = slot->length;
+        packet.launch_time = slot->node.expires;
+        packet.queue = slot->queue;
+        /* Launch queues are FIFO: never go back in time within one */
+        clamped = packet.launch_time < launch->last_launch[slot->queue];
+        if (clamped) {
+            packet.launch_time = launch->last_launch[slot->queue];
+        }
+        launch->last_launch[slot->queue] = packet.launch_time;
+
+        /* phc_time is the release deadline; lateness is judged against the PHC at hand-off */
+        now = phc_time;
+        if (intel_hal_read_timestamp_unchecked(device, &ts) == INTEL_HAL_SUCCESS) {
+            now = ts.seconds * 1000000000ULL + ts.nanoseconds;
+        }
+        late = packet.launch_time < now;
+
+        sent = intel_hal_xmit_timed_packet(device, &packet) == INTEL_HAL_SUCCESS;
+        if (slot->pool) {
+            intel_packet_pool_release(slot->pool, slot->buffer);
+        }
+
+        intel_hal_mutex_lock(&launch->lock);
+        launch->stats.clamped += clamped;
+        launch->stats.late += late;
+        if (sent) {
+            launch->stats.released++;
+        } else {
+            launch->stats.failed++;
+        }
+        launch->stats.pending--;
+        slot->next_free = launch->free_head;
+        launch->free_head = (uint32_t)(slot - launch->slots);
+        intel_hal_mutex_unlock(&launch->lock);
+    }
+
+    intel_hal_mutex_lock(&launch->lock);
+    arm(device, launch);
+    intel_hal_mutex_unlock(&launch->lock);
+}
+
+void intel_launch_destroy(struct intel_launch *launch)
+{
+    if (!launch) {
+        return;
+    }
+
+    /* The device scheduler is already stopped; no callback can be running */
+    intel_hal_mutex_destroy(&launch->lock);
+    free(launch->slots);
+    free(launch->data);
+    free(launch);
+}
+
+void intel_hal_launch_config_init(intel_hal_launch_config_t *config)
+{
+    if (!config) {
+        return;
+    }
+
+    memset(config, 0, sizeof(*config));
+    config->lead_ns = INTEL_HAL_LAUNCH_DEFAULT_LEAD;
+    config->max_packets = INTEL_HAL_LAUNCH_DEFAULT_SIZE;
+}
+
+static intel_hal_result_t launch_create(intel_device_t *device, const intel_hal_launch_config_t *config,
+                                        struct intel_launch **out)
+{
+    struct intel_launch *launch;
+    intel_timestamp_t now;
+    uint32_t i;
+
+    if (intel_hal_read_timestamp_unchecked(device, &now) != INTEL_HAL_SUCCESS) {
+        intel_hal_set_error("Cannot read PHC for launch scheduler");
+        return INTEL_HAL_ERROR_HARDWARE;
+    }
+
+    launch = (struct intel_launch *)calloc(1, sizeof(*launch));
+    if (!launch) {
+        intel_hal_set_error("Out of memory creating launch scheduler");
+        return INTEL_HAL_ERROR_NO_MEMORY;
+    }
+    launch->lead_ns = config->lead_ns ? config->lead_ns : INTEL_HAL_LAUNCH_DEFAULT_LEAD;
+    launch->max_packets = config->max_packets ? config->max_packets : INTEL_HAL_LAUNCH_DEFAULT_SIZE;
+    launch->armed_release = UINT64_MAX;
+    intel_hal_mutex_init(&launch->lock);
+
+    launch->slots = (launch_slot_t *)calloc(launch->max_packets, sizeof(launch_slot_t));
+    launch->data = (uint8_t *)malloc((size_t)launch->max_packets * INTEL_HAL_LAUNCH_MAX_FRAME);
+    if (!launch->slots || !launch->data) {
+        intel_hal_set_error("Out of memory creating launch scheduler");
+        intel_launch_destroy(launch);
+        return INTEL_HAL_ERROR_NO_MEMORY;
+    }
+    for (i = 0; i < launch->max_packets; i++) {
+        launch->slots[i].next_free = i + 1 < launch->max_packets ? i + 1 : LAUNCH_NO_SLOT;
+    }
+    launch->free_head = 0;
+    intel_timer_wheel_init(&launch->wheel, now.seconds * 1000000000ULL + now.nanoseconds, LAUNCH_GRANULARITY_SHIFT);
+
+    *out = launch;
+    return INTEL_HAL_SUCCESS;
+}
+
+/**
+ * @brief Get the device launch scheduler, creating it if needed
+ */
+static intel_hal_result_t get_launch(intel_device_t *device, const intel_hal_launch_config_t *config,
+                                     bool exclusive, struct intel_launch **out)
+{
+    intel_hal_launch_config_t defaults;
+    struct intel_launch *launch;
+    intel_hal_result_t result;
+
+    launch = (struct intel_launch *)intel_atomic_load_ptr((void *const volatile *)&device->launch);
+    if (launch) {
+        *out = launch;
+        return exclusive ? INTEL_HAL_ERROR_DEVICE_BUSY : INTEL_HAL_SUCCESS;
+    }
+
+    if (!config) {
+        intel_hal_launch_config_init(&defaults);
+        config = &defaults;
+    }
+    result = launch_create(device, config, &launch);
+    if (result != INTEL_HAL_SUCCESS) {
+        return result;
+    }
+
+    /* Another thread may have started the launch scheduler concurrently */
+    if (!intel_atomic_cas_ptr((void *volatile *)&device->launch, NULL, launch)) {
+        intel_launch_destroy(launch);
+        *out = (struct intel_launch *)intel_atomic_load_ptr((void *const volatile *)&device->launch);
+        return exclusive ? INTEL_HAL_ERROR_DEVICE_BUSY : INTEL_HAL_SUCCESS;
+    }
+
+    *out = launch;
+    return INTEL_HAL_SUCCESS;
+}
+
+intel_hal_result_t intel_hal_launch_scheduler_start(intel_device_t *device, const intel_hal_launch_config_t *config)
+{
+    struct intel_launch *launch;
+
+    if (!device) {
+        intel_hal_set_error("Invalid device");
+        return INTEL_HAL_ERROR_INVALID_PARAM;
+    }
+
+    return get_launch(device, config, true, &launch);
+}
+
+intel_hal_result_t intel_hal_launch_submit(intel_device_t *device, const intel_timed_packet_t *packet)
+{
+    struct intel_launch *launch;
+    launch_slot_t *slot;
+    intel_hal_result_t result;
+    uint32_t index;
+
+    if (!device || !packet || !packet->packet_data || packet->packet_length == 0 ||
+        packet->packet_length > INTEL_HAL_LAUNCH_MAX_FRAME || packet->queue >= LAUNCH_QUEUES) {
+        intel_hal_set_error("Invalid parameters for launch-time submission");
+        return INTEL_HAL_ERROR_INVALID_PARAM;
+    }
+
+    result = get_launch(device, NULL, false, &launch);
+    if (result != INTEL_HAL_SUCCESS) {
+        return result;
+    }
+
+    intel_hal_mutex_lock(&launch->lock);
+    index = launch->free_head;
+    if (index == LAUNCH_NO_SLOT) {
+        launch->stats.rejected++;
+        intel_hal_mutex_unlock(&launch->lock);
+        intel_hal_set_error("Launch scheduler full (%u packets pending)", launch->max_packets);
+        return INTEL_HAL_ERROR_NO_MEMORY;
+    }
+    slot = &launch->slots[index];
+    launch->free_head = slot->next_free;
+
+    slot->pool = intel_packet_pool_hold(device, packet->packet_data);
+    if (slot->pool) {
+        slot->buffer = packet->packet_data;
+    } else {
+        slot->buffer = launch->data + (size_t)index * INTEL_HAL_LAUNCH_MAX_FRAME;
+        memcpy(slot->buffer, packet->packet_data, packet->packet_length);
+    }
+    slot->length = (uint32_t)packet->packet_length;
+    slot->queue = packet->queue;
+    slot->node.expires = packet->launch_time;
+    intel_timer_wheel_add(&launch->wheel, &slot->node);
+    launch->stats.submitted++;
+    launch->stats.pending++;
+
+    arm(device, launch);
+    intel_hal_mutex_unlock(&launch->lock);
+
+    return INTEL_HAL_SUCCESS;
+}
+
+intel_hal_result_t intel_hal_launch_get_stats(intel_device_t *device, intel_hal_launch_stats_t *stats)
+{
+    struct intel_launch *launch;
+
+    if (!device || !stats) {
+        intel_hal_set_error("Invalid parameters");
+        return INTEL_HAL_ERROR_INVALID_PARAM;
+    }
+
+    launch = (struct intel_launch *)intel_atomic_load_ptr((void *const volatile *)&device->launch);
+    if (!launch) {
+        memset(stats, 0, sizeof(*stats));
+        return INTEL_HAL_SUCCESS;
+    }
+
+    intel_hal_mutex_lock(&launch->lock);
+    *stats = launch->stats;
+    intel_hal_mutex_unlock(&launch->lock);
+    return INTEL_HAL_SUCCESS;
+}
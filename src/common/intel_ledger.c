@@ -0,0 +1,250 @@
+/******************************************************************************
+
+  Copyright (c) 2025, Intel Corporation
+  All rights reserved.
+
+  Intel Ethernet HAL - Port Bandwidth Ledger
+
+  Tracks the bandwidth claimed on a port per traffic class: bandwidth
+  allocation, CBS idle slope, rate limit and explicit stream reservations.
+  A class consumes the largest of its claims (a stream admitted into a CBS
+  budget does not count twice); the port is oversubscribed when the classes
+  together exceed the link capacity. Updates are serialized by a mutex and
+  checked before they take effect, with sums that cannot wrap; queries only
+  read atomics.
+
+******************************************************************************/
+
+#include "../include/intel_ethernet_hal.h"
+#include "../intel_hal_private.h"
+#include <string.h>
+
+static uint64_t effective_claim(const intel_bandwidth_ledger_t *ledger, uint8_t tc)
+{
+    uint64_t largest = 0;
+    uint32_t kind;
+
+    for (kind = 0; kind < INTEL_LEDGER_KINDS; kind++) {
+        if (ledger->claims[tc][kind] > largest) {
+            largest = ledger->claims[tc][kind];
+        }
+    }
+    return largest;
+}
+
+/**
+ * @brief Publish per-class and total commitments after a successful update
+ */
+static void publish(intel_bandwidth_ledger_t *ledger)
+{
+    uint64_t total = 0;
+    uint8_t tc;
+
+    for (tc = 0; tc < 8; tc++) {
+        uint64_t claim = effective_claim(ledger, tc);
+        intel_atomic_store_u64(&ledger->tc_bps[tc], claim);
+        total += claim;
+    }
+    intel_atomic_store_u64(&ledger->committed_bps, total);
+}
+
+static uint64_t add_saturated(uint64_t a, uint64_t b)
+{
+    return a > UINT64_MAX - b ? UINT64_MAX : a + b;
+}
+
+/**
+ * @brief Sum the class claims and check them against the capacity
+ *
+ * @return true if the claims exceed the capacity (or cannot be summed)
+ */
+static bool over_capacity(const intel_bandwidth_ledger_t *ledger, uint64_t *total)
+{
+    bool wrapped = false;
+    uint8_t tc;
+
+    *total = 0;
+    for (tc = 0; tc < 8; tc++) {
+        uint64_t claim = effective_claim(ledger, tc);
+        wrapped |= *total > UINT64_MAX - claim;
+        *total = add_saturated(*total, claim);
+    }
+    return wrapped || *total > ledger->capacity_bps;
+}
+
+static intel_hal_result_t oversubscribed(const intel_bandwidth_ledger_t *ledger, uint64_t total)
+{
+    intel_hal_set_error("Port oversubscribed: %llu bps claimed, capacity %llu bps",
+                        (unsigned long long)total, (unsigned long long)ledger->capacity_bps);
+    return INTEL_HAL_ERROR_NO_BANDWIDTH;
+}
+
+void intel_ledger_init(intel_device_t *device)
+{
+    intel_bandwidth_ledger_t *ledger = &device->ledger;
+
+    memset(ledger->claims, 0, sizeof(ledger->claims));
+    intel_hal_mutex_init(&ledger->lock);
+    ledger->capacity_bps = (device->info.capabilities & INTEL_CAP_2_5G) ? 2500000000ULL : 1000000000ULL;
+    publish(ledger);
+}
+
+void intel_ledger_destroy(intel_device_t *device)
+{
+    intel_hal_mutex_destroy(&device->ledger.lock);
+}
+
+intel_hal_result_t intel_ledger_claim(intel_device_t *device, uint8_t tc, uint32_t kind, uint64_t bps)
+{
+    intel_bandwidth_ledger_t *ledger = &device->ledger;
+    intel_hal_result_t result = INTEL_HAL_SUCCESS;
+    uint64_t previous;
+    uint64_t total;
+
+    intel_hal_mutex_lock(&ledger->lock);
+    previous = ledger->claims[tc][kind];
+    ledger->claims[tc][kind] = bps;
+    if (bps > previous && over_capacity(ledger, &total)) {
+        ledger->claims[tc][kind] = previous;    /* Reductions always succeed */
+        result = oversubscribed(ledger, total);
+    } else {
+        publish(ledger);
+    }
+    intel_hal_mutex_unlock(&ledger->lock);
+
+    return result;
+}
+
+intel_hal_result_t intel_ledger_load(intel_device_t *device, const intel_device_state_t *state)
+{
+    intel_bandwidth_ledger_t *ledger = &device->ledger;
+    uint64_t saved[8][INTEL_LEDGER_KINDS];
+    intel_hal_result_t result = INTEL_HAL_SUCCESS;
+    uint64_t total;
+    uint8_t tc;
+
+    intel_hal_mutex_lock(&ledger->lock);
+    memcpy(saved, ledger->claims, sizeof(saved));
+    for (tc = 0; tc < 8; tc++) {
+        ledger->claims[tc][INTEL_LEDGER_BANDWIDTH] = ledger->capacity_bps * state->bandwidth_percent[tc] / 100;
+        ledger->claims[tc][INTEL_LEDGER_CBS] = state->cbs[tc].enabled ? (uint64_t)state->cbs[tc].idle_slope * 8 : 0;
+        ledger->claims[tc][INTEL_LEDGER_RATE_LIMIT] = (uint64_t)state->rate_limit_mbps[tc] * 1000000ULL;
+    }
+    if (over_capacity(ledger, &total)) {
+        memcpy(ledger->claims, saved, sizeof(saved));
+        result = oversubscribed(ledger, total);
+    } else {
+        publish(ledger);
+    }
+    intel_hal_mutex_unlock(&ledger->lock);
+
+    return result;
+}
+
+intel_hal_result_t intel_hal_bandwidth_reserve(intel_device_t *device, uint8_t traffic_class, uint64_t bps)
+{
+    intel_bandwidth_ledger_t *ledger;
+    intel_hal_result_t result = INTEL_HAL_SUCCESS;
+    uint64_t previous;
+    uint64_t total;
+
+    if (!device || traffic_class > 7) {
+        intel_hal_set_error("Invalid parameters for bandwidth reservation");
+        return INTEL_HAL_ERROR_INVALID_PARAM;
+    }
+
+    ledger = &device->ledger;
+    intel_hal_mutex_lock(&ledger->lock);
+    previous = ledger->claims[traffic_class][INTEL_LEDGER_STREAMS];
+    if (bps > ledger->capacity_bps - previous) {
+        /* The class alone would exceed the port; checked first so the sum cannot wrap */
+        result = oversubscribed(ledger, add_saturated(ledger->committed_bps, bps));
+    } else {
+        ledger->claims[traffic_class][INTEL_LEDGER_STREAMS] = previous + bps;
+        if (over_capacity(ledger, &total)) {
+            ledger->claims[traffic_class][INTEL_LEDGER_STREAMS] = previous;
+            result = oversubscribed(ledger, total);
+        } else {
+            publish(ledger);
+        }
+    }
+    intel_hal_mutex_unlock(&ledger->lock);
+
+    return result;
+}
+
+intel_hal_result_t intel_hal_bandwidth_release(intel_device_t *device, uint8_t traffic_class, uint64_t bps)
+{
+    intel_bandwidth_ledger_t *ledger;
+    intel_hal_result_t result = INTEL_HAL_SUCCESS;
+
+    if (!device || traffic_class > 7) {
+        intel_hal_set_error("Invalid parameters for bandwidth release");
+        return INTEL_HAL_ERROR_INVALID_PARAM;
+    }
+
+    ledger = &device->ledger;
+    intel_hal_mutex_lock(&ledger->lock);
+    if (bps > ledger->claims[traffic_class][INTEL_LEDGER_STREAMS]) {
+        intel_hal_set_error("Releasing %llu bps on TC %u but only %llu bps reserved", (unsigned long long)bps,
+                            traffic_class, (unsigned long long)ledger->claims[traffic_class][INTEL_LEDGER_STREAMS]);
+        result = INTEL_HAL_ERROR_INVALID_PARAM;
+    } else {
+        ledger->claims[traffic_class][INTEL_LEDGER_STREAMS] -= bps;
+        publish(ledger);
+    }
+    intel_hal_mutex_unlock(&ledger->lock);
+
+    return result;
+}
+
+intel_hal_result_t intel_hal_bandwidth_set_capacity(intel_device_t *device, uint64_t capacity_bps)
+{
+    intel_bandwidth_ledger_t *ledger;
+    intel_hal_result_t result = INTEL_HAL_SUCCESS;
+
+    if (!device || capacity_bps == 0) {
+        intel_hal_set_error("Invalid parameters for bandwidth capacity");
+        return INTEL_HAL_ERROR_INVALID_PARAM;
+    }
+
+    ledger = &device->ledger;
+    intel_hal_mutex_lock(&ledger->lock);
+    if (capacity_bps < ledger->committed_bps) {
+        intel_hal_set_error("Capacity %llu bps is below the %llu bps already committed",
+                            (unsigned long long)capacity_bps, (unsigned long long)ledger->committed_bps);
+        result = INTEL_HAL_ERROR_DEVICE_BUSY;
+    } else {
+        intel_atomic_store_u64(&ledger->capacity_bps, capacity_bps);
+    }
+    intel_hal_mutex_unlock(&ledger->lock);
+
+    return result;
+}
+
+intel_hal_result_t intel_hal_bandwidth_get_headroom(intel_device_t *device, uint64_t *headroom_bps)
+{
+    uint64_t capacity;
+    uint64_t committed;
+
+    if (!device || !headroom_bps) {
+        intel_hal_set_error("Invalid parameters");
+        return INTEL_HAL_ERROR_INVALID_PARAM;
+    }
+
+    capacity = intel_atomic_load_u64(&device->ledger.capacity_bps);
+    committed = intel_atomic_load_u64(&device->ledger.committed_bps);
+    *headroom_bps = capacity > committed ? capacity - committed : 0;
+    return INTEL_HAL_SUCCESS;
+}
+
+intel_hal_result_t intel_hal_bandwidth_get_committed(intel_device_t *device, uint8_t traffic_class, uint64_t *committed_bps)
+{
+    if (!device || traffic_class > 7 || !committed_bps) {
+        intel_hal_set_error("Invalid parameters");
+        return INTEL_HAL_ERROR_INVALID_PARAM;
+    }
+
+    *committed_bps = intel_atomic_load_u64(&device->ledger.tc_bps[traffic_class]);
+    return INTEL_HAL_SUCCESS;
+}
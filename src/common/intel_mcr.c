@@ -0,0 +1,201 @@
+/******************************************************************************
+
+  Copyright (c) 2025, Intel Corporation
+  All rights reserved.
+
+  Intel Ethernet HAL - Media Clock Recovery
+
+  Listener-side recovery of a talker media clock from AVTP presentation
+  times or CRF timestamps. Each measurement pairs a media clock event count
+  with the gPTP time of that event; a second-order software PLL tracks the
+  event period and phase in PHC time. The 32-bit AVTP timestamp is
+  extended to 64 bits around the hardware receive timestamp of its frame.
+  Updates are O(1) and allocation free.
+
+******************************************************************************/
+
+#include "../include/intel_ethernet_hal.h"
+#include "../intel_hal_private.h"
+#include <math.h>
+#include <string.h>
+
+#define MCR_PI                      3.14159265358979323846
+#define MCR_ACQUIRE_PPM             1000.0      /* Largest offset accepted for the initial period estimate */
+#define MCR_LOCK_COUNT              8           /* Consecutive in-threshold updates to declare lock */
+
+void intel_hal_mcr_config_init(intel_mcr_config_t *config)
+{
+    if (!config) {
+        return;
+    }
+
+    memset(config, 0, sizeof(*config));
+    config->nominal_rate_hz = 48000.0;
+    config->bandwidth_hz = INTEL_MCR_DEFAULT_BANDWIDTH;
+    config->damping = 0.707;
+    config->lock_threshold_ns = INTEL_MCR_DEFAULT_LOCK_THRESHOLD;
+    config->reset_threshold_ns = INTEL_MCR_DEFAULT_RESET_THRESHOLD;
+}
+
+intel_hal_result_t intel_hal_mcr_init(intel_mcr_t *mcr, const intel_mcr_config_t *config)
+{
+    if (!mcr || !config || config->nominal_rate_hz <= 0.0 || config->bandwidth_hz <= 0.0 || config->damping <= 0.0) {
+        intel_hal_set_error("Invalid parameters for media clock recovery");
+        return INTEL_HAL_ERROR_INVALID_PARAM;
+    }
+
+    memset(mcr, 0, sizeof(*mcr));
+    mcr->config = *config;
+    mcr->nominal_period_ns = 1e9 / config->nominal_rate_hz;
+    mcr->period_ns = mcr->nominal_period_ns;
+    return INTEL_HAL_SUCCESS;
+}
+
+/**
+ * @brief Restart tracking from one measurement (period kept if plausible)
+ */
+static void mcr_restart(intel_mcr_t *mcr, uint64_t event_time_ns)
+{
+    mcr->last_event_ns = event_time_ns;
+    mcr->last_event_frac = 0.0;
+    mcr->phase_error_ns = 0;
+    mcr->in_lock = 0;
+    mcr->state = INTEL_MCR_ACQUIRING;
+}
+
+/**
+ * @brief Advance the PLL by event_delta events measured at event_time_ns
+ */
+static void mcr_update(intel_mcr_t *mcr, uint32_t event_delta, uint64_t event_time_ns)
+{
+    const intel_mcr_config_t *config = &mcr->config;
+    double interval_s;
+    double wn;
+    double predicted;
+    double error;
+
+    mcr->updates++;
+
+    if (mcr->state == INTEL_MCR_IDLE || event_delta == 0) {
+        mcr_restart(mcr, event_time_ns);
+        return;
+    }
+
+    /* Second measurement: take the period straight from the two points */
+    if (mcr->state == INTEL_MCR_ACQUIRING && mcr->updates == 2) {
+        double measured = (double)(int64_t)(event_time_ns - mcr->last_event_ns) / event_delta;
+        if (fabs(measured / mcr->nominal_period_ns - 1.0) * 1e6 < MCR_ACQUIRE_PPM) {
+            mcr->period_ns = measured;
+        }
+    }
+
+    predicted = mcr->last_event_frac + event_delta * mcr->period_ns;
+    error = (double)(int64_t)(event_time_ns - mcr->last_event_ns) - predicted;
+
+    if (fabs(error) > config->reset_threshold_ns) {
+        mcr->resets++;
+        mcr->period_ns = mcr->nominal_period_ns;
+        mcr->updates = 1;
+        mcr_restart(mcr, event_time_ns);
+        return;
+    }
+
+    /* PI loop: proportional term corrects the phase, integral term the period */
+    interval_s = event_delta * mcr->period_ns * 1e-9;
+    wn = 2.0 * MCR_PI * config->bandwidth_hz;
+    predicted += 2.0 * config->damping * wn * interval_s * error;
+    mcr->period_ns += wn * wn * interval_s * interval_s * error / event_delta;
+
+    /* Keep the predicted event time as integer nanoseconds plus a fraction */
+    mcr->last_event_ns += (uint64_t)(int64_t)floor(predicted);
+    mcr->last_event_frac = predicted - floor(predicted);
+    mcr->phase_error_ns = (int64_t)error;
+
+    if (fabs(error) <= config->lock_threshold_ns) {
+        if (mcr->in_lock < MCR_LOCK_COUNT) {
+            mcr->in_lock++;
+        }
+    } else {
+        mcr->in_lock = 0;
+    }
+    mcr->state = mcr->in_lock >= MCR_LOCK_COUNT ? INTEL_MCR_LOCKED : INTEL_MCR_ACQUIRING;
+}
+
+intel_hal_result_t intel_hal_mcr_feed_avtp(intel_mcr_t *mcr, uint32_t avtp_timestamp, uint64_t rx_time_ns,
+                                           uint32_t event_delta)
+{
+    uint64_t presentation;
+
+    if (!mcr) {
+        intel_hal_set_error("Invalid parameters");
+        return INTEL_HAL_ERROR_INVALID_PARAM;
+    }
+
+    /* Presentation time is within 2^31 ns of reception */
+    presentation = (rx_time_ns & ~0xFFFFFFFFULL) | avtp_timestamp;
+    if (presentation + 0x80000000ULL < rx_time_ns) {
+        presentation += 0x100000000ULL;
+    } else if (presentation > rx_time_ns + 0x80000000ULL && presentation >= 0x100000000ULL) {
+        presentation -= 0x100000000ULL;
+    }
+    if (presentation < rx_time_ns) {
+        mcr->late++;
+    }
+
+    mcr_update(mcr, event_delta, presentation);
+    return INTEL_HAL_SUCCESS;
+}
+
+intel_hal_result_t intel_hal_mcr_feed_crf(intel_mcr_t *mcr, const uint64_t *timestamps, uint32_t count,
+                                          uint32_t timestamp_interval, uint64_t rx_time_ns)
+{
+    uint32_t i;
+
+    if (!mcr || !timestamps || count == 0 || timestamp_interval == 0) {
+        intel_hal_set_error("Invalid parameters");
+        return INTEL_HAL_ERROR_INVALID_PARAM;
+    }
+
+    if (timestamps[count - 1] < rx_time_ns) {
+        mcr->late++;
+    }
+
+    /* Count the intervals since the last timestamp, bridging lost PDUs */
+    for (i = 0; i < count; i++) {
+        int64_t elapsed = (int64_t)(timestamps[i] - mcr->last_event_ns);
+        int64_t intervals = llround((double)elapsed / (mcr->period_ns * timestamp_interval));
+        if (mcr->state == INTEL_MCR_IDLE || intervals < 1 || intervals > UINT32_MAX / timestamp_interval) {
+            intervals = 1;
+        }
+        mcr_update(mcr, (uint32_t)(intervals * timestamp_interval), timestamps[i]);
+    }
+    return INTEL_HAL_SUCCESS;
+}
+
+intel_hal_result_t intel_hal_mcr_get_state(const intel_mcr_t *mcr, intel_mcr_state_t *state)
+{
+    if (!mcr || !state) {
+        intel_hal_set_error("Invalid parameters");
+        return INTEL_HAL_ERROR_INVALID_PARAM;
+    }
+
+    memset(state, 0, sizeof(*state));
+    state->state = mcr->state;
+    state->rate_hz = 1e9 / mcr->period_ns;
+    state->rate_ratio = mcr->nominal_period_ns / mcr->period_ns;
+    state->phase_error_ns = mcr->phase_error_ns;
+    state->last_event_ns = mcr->last_event_ns;
+    state->updates = mcr->updates;
+    state->resets = mcr->resets;
+    state->late = mcr->late;
+    return INTEL_HAL_SUCCESS;
+}
+
+uint64_t intel_hal_mcr_event_time(const intel_mcr_t *mcr, int64_t events_ahead)
+{
+    if (!mcr) {
+        return 0;
+    }
+
+    return mcr->last_event_ns + (uint64_t)(int64_t)llround(mcr->last_event_frac + events_ahead * mcr->period_ns);
+}
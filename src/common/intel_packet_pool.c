@@ -0,0 +1,388 @@
+/******************************************************************************
+
+  Copyright (c) 2025, Intel Corporation
+  All rights reserved.
+
+  Intel Ethernet HAL - Packet Buffer Pool
+
+  Fixed-size, cache-line aligned transmit buffers carved from one hugepage
+  mapping (regular pages if none are available). Free buffers sit on a
+  lock-free stack of buffer indices whose head carries a generation tag
+  against ABA. In front of it, per-thread caches absorb most allocations
+  and frees: each thread is bound to one cache shard, guarded by a
+  try-lock so a contended shard falls through to the shared stack instead
+  of blocking; once the stack is empty, buffers are taken from other
+  threads' caches. Pools are registered on their device so the transmit
+  paths can recognize pool buffers and take them without copying; buffers
+  so held are counted, and a pool is not destroyed while any are out.
+
+******************************************************************************/
+
+#include "../include/intel_ethernet_hal.h"
+#include "../intel_hal_private.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef INTEL_HAL_LINUX
+#include <sys/mman.h>
+#endif
+
+#ifdef _MSC_VER
+#define POOL_THREAD_LOCAL           __declspec(thread)
+#else
+#define POOL_THREAD_LOCAL           _Thread_local
+#endif
+
+#define POOL_CACHE_LINE             64
+#define POOL_HUGEPAGE_SIZE          (2u * 1024u * 1024u)
+#define POOL_SHARDS                 16
+#define POOL_SHARD_DEPTH            64          /* Buffers a thread cache holds */
+#define POOL_SHARD_BATCH            32          /* Buffers moved to or from the shared stack at once */
+#define POOL_NONE                   UINT32_MAX
+
+typedef struct {
+    volatile uint32_t busy;             /* Try-lock */
+    uint32_t count;
+    uint32_t index[POOL_SHARD_DEPTH];
+    uint8_t pad[POOL_CACHE_LINE - 8];   /* Keep shards on separate cache lines */
+} pool_shard_t;
+
+struct intel_hal_packet_pool {
+    intel_device_t *device;
+    uint8_t *memory;
+    size_t map_size;
+    bool hugepages;
+    uint32_t count;
+    uint32_t buffer_size;
+    uint32_t stride;
+    volatile uint64_t head;             /* Generation << 32 | top index */
+    volatile uint32_t *next;            /* Free stack links by buffer index */
+    volatile uint64_t shared_free;      /* Buffers on the shared stack */
+    volatile uint64_t held;             /* Buffers owned by the launch scheduler */
+    pool_shard_t shards[POOL_SHARDS];
+};
+
+/* Cache shard of the calling thread, assigned on first use */
+static POOL_THREAD_LOCAL uint32_t thread_shard = POOL_NONE;
+static volatile uint64_t next_shard;
+
+static pool_shard_t *shard_for_thread(intel_hal_packet_pool_t *pool)
+{
+    if (thread_shard == POOL_NONE) {
+        thread_shard = (uint32_t)(intel_atomic_fetch_add_u64(&next_shard, 1) % POOL_SHARDS);
+    }
+    return &pool->shards[thread_shard];
+}
+
+static uint32_t stack_pop(intel_hal_packet_pool_t *pool)
+{
+    uint64_t head;
+    uint32_t top;
+
+    do {
+        head = intel_atomic_load_u64(&pool->head);
+        top = (uint32_t)head;
+        if (top == POOL_NONE) {
+            return POOL_NONE;
+        }
+    } while (!intel_atomic_cas_u64(&pool->head, head,
+                                   ((head >> 32) + 1) << 32 | intel_atomic_load_u32(&pool->next[top])));
+
+    intel_atomic_fetch_add_u64(&pool->shared_free, (uint64_t)-1);
+    return top;
+}
+
+static void stack_push(intel_hal_packet_pool_t *pool, uint32_t index)
+{
+    uint64_t head;
+
+    do {
+        head = intel_atomic_load_u64(&pool->head);
+        intel_atomic_store_u32(&pool->next[index], (uint32_t)head);
+    } while (!intel_atomic_cas_u64(&pool->head, head, ((head >> 32) + 1) << 32 | index));
+
+    intel_atomic_fetch_add_u64(&pool->shared_free, 1);
+}
+
+/**
+ * @brief Map the buffer memory, preferring explicit hugepages
+ */
+static void *map_memory(size_t size, size_t *map_size, bool *hugepages)
+{
+    void *memory;
+
+#ifdef INTEL_HAL_WINDOWS
+    SIZE_T large = GetLargePageMinimum();
+
+    if (large > 0) {
+        *map_size = (size + large - 1) & ~(large - 1);
+        memory = VirtualAlloc(NULL, *map_size, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+        if (memory) {
+            *hugepages = true;
+            return memory;
+        }
+    }
+    *hugepages = false;
+    *map_size = size;
+    return VirtualAlloc(NULL, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+#else
+    *map_size = (size + POOL_HUGEPAGE_SIZE - 1) & ~(size_t)(POOL_HUGEPAGE_SIZE - 1);
+    memory = mmap(NULL, *map_size, PROT_READ | PROT_WRITE,
+                  MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | MAP_POPULATE, -1, 0);
+    if (memory != MAP_FAILED) {
+        *hugepages = true;
+        return memory;
+    }
+
+    /* No reserved hugepages: regular pages, transparent hugepages if enabled */
+    *hugepages = false;
+    memory = mmap(NULL, *map_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED) {
+        return NULL;
+    }
+    madvise(memory, *map_size, MADV_HUGEPAGE);
+    memset(memory, 0, *map_size);       /* Fault the pages in now, not on the transmit path */
+    return memory;
+#endif
+}
+
+static void unmap_memory(void *memory, size_t map_size)
+{
+#ifdef INTEL_HAL_WINDOWS
+    (void)map_size;
+    VirtualFree(memory, 0, MEM_RELEASE);
+#else
+    munmap(memory, map_size);
+#endif
+}
+
+static void pool_free_memory(intel_hal_packet_pool_t *pool)
+{
+    if (pool->memory) {
+        unmap_memory(pool->memory, pool->map_size);
+    }
+    free((void *)pool->next);
+    free(pool);
+}
+
+intel_hal_result_t intel_hal_packet_pool_create(intel_device_t *device, uint32_t count, uint32_t size,
+                                                intel_hal_packet_pool_t **pool_out)
+{
+    intel_hal_packet_pool_t *pool;
+    uint32_t slot;
+    uint32_t i;
+
+    if (!device || !pool_out || count == 0 || count >= POOL_NONE || size == 0 || size > INTEL_HAL_PACKET_POOL_MAX_SIZE) {
+        intel_hal_set_error("Invalid parameters for packet pool");
+        return INTEL_HAL_ERROR_INVALID_PARAM;
+    }
+
+    pool = (intel_hal_packet_pool_t *)calloc(1, sizeof(*pool));
+    if (!pool) {
+        intel_hal_set_error("Out of memory creating packet pool");
+        return INTEL_HAL_ERROR_NO_MEMORY;
+    }
+    pool->device = device;
+    pool->count = count;
+    pool->buffer_size = size;
+    pool->stride = (size + POOL_CACHE_LINE - 1) & ~(uint32_t)(POOL_CACHE_LINE - 1);
+
+    pool->next = (volatile uint32_t *)malloc(count * sizeof(uint32_t));
+    pool->memory = (uint8_t *)map_memory((size_t)count * pool->stride, &pool->map_size, &pool->hugepages);
+    if (!pool->next || !pool->memory) {
+        intel_hal_set_error("Cannot allocate %llu bytes of packet buffers",
+                            (unsigned long long)count * pool->stride);
+        pool_free_memory(pool);
+        return INTEL_HAL_ERROR_NO_MEMORY;
+    }
+
+    /* All buffers start on the shared stack, lowest address on top */
+    for (i = 0; i < count; i++) {
+        pool->next[i] = i + 1 < count ? i + 1 : POOL_NONE;
+    }
+    pool->head = 0;
+    pool->shared_free = count;
+
+    for (slot = 0; slot < INTEL_HAL_MAX_PACKET_POOLS; slot++) {
+        if (intel_atomic_cas_ptr((void *volatile *)&device->packet_pools[slot], NULL, pool)) {
+            *pool_out = pool;
+            return INTEL_HAL_SUCCESS;
+        }
+    }
+
+    pool_free_memory(pool);
+    intel_hal_set_error("Device already has %u packet pools", INTEL_HAL_MAX_PACKET_POOLS);
+    return INTEL_HAL_ERROR_NO_MEMORY;
+}
+
+intel_hal_result_t intel_hal_packet_pool_destroy(intel_hal_packet_pool_t *pool)
+{
+    uint32_t slot;
+
+    if (!pool) {
+        intel_hal_set_error("Invalid parameters");
+        return INTEL_HAL_ERROR_INVALID_PARAM;
+    }
+    if (intel_atomic_load_u64(&pool->held) > 0) {
+        intel_hal_set_error("%llu packet pool buffers are still queued for transmission",
+                            (unsigned long long)intel_atomic_load_u64(&pool->held));
+        return INTEL_HAL_ERROR_DEVICE_BUSY;
+    }
+
+    for (slot = 0; slot < INTEL_HAL_MAX_PACKET_POOLS; slot++) {
+        if (intel_atomic_cas_ptr((void *volatile *)&pool->device->packet_pools[slot], pool, NULL)) {
+            break;
+        }
+    }
+    pool_free_memory(pool);
+    return INTEL_HAL_SUCCESS;
+}
+
+void intel_packet_pools_destroy(intel_device_t *device)
+{
+    uint32_t slot;
+
+    for (slot = 0; slot < INTEL_HAL_MAX_PACKET_POOLS; slot++) {
+        if (device->packet_pools[slot]) {
+            pool_free_memory(device->packet_pools[slot]);
+            device->packet_pools[slot] = NULL;
+        }
+    }
+}
+
+intel_hal_packet_pool_t *intel_packet_pool_hold(intel_device_t *device, const void *buffer)
+{
+    const uint8_t *address = (const uint8_t *)buffer;
+    uint32_t slot;
+
+    for (slot = 0; slot < INTEL_HAL_MAX_PACKET_POOLS; slot++) {
+        intel_hal_packet_pool_t *pool =
+            (intel_hal_packet_pool_t *)intel_atomic_load_ptr((void *const volatile *)&device->packet_pools[slot]);
+        if (pool && address >= pool->memory && address < pool->memory + (size_t)pool->count * pool->stride) {
+            intel_atomic_fetch_add_u64(&pool->held, 1);
+            return pool;
+        }
+    }
+    return NULL;
+}
+
+void intel_packet_pool_release(intel_hal_packet_pool_t *pool, void *buffer)
+{
+    intel_hal_packet_free(pool, buffer);
+    intel_atomic_fetch_add_u64(&pool->held, (uint64_t)-1);  /* Last access: destroy may follow */
+}
+
+/**
+ * @brief Take a buffer cached by another thread once the shared stack is empty
+ */
+static uint32_t steal(intel_hal_packet_pool_t *pool)
+{
+    uint32_t index = POOL_NONE;
+    uint32_t i;
+
+    for (i = 0; i < POOL_SHARDS && index == POOL_NONE; i++) {
+        pool_shard_t *shard = &pool->shards[i];
+
+        if (intel_atomic_load_u32((const volatile uint32_t *)&shard->count) == 0 ||
+            !intel_atomic_cas_u32(&shard->busy, 0, 1)) {
+            continue;
+        }
+        if (shard->count > 0) {
+            index = shard->index[--shard->count];
+        }
+        intel_atomic_store_u32(&shard->busy, 0);
+    }
+    return index;
+}
+
+void *intel_hal_packet_alloc(intel_hal_packet_pool_t *pool)
+{
+    pool_shard_t *shard;
+    uint32_t index = POOL_NONE;
+
+    if (!pool) {
+        return NULL;
+    }
+
+    shard = shard_for_thread(pool);
+    if (intel_atomic_cas_u32(&shard->busy, 0, 1)) {
+        if (shard->count == 0) {
+            /* Refill a batch from the shared stack */
+            while (shard->count < POOL_SHARD_BATCH) {
+                uint32_t refill = stack_pop(pool);
+                if (refill == POOL_NONE) {
+                    break;
+                }
+                shard->index[shard->count++] = refill;
+            }
+        }
+        if (shard->count > 0) {
+            index = shard->index[--shard->count];
+        }
+        intel_atomic_store_u32(&shard->busy, 0);
+    }
+
+    if (index == POOL_NONE) {
+        index = stack_pop(pool);    /* Shard contended or empty */
+    }
+    if (index == POOL_NONE) {
+        index = steal(pool);
+        if (index == POOL_NONE) {
+            return NULL;
+        }
+    }
+    return pool->memory + (size_t)index * pool->stride;
+}
+
+void intel_hal_packet_free(intel_hal_packet_pool_t *pool, void *buffer)
+{
+    pool_shard_t *shard;
+    size_t offset;
+    uint32_t index;
+
+    if (!pool || !buffer) {
+        return;
+    }
+
+    offset = (size_t)((uint8_t *)buffer - pool->memory);
+    index = (uint32_t)(offset / pool->stride);
+
+    shard = shard_for_thread(pool);
+    if (intel_atomic_cas_u32(&shard->busy, 0, 1)) {
+        if (shard->count == POOL_SHARD_DEPTH) {
+            /* Return a batch so other threads can use it */
+            while (shard->count > POOL_SHARD_DEPTH - POOL_SHARD_BATCH) {
+                stack_push(pool, shard->index[--shard->count]);
+            }
+        }
+        shard->index[shard->count++] = index;
+        intel_atomic_store_u32(&shard->busy, 0);
+        return;
+    }
+
+    stack_push(pool, index);
+}
+
+intel_hal_result_t intel_hal_packet_pool_get_info(intel_hal_packet_pool_t *pool, intel_hal_packet_pool_info_t *info)
+{
+    uint32_t cached = 0;
+    uint32_t i;
+
+    if (!pool || !info) {
+        intel_hal_set_error("Invalid parameters");
+        return INTEL_HAL_ERROR_INVALID_PARAM;
+    }
+
+    for (i = 0; i < POOL_SHARDS; i++) {
+        cached += intel_atomic_load_u32((const volatile uint32_t *)&pool->shards[i].count);
+    }
+
+    memset(info, 0, sizeof(*info));
+    info->buffer_count = pool->count;
+    info->buffer_size = pool->buffer_size;
+    info->buffer_stride = pool->stride;
+    info->free_buffers = (uint32_t)intel_atomic_load_u64(&pool->shared_free) + cached;
+    info->hugepages = pool->hugepages;
+    return INTEL_HAL_SUCCESS;
+}
@@ -0,0 +1,235 @@
+/******************************************************************************
+
+  Copyright (c) 2025, Intel Corporation
+  All rights reserved.
+
+  Intel Ethernet HAL - Open Device Registry
+
+  Maps interface index and PCI address to open device handles in O(1)
+  using two open-addressing hash tables that grow with the number of open
+  devices, so hosts with many ports of the same device ID can address each
+  instance directly.
+
+******************************************************************************/
+
+#include "../include/intel_ethernet_hal.h"
+#include "../intel_hal_private.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define REGISTRY_EMPTY          0ULL
+#define REGISTRY_TOMBSTONE      UINT64_MAX
+#define REGISTRY_MIN_CAPACITY   64
+
+typedef struct {
+    uint64_t key;
+    intel_device_t *device;
+} registry_slot_t;
+
+typedef struct {
+    registry_slot_t *slots;
+    uint32_t capacity;                  /* Power of two */
+    uint32_t used;                      /* Live entries plus tombstones */
+} registry_table_t;
+
+static intel_hal_mutex_t registry_lock;
+static volatile uint32_t registry_lock_state;   /* 0 = uninitialized, 1 = initializing, 2 = ready */
+static registry_table_t by_ifindex;
+static registry_table_t by_pci_address;
+
+static void registry_lock_acquire(void)
+{
+    if (intel_atomic_load_u32(&registry_lock_state) != 2) {
+        if (intel_atomic_cas_u32(&registry_lock_state, 0, 1)) {
+            intel_hal_mutex_init(&registry_lock);
+            intel_atomic_store_u32(&registry_lock_state, 2);
+        } else {
+            while (intel_atomic_load_u32(&registry_lock_state) != 2) {
+                /* Another thread is initializing the lock */
+            }
+        }
+    }
+    intel_hal_mutex_lock(&registry_lock);
+}
+
+static uint32_t hash_key(uint64_t key)
+{
+    /* 64-bit finalizer (splitmix64) */
+    key ^= key >> 30;
+    key *= 0xBF58476D1CE4E5B9ULL;
+    key ^= key >> 27;
+    key *= 0x94D049BB133111EBULL;
+    key ^= key >> 31;
+    return (uint32_t)key;
+}
+
+static registry_slot_t *table_find(const registry_table_t *table, uint64_t key)
+{
+    uint32_t mask;
+    uint32_t index;
+
+    if (!table->slots) {
+        return NULL;
+    }
+
+    mask = table->capacity - 1;
+    for (index = hash_key(key) & mask; table->slots[index].key != REGISTRY_EMPTY; index = (index + 1) & mask) {
+        if (table->slots[index].key == key) {
+            return &table->slots[index];
+        }
+    }
+    return NULL;
+}
+
+static bool table_resize(registry_table_t *table, uint32_t capacity)
+{
+    registry_slot_t *old_slots = table->slots;
+    uint32_t old_capacity = table->capacity;
+    uint32_t i;
+
+    table->slots = (registry_slot_t *)calloc(capacity, sizeof(registry_slot_t));
+    if (!table->slots) {
+        table->slots = old_slots;
+        return false;
+    }
+    table->capacity = capacity;
+    table->used = 0;
+
+    for (i = 0; i < old_capacity; i++) {
+        if (old_slots[i].key != REGISTRY_EMPTY && old_slots[i].key != REGISTRY_TOMBSTONE) {
+            uint32_t index = hash_key(old_slots[i].key) & (capacity - 1);
+            while (table->slots[index].key != REGISTRY_EMPTY) {
+                index = (index + 1) & (capacity - 1);
+            }
+            table->slots[index] = old_slots[i];
+            table->used++;
+        }
+    }
+    free(old_slots);
+    return true;
+}
+
+static bool table_insert(registry_table_t *table, uint64_t key, intel_device_t *device)
+{
+    registry_slot_t *slot = table_find(table, key);
+    uint32_t index;
+
+    if (slot) {
+        slot->device = device;
+        return true;
+    }
+
+    /* Keep the load (including tombstones) at or below one half */
+    if ((table->used + 1) * 2 > table->capacity) {
+        uint32_t capacity = table->capacity ? table->capacity : REGISTRY_MIN_CAPACITY;
+        while ((table->used + 1) * 2 > capacity) {
+            capacity *= 2;
+        }
+        if (!table_resize(table, capacity)) {
+            return false;
+        }
+    }
+
+    index = hash_key(key) & (table->capacity - 1);
+    while (table->slots[index].key != REGISTRY_EMPTY && table->slots[index].key != REGISTRY_TOMBSTONE) {
+        index = (index + 1) & (table->capacity - 1);
+    }
+    if (table->slots[index].key == REGISTRY_EMPTY) {
+        table->used++;
+    }
+    table->slots[index].key = key;
+    table->slots[index].device = device;
+    return true;
+}
+
+static void table_remove(registry_table_t *table, uint64_t key, intel_device_t *device)
+{
+    registry_slot_t *slot = table_find(table, key);
+
+    if (slot && slot->device == device) {
+        slot->key = REGISTRY_TOMBSTONE;
+        slot->device = NULL;
+    }
+}
+
+static uint64_t pci_address_key(uint16_t domain, uint8_t bus, uint8_t dev, uint8_t function)
+{
+    /* +1 keeps 0000:00:00.0 distinct from REGISTRY_EMPTY */
+    return (((uint64_t)domain << 16) | ((uint64_t)bus << 8) | ((uint64_t)(dev & 0x1F) << 3) | (function & 0x7)) + 1;
+}
+
+static bool has_pci_address(const intel_device_record_t *record)
+{
+    return record->pci_domain || record->pci_bus || record->pci_device || record->pci_function;
+}
+
+/**
+ * @brief Register an open device under its interface index and PCI address
+ */
+intel_hal_result_t intel_registry_add(intel_device_t *device)
+{
+    const intel_device_record_t *record = &device->record;
+    bool ok = true;
+
+    registry_lock_acquire();
+    if (record->if_index) {
+        ok = table_insert(&by_ifindex, record->if_index, device);
+    }
+    if (ok && has_pci_address(record)) {
+        ok = table_insert(&by_pci_address, pci_address_key(record->pci_domain, record->pci_bus,
+                                                           record->pci_device, record->pci_function), device);
+        if (!ok && record->if_index) {
+            table_remove(&by_ifindex, record->if_index, device);
+        }
+    }
+    intel_hal_mutex_unlock(&registry_lock);
+
+    if (!ok) {
+        intel_hal_set_error("Out of memory registering device");
+        return INTEL_HAL_ERROR_NO_MEMORY;
+    }
+    return INTEL_HAL_SUCCESS;
+}
+
+void intel_registry_remove(intel_device_t *device)
+{
+    const intel_device_record_t *record = &device->record;
+
+    registry_lock_acquire();
+    if (record->if_index) {
+        table_remove(&by_ifindex, record->if_index, device);
+    }
+    if (has_pci_address(record)) {
+        table_remove(&by_pci_address, pci_address_key(record->pci_domain, record->pci_bus,
+                                                      record->pci_device, record->pci_function), device);
+    }
+    intel_hal_mutex_unlock(&registry_lock);
+}
+
+intel_device_t *intel_hal_find_device_by_ifindex(uint32_t if_index)
+{
+    registry_slot_t *slot;
+    intel_device_t *device;
+
+    if (if_index == 0) {
+        return NULL;
+    }
+
+    registry_lock_acquire();
+    slot = table_find(&by_ifindex, if_index);
+    device = slot ? slot->device : NULL;
+    intel_hal_mutex_unlock(&registry_lock);
+    return device;
+}
+
+intel_device_t *intel_hal_find_device_by_pci_address(uint16_t domain, uint8_t bus, uint8_t dev, uint8_t function)
+{
+    registry_slot_t *slot;
+    intel_device_t *device;
+
+    registry_lock_acquire();
+    slot = table_find(&by_pci_address, pci_address_key(domain, bus, dev, function));
+    device = slot ? slot->device : NULL;
+    intel_hal_mutex_unlock(&registry_lock);
+    return device;
+}
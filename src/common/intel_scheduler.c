@@ -0,0 +1,635 @@
+/******************************************************************************
+
+  Copyright (c) 2025, Intel Corporation
+  All rights reserved.
+
+  Intel Ethernet HAL - PHC-time Scheduler
+
+  Per-device thread running callbacks at absolute PHC times. Pending
+  callbacks are kept in a timing wheel keyed by PHC time. The thread sleeps
+  on a system-clock timer (timerfd / high-resolution waitable timer) whose
+  deadline is converted through a PHC-to-system offset re-sampled on every
+  wakeup, with sleeps capped so frequency error between the clocks cannot
+  accumulate, then spins for the last few microseconds.
+
+******************************************************************************/
+
+#include "../include/intel_ethernet_hal.h"
+#include "../intel_hal_private.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef INTEL_HAL_LINUX
+#include <errno.h>
+#include <poll.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#endif
+
+#ifdef INTEL_HAL_WINDOWS
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+#endif
+
+#define SCHED_GRANULARITY_SHIFT     10                  /* ~1 us wheel ticks */
+#define SCHED_MAX_SLEEP_NS          10000000ULL         /* Re-sample the clock mapping at least every 10 ms */
+#define SCHED_MAPPING_SAMPLES       3
+#define SCHED_NO_ENTRY              UINT32_MAX
+
+enum {
+    ENTRY_FREE = 0,
+    ENTRY_PENDING,
+    ENTRY_RUNNING,                      /* Expired, waiting its turn in the batch */
+    ENTRY_CALLING,                      /* Callback in progress */
+    ENTRY_CANCELLED                     /* Cancelled while running or calling */
+};
+
+typedef struct sched_entry {
+    intel_timer_node_t node;            /* Keyed by PHC time; must be first */
+    uint64_t period_ns;                 /* 0 for one-shot */
+    intel_hal_schedule_fn_t callback;
+    void *arg;
+    uint32_t generation;
+    uint32_t state;
+    uint32_t next_free;
+    struct sched_entry *next_run;       /* Expired batch, in deadline order */
+} sched_entry_t;
+
+struct intel_scheduler {
+    intel_device_t *device;
+    intel_hal_mutex_t lock;
+    intel_hal_mutex_t call_lock;        /* Held across each callback, for synchronous cancel */
+    intel_hal_schedule_id_t current;    /* Entry whose callback is running, scheduler thread only */
+    intel_timer_wheel_t wheel;
+    sched_entry_t *entries;
+    uint32_t max_entries;
+    uint32_t free_head;
+    uint32_t spin_ns;
+    uint64_t armed_phc;                 /* PHC deadline the thread is sleeping towards */
+    int64_t phc_offset;                 /* PHC minus system time at the last sample */
+    volatile uint32_t running;
+    intel_hal_thread_t *thread;
+#ifdef INTEL_HAL_LINUX
+    int timer_fd;
+    int wake_fd;
+#endif
+#ifdef INTEL_HAL_WINDOWS
+    HANDLE timer;
+    HANDLE wake_event;
+#endif
+};
+
+static uint64_t system_time_ns(void)
+{
+#ifdef INTEL_HAL_LINUX
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+#else
+    FILETIME ft;
+    ULARGE_INTEGER value;
+    GetSystemTimePreciseAsFileTime(&ft);
+    value.LowPart = ft.dwLowDateTime;
+    value.HighPart = ft.dwHighDateTime;
+    return (value.QuadPart - 116444736000000000ULL) * 100ULL;   /* 1601 -> 1970 epoch */
+#endif
+}
+
+/**
+ * @brief Re-sample the PHC-to-system offset
+ *
+ * Takes the PHC reading bracketed by the tightest pair of system clock
+ * reads out of a few attempts.
+ */
+static bool sample_mapping(struct intel_scheduler *sched, uint64_t *phc_now)
+{
+    uint64_t best_window = UINT64_MAX;
+    uint32_t i;
+
+    for (i = 0; i < SCHED_MAPPING_SAMPLES; i++) {
+        intel_timestamp_t ts;
+        uint64_t before = system_time_ns();
+        intel_hal_result_t result = intel_hal_read_timestamp_unchecked(sched->device, &ts);
+        uint64_t after = system_time_ns();
+        uint64_t phc;
+
+        if (result != INTEL_HAL_SUCCESS) {
+            continue;
+        }
+        phc = ts.seconds * 1000000000ULL + ts.nanoseconds;
+        if (after - before < best_window) {
+            best_window = after - before;
+            sched->phc_offset = (int64_t)(phc - (before + (after - before) / 2));
+            *phc_now = phc + (after - before) / 2;
+        }
+    }
+
+    return best_window != UINT64_MAX;
+}
+
+static void signal_wakeup(struct intel_scheduler *sched)
+{
+#ifdef INTEL_HAL_LINUX
+    uint64_t one = 1;
+    if (write(sched->wake_fd, &one, sizeof(one)) < 0) {
+        /* Counter saturated: a wakeup is already pending */
+    }
+#else
+    SetEvent(sched->wake_event);
+#endif
+}
+
+/**
+ * @brief Sleep until a system time (0 = until woken)
+ */
+static void wait_for_deadline(struct intel_scheduler *sched, uint64_t sys_deadline)
+{
+#ifdef INTEL_HAL_LINUX
+    struct itimerspec spec;
+    struct pollfd fds[2];
+    uint64_t value;
+
+    memset(&spec, 0, sizeof(spec));
+    spec.it_value.tv_sec = (time_t)(sys_deadline / 1000000000ULL);
+    spec.it_value.tv_nsec = (long)(sys_deadline % 1000000000ULL);
+    timerfd_settime(sched->timer_fd, TFD_TIMER_ABSTIME, &spec, NULL);
+
+    fds[0].fd = sched->timer_fd;
+    fds[0].events = POLLIN;
+    fds[1].fd = sched->wake_fd;
+    fds[1].events = POLLIN;
+    if (poll(fds, 2, -1) > 0) {
+        if ((fds[0].revents & POLLIN) && read(sched->timer_fd, &value, sizeof(value)) < 0) {
+            /* Timer re-armed before the read: nothing to consume */
+        }
+        if ((fds[1].revents & POLLIN) && read(sched->wake_fd, &value, sizeof(value)) < 0) {
+            /* Already consumed */
+        }
+    }
+#else
+    HANDLE handles[2];
+    DWORD count = 1;
+
+    handles[0] = sched->wake_event;
+    if (sys_deadline) {
+        LARGE_INTEGER due;
+        uint64_t now = system_time_ns();
+        due.QuadPart = sys_deadline > now ? -(LONGLONG)((sys_deadline - now) / 100) : -1;
+        if (SetWaitableTimer(sched->timer, &due, 0, NULL, NULL, FALSE)) {
+            handles[count++] = sched->timer;
+        }
+    }
+    WaitForMultipleObjects(count, handles, FALSE, INFINITE);
+#endif
+}
+
+static void free_entry(struct intel_scheduler *sched, sched_entry_t *entry)
+{
+    entry->state = ENTRY_FREE;
+    entry->generation++;
+    entry->next_free = sched->free_head;
+    sched->free_head = (uint32_t)(entry - sched->entries);
+}
+
+/**
+ * @brief Run an expired batch in deadline order
+ */
+static void run_expired(struct intel_scheduler *sched, intel_timer_node_t *expired)
+{
+    sched_entry_t *batch = NULL;
+    intel_timer_node_t *node = expired->next;
+
+    /* Wheel slots are ~1 us wide; order exactly by deadline (batches are small) */
+    while (node != expired) {
+        sched_entry_t *entry = (sched_entry_t *)node;
+        sched_entry_t **link = &batch;
+
+        node = node->next;
+        while (*link && (*link)->node.expires <= entry->node.expires) {
+            link = &(*link)->next_run;
+        }
+        entry->next_run = *link;
+        *link = entry;
+    }
+
+    while (batch) {
+        sched_entry_t *entry = batch;
+        uint64_t deadline = entry->node.expires;
+        uint64_t sys_deadline = deadline - (uint64_t)sched->phc_offset;
+        bool cancelled;
+
+        batch = entry->next_run;
+
+        while (system_time_ns() < sys_deadline) {
+            /* Spin through the final microseconds */
+        }
+
+        intel_hal_mutex_lock(&sched->call_lock);
+        intel_hal_mutex_lock(&sched->lock);
+        cancelled = entry->state == ENTRY_CANCELLED;
+        if (!cancelled) {
+            entry->state = ENTRY_CALLING;
+            sched->current = ((uint64_t)entry->generation << 32) | (uint64_t)(entry - sched->entries + 1);
+        }
+        intel_hal_mutex_unlock(&sched->lock);
+        if (!cancelled) {
+            entry->callback(sched->device, deadline, entry->arg);
+            sched->current = INTEL_HAL_SCHEDULE_INVALID_ID;
+        }
+        intel_hal_mutex_unlock(&sched->call_lock);
+
+        intel_hal_mutex_lock(&sched->lock);
+        if (entry->state == ENTRY_CALLING && entry->period_ns) {
+            uint64_t phc_now = system_time_ns() + (uint64_t)sched->phc_offset;
+            uint64_t next = deadline + entry->period_ns;
+            if (next <= phc_now) {
+                next += ((phc_now - next) / entry->period_ns + 1) * entry->period_ns;
+            }
+            entry->node.expires = next;
+            entry->state = ENTRY_PENDING;
+            intel_timer_wheel_add(&sched->wheel, &entry->node);
+        } else {
+            free_entry(sched, entry);
+        }
+        intel_hal_mutex_unlock(&sched->lock);
+    }
+}
+
+static void scheduler_thread(void *context)
+{
+    struct intel_scheduler *sched = (struct intel_scheduler *)context;
+
+    while (intel_atomic_load_u32(&sched->running)) {
+        intel_timer_node_t expired;
+        intel_timer_node_t *node;
+        uint64_t phc_now;
+        uint64_t next_phc;
+        uint64_t sys_now;
+        bool pending = false;
+
+        if (!sample_mapping(sched, &phc_now)) {
+            /* PHC unreadable (e.g. link reset): retry later */
+            wait_for_deadline(sched, system_time_ns() + SCHED_MAX_SLEEP_NS);
+            continue;
+        }
+
+        expired.next = expired.prev = &expired;
+        intel_hal_mutex_lock(&sched->lock);
+        intel_timer_wheel_advance(&sched->wheel, phc_now + sched->spin_ns, &expired);
+        for (node = expired.next; node != &expired; node = node->next) {
+            ((sched_entry_t *)node)->state = ENTRY_RUNNING;
+        }
+        if (expired.next == &expired) {
+            pending = intel_timer_wheel_next_expiry(&sched->wheel, &next_phc);
+            sched->armed_phc = pending ? next_phc : UINT64_MAX;
+        }
+        intel_hal_mutex_unlock(&sched->lock);
+
+        if (expired.next != &expired) {
+            run_expired(sched, &expired);
+            continue;
+        }
+
+        if (!pending) {
+            wait_for_deadline(sched, 0);
+            continue;
+        }
+
+        /* Wake one spin window early, never sleeping longer than the re-sample interval */
+        sys_now = system_time_ns();
+        next_phc = next_phc > sched->spin_ns ? next_phc - sched->spin_ns : 0;
+        if (next_phc - (uint64_t)sched->phc_offset > sys_now + SCHED_MAX_SLEEP_NS) {
+            wait_for_deadline(sched, sys_now + SCHED_MAX_SLEEP_NS);
+        } else {
+            wait_for_deadline(sched, next_phc - (uint64_t)sched->phc_offset);
+        }
+    }
+}
+
+void intel_scheduler_destroy(struct intel_scheduler *sched)
+{
+    if (!sched) {
+        return;
+    }
+
+    if (sched->thread) {
+        intel_atomic_store_u32(&sched->running, 0);
+        signal_wakeup(sched);
+        intel_hal_thread_join(sched->thread);
+    }
+
+#ifdef INTEL_HAL_LINUX
+    if (sched->timer_fd >= 0) {
+        close(sched->timer_fd);
+    }
+    if (sched->wake_fd >= 0) {
+        close(sched->wake_fd);
+    }
+#endif
+#ifdef INTEL_HAL_WINDOWS
+    if (sched->timer) {
+        CloseHandle(sched->timer);
+    }
+    if (sched->wake_event) {
+        CloseHandle(sched->wake_event);
+    }
+#endif
+
+    intel_hal_mutex_destroy(&sched->call_lock);
+    intel_hal_mutex_destroy(&sched->lock);
+    free(sched->entries);
+    free(sched);
+}
+
+static intel_hal_result_t scheduler_create(intel_device_t *device, const intel_hal_scheduler_config_t *config,
+                                           struct intel_scheduler **out)
+{
+    struct intel_scheduler *sched;
+    intel_hal_result_t result;
+    uint64_t phc_now = 0;
+    uint32_t i;
+
+    sched = (struct intel_scheduler *)calloc(1, sizeof(*sched));
+    if (!sched) {
+        intel_hal_set_error("Out of memory creating scheduler");
+        return INTEL_HAL_ERROR_NO_MEMORY;
+    }
+    sched->device = device;
+    sched->spin_ns = config->spin_ns ? config->spin_ns : INTEL_HAL_SCHEDULER_DEFAULT_SPIN;
+    sched->max_entries = config->max_entries ? config->max_entries : INTEL_HAL_SCHEDULER_DEFAULT_SIZE;
+    sched->armed_phc = UINT64_MAX;
+    intel_hal_mutex_init(&sched->lock);
+    intel_hal_mutex_init(&sched->call_lock);
+#ifdef INTEL_HAL_LINUX
+    sched->timer_fd = -1;
+    sched->wake_fd = -1;
+#endif
+
+    sched->entries = (sched_entry_t *)calloc(sched->max_entries, sizeof(sched_entry_t));
+    if (!sched->entries) {
+        intel_hal_set_error("Out of memory creating scheduler");
+        intel_scheduler_destroy(sched);
+        return INTEL_HAL_ERROR_NO_MEMORY;
+    }
+    for (i = 0; i < sched->max_entries; i++) {
+        sched->entries[i].next_free = i + 1 < sched->max_entries ? i + 1 : SCHED_NO_ENTRY;
+    }
+    sched->free_head = 0;
+
+    if (!sample_mapping(sched, &phc_now)) {
+        intel_hal_set_error("Cannot read PHC for scheduler");
+        intel_scheduler_destroy(sched);
+        return INTEL_HAL_ERROR_HARDWARE;
+    }
+    intel_timer_wheel_init(&sched->wheel, phc_now, SCHED_GRANULARITY_SHIFT);
+
+#ifdef INTEL_HAL_LINUX
+    sched->timer_fd = timerfd_create(CLOCK_REALTIME, TFD_CLOEXEC);
+    sched->wake_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (sched->timer_fd < 0 || sched->wake_fd < 0) {
+        intel_hal_set_error("Cannot create scheduler timer: %s", strerror(errno));
+        intel_scheduler_destroy(sched);
+        return INTEL_HAL_ERROR_OS_SPECIFIC;
+    }
+#endif
+#ifdef INTEL_HAL_WINDOWS
+    sched->timer = CreateWaitableTimerExW(NULL, NULL, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+    if (!sched->timer) {
+        sched->timer = CreateWaitableTimerW(NULL, FALSE, NULL);   /* Before Windows 10 1803 */
+    }
+    sched->wake_event = CreateEventW(NULL, FALSE, FALSE, NULL);
+    if (!sched->timer || !sched->wake_event) {
+        intel_hal_set_error("Cannot create scheduler timer: %u", (unsigned int)GetLastError());
+        intel_scheduler_destroy(sched);
+        return INTEL_HAL_ERROR_OS_SPECIFIC;
+    }
+#endif
+
+    sched->running = 1;
+    result = intel_hal_thread_create(device, &config->thread_attr, scheduler_thread, sched, &sched->thread);
+    if (result != INTEL_HAL_SUCCESS) {
+        sched->thread = NULL;
+        intel_scheduler_destroy(sched);
+        return result;
+    }
+
+    *out = sched;
+    return INTEL_HAL_SUCCESS;
+}
+
+/**
+ * @brief Get the device scheduler, starting it if needed
+ */
+static intel_hal_result_t get_scheduler(intel_device_t *device, const intel_hal_scheduler_config_t *config,
+                                        bool exclusive, struct intel_scheduler **out)
+{
+    intel_hal_scheduler_config_t defaults;
+    struct intel_scheduler *sched;
+    intel_hal_result_t result;
+
+    sched = (struct intel_scheduler *)intel_atomic_load_ptr((void *const volatile *)&device->scheduler);
+    if (sched) {
+        *out = sched;
+        return exclusive ? INTEL_HAL_ERROR_DEVICE_BUSY : INTEL_HAL_SUCCESS;
+    }
+
+    if (!intel_device_has_capability(device, INTEL_CAP_BASIC_1588)) {
+        intel_hal_set_error("Device does not support timestamping");
+        return INTEL_HAL_ERROR_NOT_SUPPORTED;
+    }
+
+    if (!config) {
+        intel_hal_scheduler_config_init(&defaults);
+        config = &defaults;
+    }
+    result = scheduler_create(device, config, &sched);
+    if (result != INTEL_HAL_SUCCESS) {
+        return result;
+    }
+
+    /* Another thread may have started the scheduler concurrently */
+    if (!intel_atomic_cas_ptr((void *volatile *)&device->scheduler, NULL, sched)) {
+        intel_scheduler_destroy(sched);
+        *out = (struct intel_scheduler *)intel_atomic_load_ptr((void *const volatile *)&device->scheduler);
+        return exclusive ? INTEL_HAL_ERROR_DEVICE_BUSY : INTEL_HAL_SUCCESS;
+    }
+
+    *out = sched;
+    return INTEL_HAL_SUCCESS;
+}
+
+void intel_hal_scheduler_config_init(intel_hal_scheduler_config_t *config)
+{
+    if (!config) {
+        return;
+    }
+
+    memset(config, 0, sizeof(*config));
+    config->spin_ns = INTEL_HAL_SCHEDULER_DEFAULT_SPIN;
+    config->max_entries = INTEL_HAL_SCHEDULER_DEFAULT_SIZE;
+    intel_hal_thread_attr_init(&config->thread_attr);
+    config->thread_attr.name = "intel_hal_sched";
+}
+
+intel_hal_result_t intel_hal_scheduler_start(intel_device_t *device, const intel_hal_scheduler_config_t *config)
+{
+    struct intel_scheduler *sched;
+
+    if (!device) {
+        intel_hal_set_error("Invalid parameters for scheduler start");
+        return INTEL_HAL_ERROR_INVALID_PARAM;
+    }
+
+    return get_scheduler(device, config, true, &sched);
+}
+
+static intel_hal_result_t schedule_entry(intel_device_t *device, uint64_t phc_time, uint64_t period_ns,
+                                         intel_hal_schedule_fn_t callback, void *arg,
+                                         intel_hal_schedule_id_t *id)
+{
+    struct intel_scheduler *sched;
+    sched_entry_t *entry;
+    intel_hal_result_t result;
+    uint32_t index;
+    bool wake;
+
+    result = get_scheduler(device, NULL, false, &sched);
+    if (result != INTEL_HAL_SUCCESS) {
+        return result;
+    }
+
+    intel_hal_mutex_lock(&sched->lock);
+    index = sched->free_head;
+    if (index == SCHED_NO_ENTRY) {
+        intel_hal_mutex_unlock(&sched->lock);
+        intel_hal_set_error("Scheduler full (%u pending callbacks)", sched->max_entries);
+        return INTEL_HAL_ERROR_NO_MEMORY;
+    }
+    entry = &sched->entries[index];
+    sched->free_head = entry->next_free;
+
+    entry->node.expires = phc_time;
+    entry->period_ns = period_ns;
+    entry->callback = callback;
+    entry->arg = arg;
+    entry->state = ENTRY_PENDING;
+    intel_timer_wheel_add(&sched->wheel, &entry->node);
+
+    /* Wake the thread if this deadline precedes the one it sleeps towards */
+    wake = phc_time < sched->armed_phc;
+    if (wake) {
+        sched->armed_phc = phc_time;
+    }
+    if (id) {
+        *id = ((uint64_t)entry->generation << 32) | (uint64_t)(index + 1);
+    }
+    intel_hal_mutex_unlock(&sched->lock);
+
+    if (wake) {
+        signal_wakeup(sched);
+    }
+    return INTEL_HAL_SUCCESS;
+}
+
+intel_hal_result_t intel_hal_schedule_at(intel_device_t *device, uint64_t phc_time,
+                                         intel_hal_schedule_fn_t callback, void *arg,
+                                         intel_hal_schedule_id_t *id)
+{
+    if (!device || !callback) {
+        intel_hal_set_error("Invalid parameters for schedule");
+        return INTEL_HAL_ERROR_INVALID_PARAM;
+    }
+
+    return schedule_entry(device, phc_time, 0, callback, arg, id);
+}
+
+intel_hal_result_t intel_hal_schedule_periodic(intel_device_t *device, uint64_t first_phc_time, uint64_t period_ns,
+                                               intel_hal_schedule_fn_t callback, void *arg,
+                                               intel_hal_schedule_id_t *id)
+{
+    if (!device || !callback || period_ns == 0) {
+        intel_hal_set_error("Invalid parameters for periodic schedule");
+        return INTEL_HAL_ERROR_INVALID_PARAM;
+    }
+
+    return schedule_entry(device, first_phc_time, period_ns, callback, arg, id);
+}
+
+/**
+ * @brief Cancel a scheduled callback, reporting whether it was in progress
+ */
+static intel_hal_result_t cancel_entry(intel_device_t *device, intel_hal_schedule_id_t id,
+                                       struct intel_scheduler **out, bool *calling)
+{
+    struct intel_scheduler *sched;
+    sched_entry_t *entry;
+    uint32_t index = (uint32_t)(id & 0xFFFFFFFFu);
+    intel_hal_result_t result = INTEL_HAL_SUCCESS;
+
+    *calling = false;
+    if (!device || id == INTEL_HAL_SCHEDULE_INVALID_ID) {
+        intel_hal_set_error("Invalid parameters for schedule cancel");
+        return INTEL_HAL_ERROR_INVALID_PARAM;
+    }
+
+    sched = (struct intel_scheduler *)intel_atomic_load_ptr((void *const volatile *)&device->scheduler);
+    if (!sched || index == 0 || index > sched->max_entries) {
+        intel_hal_set_error("Unknown schedule id");
+        return INTEL_HAL_ERROR_INVALID_PARAM;
+    }
+
+    intel_hal_mutex_lock(&sched->lock);
+    entry = &sched->entries[index - 1];
+    if (entry->generation != (uint32_t)(id >> 32) || entry->state == ENTRY_FREE || entry->state == ENTRY_CANCELLED) {
+        intel_hal_set_error("Schedule id already completed or cancelled");
+        result = INTEL_HAL_ERROR_INVALID_PARAM;
+    } else if (entry->state == ENTRY_RUNNING || entry->state == ENTRY_CALLING) {
+        *calling = entry->state == ENTRY_CALLING;
+        entry->state = ENTRY_CANCELLED;     /* Freed by the scheduler thread after the callback */
+    } else {
+        intel_timer_wheel_remove(&sched->wheel, &entry->node);
+        free_entry(sched, entry);
+    }
+    intel_hal_mutex_unlock(&sched->lock);
+
+    *out = sched;
+    return result;
+}
+
+intel_hal_result_t intel_hal_schedule_cancel(intel_device_t *device, intel_hal_schedule_id_t id)
+{
+    struct intel_scheduler *sched;
+    bool calling;
+
+    return cancel_entry(device, id, &sched, &calling);
+}
+
+intel_hal_schedule_id_t intel_scheduler_current_id(intel_device_t *device)
+{
+    struct intel_scheduler *sched;
+
+    sched = (struct intel_scheduler *)intel_atomic_load_ptr((void *const volatile *)&device->scheduler);
+    return sched ? sched->current : INTEL_HAL_SCHEDULE_INVALID_ID;
+}
+
+intel_hal_result_t intel_scheduler_cancel_sync(intel_device_t *device, intel_hal_schedule_id_t id, bool *started)
+{
+    struct intel_scheduler *sched;
+    intel_hal_result_t result;
+    bool calling;
+
+    result = cancel_entry(device, id, &sched, &calling);
+    if (result == INTEL_HAL_SUCCESS && calling) {
+        /* The callback holds call_lock until it returns */
+        intel_hal_mutex_lock(&sched->call_lock);
+        intel_hal_mutex_unlock(&sched->call_lock);
+    }
+    if (started) {
+        *started = calling;
+    }
+    return result;
+}
@@ -0,0 +1,463 @@
+/******************************************************************************
+
+  Copyright (c) 2025, Intel Corporation
+  All rights reserved.
+
+  Intel Ethernet HAL - Software Time-Aware Shaper
+
+  802.1Qbv approximation for families without a hardware gate scheduler
+  (I210/I219). Frames are held in per-traffic-class queues and released by
+  the device PHC-time scheduler at the start of every gate control entry:
+  each class open in the entry sends the frames that complete before its
+  gate closes, highest class first, with consecutive launch times so the
+  frames are placed back to back inside the window at the link speed read
+  when the schedule was configured.
+
+  Schedules live in two banks. A staged (admin) schedule gets its own entry
+  callbacks from its base time on; the first of them makes it the
+  operating schedule, and operating-bank callbacks at or after that time
+  stand down, so the switch happens exactly at the admin base time.
+
+******************************************************************************/
+
+#include "../include/intel_ethernet_hal.h"
+#include "../intel_hal_private.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SOFT_TAS_DEFAULT_MBPS       1000        /* Link speed unknown: I210 and I219 top speed */
+
+typedef struct {
+    uint8_t data[INTEL_HAL_SOFT_TAS_MAX_FRAME];
+    uint32_t length;
+} soft_tas_frame_t;
+
+typedef struct {
+    soft_tas_frame_t frames[INTEL_HAL_SOFT_TAS_QUEUE_DEPTH];
+    uint32_t head;
+    uint32_t count;
+} soft_tas_queue_t;
+
+typedef struct {
+    struct intel_soft_tas *soft;
+    uint32_t bank;
+    uint32_t index;
+} soft_tas_entry_t;
+
+typedef struct {
+    intel_tas_config_t config;
+    uint64_t open_ns[INTEL_HAL_TAS_MAX_ENTRIES][8];     /* Remaining gate-open time from each entry start */
+    intel_hal_schedule_id_t ids[INTEL_HAL_TAS_MAX_ENTRIES];
+    soft_tas_entry_t entries[INTEL_HAL_TAS_MAX_ENTRIES];
+} soft_tas_bank_t;
+
+struct intel_soft_tas {
+    intel_hal_mutex_t lock;
+    soft_tas_bank_t banks[2];
+    uint32_t oper;                                      /* Operating bank */
+    bool admin_pending;                                 /* Other bank staged to take over at admin_base */
+    uint64_t admin_base;
+    uint64_t busy_until;                                /* PHC time the last released frame ends */
+    uint32_t link_mbps;                                 /* Link speed when last (re)scheduled */
+    soft_tas_queue_t queues[8];
+    intel_soft_tas_stats_t stats;
+};
+
+/**
+ * @brief Link speed to pace released frames with
+ */
+static uint32_t link_speed(intel_device_t *device)
+{
+    bool link_up;
+    uint32_t speed_mbps;
+
+    if (intel_hal_read_link(device, &link_up, &speed_mbps) != INTEL_HAL_SUCCESS || speed_mbps == 0) {
+        return SOFT_TAS_DEFAULT_MBPS;
+    }
+    return speed_mbps;
+}
+
+/**
+ * @brief Compute, per entry and class, how long the gate stays open
+ *        from the entry start (following open entries across the cycle end)
+ */
+void intel_soft_tas_open_times(const intel_tas_config_t *config, uint64_t open_ns[INTEL_HAL_TAS_MAX_ENTRIES][8])
+{
+    uint32_t count = config->gate_control_list_length;
+    uint32_t tc;
+    uint32_t i;
+
+    memset(open_ns, 0, sizeof(uint64_t) * INTEL_HAL_TAS_MAX_ENTRIES * 8);
+    for (tc = 0; tc < 8; tc++) {
+        uint8_t mask = (uint8_t)(1u << tc);
+        uint64_t run = 0;
+        uint32_t pass;
+
+        /* Two backward passes so runs wrapping past the last entry are counted */
+        for (pass = 0; pass < 2; pass++) {
+            for (i = count; i-- > 0;) {
+                if (config->gate_control_list[i].gate_states & mask) {
+                    run += config->gate_control_list[i].time_interval;
+                    if (run > config->cycle_time) {
+                        run = config->cycle_time;   /* Always open */
+                    }
+                } else {
+                    run = 0;
+                }
+                open_ns[i][tc] = run;
+            }
+        }
+    }
+}
+
+static void cancel_entries(intel_device_t *device, soft_tas_bank_t *bank)
+{
+    uint32_t i;
+
+    for (i = 0; i < INTEL_HAL_TAS_MAX_ENTRIES; i++) {
+        if (bank->ids[i] != INTEL_HAL_SCHEDULE_INVALID_ID) {
+            intel_hal_schedule_cancel(device, bank->ids[i]);
+            bank->ids[i] = INTEL_HAL_SCHEDULE_INVALID_ID;
+        }
+    }
+}
+
+/**
+ * @brief Drop the held frames once no schedule will release them (lock held)
+ */
+static void flush_queues(struct intel_soft_tas *soft)
+{
+    uint32_t tc;
+
+    for (tc = 0; tc < 8; tc++) {
+        soft->stats.dropped[tc] += soft->queues[tc].count;
+        soft->queues[tc].head = 0;
+        soft->queues[tc].count = 0;
+    }
+}
+
+/**
+ * @brief Release queued frames at the start of one gate control entry
+ */
+static void entry_callback(intel_device_t *device, uint64_t phc_time, void *arg)
+{
+    soft_tas_entry_t *entry = (soft_tas_entry_t *)arg;
+    struct intel_soft_tas *soft = entry->soft;
+    soft_tas_bank_t *bank = &soft->banks[entry->bank];
+    uint64_t cursor;
+    int tc;
+
+    intel_hal_mutex_lock(&soft->lock);
+    if (bank->ids[entry->index] != intel_scheduler_current_id(device)) {
+        intel_hal_mutex_unlock(&soft->lock);
+        return;                         /* Schedule replaced while this entry waited for the lock */
+    }
+    if (soft->admin_pending && phc_time >= soft->admin_base) {
+        if (entry->bank == soft->oper) {
+            intel_hal_mutex_unlock(&soft->lock);
+            return;                     /* Superseded by the staged schedule */
+        }
+        cancel_entries(device, &soft->banks[soft->oper]);
+        soft->banks[soft->oper].config.gate_control_list_length = 0;
+        soft->oper = entry->bank;
+        soft->admin_pending = false;
+    } else if (entry->bank != soft->oper) {
+        intel_hal_mutex_unlock(&soft->lock);
+        return;                         /* Staged schedule not yet due */
+    }
+
+    cursor = soft->busy_until > phc_time ? soft->busy_until : phc_time;
+    for (tc = 7; tc >= 0; tc--) {
+        soft_tas_queue_t *queue = &soft->queues[tc];
+        uint64_t gate_close = phc_time + bank->open_ns[entry->index][tc];
+
+        /* The operating schedule's windows end where the staged one takes over */
+        if (soft->admin_pending && gate_close > soft->admin_base) {
+            gate_close = soft->admin_base;
+        }
+
+        while (queue->count > 0) {
+            soft_tas_frame_t *frame = &queue->frames[queue->head];
+            uint64_t duration = intel_wire_time_ns(frame->length, soft->link_mbps);
+            intel_timed_packet_t packet;
+
+            if (cursor + duration > gate_close) {
+                break;                  /* Does not complete before the gate closes */
+            }
+
+            packet.packet_data = frame->data;
+            packet.packet_length = frame->length;
+            packet.launch_time = cursor;
+            packet.queue = 0;           /* LaunchTime-capable queue */
+            if (intel_hal_xmit_timed_packet(device, &packet) == INTEL_HAL_SUCCESS) {
+                soft->stats.sent[tc]++;
+                cursor += duration;
+            } else {
+                soft->stats.dropped[tc]++;
+            }
+
+            queue->head = (queue->head + 1) % INTEL_HAL_SOFT_TAS_QUEUE_DEPTH;
+            queue->count--;
+        }
+    }
+    soft->busy_until = cursor;
+    intel_hal_mutex_unlock(&soft->lock);
+}
+
+/**
+ * @brief Schedule one periodic release per entry start of a bank (lock held)
+ */
+static intel_hal_result_t schedule_bank(intel_device_t *device, soft_tas_bank_t *bank, uint64_t start)
+{
+    const intel_tas_config_t *config = &bank->config;
+    intel_hal_result_t result = INTEL_HAL_SUCCESS;
+    uint64_t offset = 0;
+    uint32_t i;
+
+    intel_soft_tas_open_times(config, bank->open_ns);
+    for (i = 0; i < config->gate_control_list_length && result == INTEL_HAL_SUCCESS; i++) {
+        result = intel_hal_schedule_periodic(device, start + offset, config->cycle_time,
+                                             entry_callback, &bank->entries[i], &bank->ids[i]);
+        offset += config->gate_control_list[i].time_interval;
+    }
+    if (result != INTEL_HAL_SUCCESS) {
+        cancel_entries(device, bank);
+        bank->config.gate_control_list_length = 0;
+    }
+    return result;
+}
+
+
+void intel_soft_tas_destroy(struct intel_soft_tas *soft)
+{
+    if (!soft) {
+        return;
+    }
+
+    /* The device scheduler is already stopped; no callback can be running */
+    intel_hal_mutex_destroy(&soft->lock);
+    free(soft);
+}
+
+/**
+ * @brief Check that the entry intervals fill the cycle exactly
+ */
+static intel_hal_result_t validate_config(const intel_tas_config_t *config)
+{
+    uint64_t total = 0;
+    uint32_t i;
+
+    for (i = 0; i < config->gate_control_list_length; i++) {
+        total += config->gate_control_list[i].time_interval;
+    }
+    if (config->gate_control_list_length > 0 && (config->cycle_time == 0 || total != config->cycle_time)) {
+        intel_hal_set_error("Software TAS needs intervals summing to the cycle time (%llu != %llu ns)",
+                            (unsigned long long)total, (unsigned long long)config->cycle_time);
+        return INTEL_HAL_ERROR_INVALID_PARAM;
+    }
+    return INTEL_HAL_SUCCESS;
+}
+
+/**
+ * @brief Get the device software TAS, creating it on first use
+ */
+static struct intel_soft_tas *get_soft_tas(intel_device_t *device)
+{
+    struct intel_soft_tas *soft;
+    uint32_t b, i;
+
+    soft = (struct intel_soft_tas *)intel_atomic_load_ptr((void *const volatile *)&device->soft_tas);
+    if (soft) {
+        return soft;
+    }
+
+    soft = (struct intel_soft_tas *)calloc(1, sizeof(*soft));
+    if (!soft) {
+        intel_hal_set_error("Out of memory creating software TAS");
+        return NULL;
+    }
+    intel_hal_mutex_init(&soft->lock);
+    soft->link_mbps = SOFT_TAS_DEFAULT_MBPS;
+    for (b = 0; b < 2; b++) {
+        for (i = 0; i < INTEL_HAL_TAS_MAX_ENTRIES; i++) {
+            soft->banks[b].entries[i].soft = soft;
+            soft->banks[b].entries[i].bank = b;
+            soft->banks[b].entries[i].index = i;
+        }
+    }
+
+    /* Another thread may have configured the device concurrently */
+    if (!intel_atomic_cas_ptr((void *volatile *)&device->soft_tas, NULL, soft)) {
+        intel_soft_tas_destroy(soft);
+        soft = (struct intel_soft_tas *)intel_atomic_load_ptr((void *const volatile *)&device->soft_tas);
+    }
+    return soft;
+}
+
+/**
+ * @brief First cycle start on the base_time grid that is not in the past
+ */
+static uint64_t first_cycle_start(intel_device_t *device, const intel_tas_config_t *config)
+{
+    intel_timestamp_t now;
+    uint64_t start = config->base_time;
+
+    if (config->gate_control_list_length > 0 &&
+        intel_hal_read_timestamp_unchecked(device, &now) == INTEL_HAL_SUCCESS) {
+        uint64_t phc_now = now.seconds * 1000000000ULL + now.nanoseconds;
+        if (start < phc_now) {
+            start = intel_hal_tas_next_base_time(start, config->cycle_time, phc_now);
+        }
+    }
+    return start;
+}
+
+intel_hal_result_t intel_soft_tas_configure(intel_device_t *device, const intel_tas_config_t *config)
+{
+    struct intel_soft_tas *soft;
+    soft_tas_bank_t *bank;
+    intel_hal_result_t result;
+    uint32_t link_mbps;
+    uint64_t start;
+
+    result = validate_config(config);
+    if (result != INTEL_HAL_SUCCESS) {
+        return result;
+    }
+
+    if (config->gate_control_list_length == 0 &&
+        !intel_atomic_load_ptr((void *const volatile *)&device->soft_tas)) {
+        return INTEL_HAL_SUCCESS;
+    }
+    soft = get_soft_tas(device);
+    if (!soft) {
+        return INTEL_HAL_ERROR_NO_MEMORY;
+    }
+
+    start = first_cycle_start(device, config);
+    link_mbps = link_speed(device);
+
+    /* Immediate replace: drop both banks, including a staged schedule */
+    intel_hal_mutex_lock(&soft->lock);
+    soft->link_mbps = link_mbps;
+    cancel_entries(device, &soft->banks[0]);
+    cancel_entries(device, &soft->banks[1]);
+    soft->banks[soft->oper ^ 1].config.gate_control_list_length = 0;
+    soft->admin_pending = false;
+
+    bank = &soft->banks[soft->oper];
+    bank->config = *config;
+    result = schedule_bank(device, bank, start);
+    if (bank->config.gate_control_list_length == 0) {
+        flush_queues(soft);             /* Disabled, or scheduling failed */
+    }
+    intel_hal_mutex_unlock(&soft->lock);
+
+    return result;
+}
+
+intel_hal_result_t intel_soft_tas_stage(intel_device_t *device, const intel_tas_config_t *config)
+{
+    struct intel_soft_tas *soft;
+    soft_tas_bank_t *admin;
+    intel_hal_result_t result;
+    uint32_t link_mbps;
+
+    result = validate_config(config);
+    if (result != INTEL_HAL_SUCCESS) {
+        return result;
+    }
+    if (config->gate_control_list_length == 0) {
+        intel_hal_set_error("Staged software TAS schedule has no entries");
+        return INTEL_HAL_ERROR_INVALID_PARAM;
+    }
+
+    soft = get_soft_tas(device);
+    if (!soft) {
+        return INTEL_HAL_ERROR_NO_MEMORY;
+    }
+
+    link_mbps = link_speed(device);
+
+    /* Entries start exactly at the admin base time; the first one due takes over */
+    intel_hal_mutex_lock(&soft->lock);
+    soft->link_mbps = link_mbps;
+    admin = &soft->banks[soft->oper ^ 1];
+    cancel_entries(device, admin);
+    admin->config = *config;
+    soft->admin_base = config->base_time;
+    soft->admin_pending = true;
+    result = schedule_bank(device, admin, config->base_time);
+    if (result != INTEL_HAL_SUCCESS) {
+        soft->admin_pending = false;
+    }
+    intel_hal_mutex_unlock(&soft->lock);
+
+    return result;
+}
+
+intel_hal_result_t intel_hal_soft_tas_enqueue(intel_device_t *device, uint8_t traffic_class,
+                                              const void *frame, size_t length)
+{
+    struct intel_soft_tas *soft;
+    soft_tas_queue_t *queue;
+    soft_tas_frame_t *slot;
+    intel_hal_result_t result = INTEL_HAL_SUCCESS;
+
+    if (!device || !frame || length == 0 || length > INTEL_HAL_SOFT_TAS_MAX_FRAME || traffic_class > 7) {
+        intel_hal_set_error("Invalid parameters for software TAS enqueue");
+        return INTEL_HAL_ERROR_INVALID_PARAM;
+    }
+
+    soft = (struct intel_soft_tas *)intel_atomic_load_ptr((void *const volatile *)&device->soft_tas);
+    if (!soft) {
+        intel_hal_set_error("Software TAS is not active on this device");
+        return INTEL_HAL_ERROR_NOT_SUPPORTED;
+    }
+
+    intel_hal_mutex_lock(&soft->lock);
+    queue = &soft->queues[traffic_class];
+    if (soft->banks[soft->oper].config.gate_control_list_length == 0 && !soft->admin_pending) {
+        intel_hal_set_error("Software TAS is disabled on this device");
+        result = INTEL_HAL_ERROR_NOT_SUPPORTED;
+    } else if (queue->count == INTEL_HAL_SOFT_TAS_QUEUE_DEPTH) {
+        soft->stats.dropped[traffic_class]++;
+        intel_hal_set_error("Software TAS queue for TC %u is full", traffic_class);
+        result = INTEL_HAL_ERROR_NO_MEMORY;
+    } else {
+        slot = &queue->frames[(queue->head + queue->count) % INTEL_HAL_SOFT_TAS_QUEUE_DEPTH];
+        memcpy(slot->data, frame, length);
+        slot->length = (uint32_t)length;
+        queue->count++;
+        soft->stats.enqueued[traffic_class]++;
+    }
+    intel_hal_mutex_unlock(&soft->lock);
+
+    return result;
+}
+
+intel_hal_result_t intel_hal_soft_tas_get_stats(intel_device_t *device, intel_soft_tas_stats_t *stats)
+{
+    struct intel_soft_tas *soft;
+    uint32_t tc;
+
+    if (!device || !stats) {
+        intel_hal_set_error("Invalid parameters");
+        return INTEL_HAL_ERROR_INVALID_PARAM;
+    }
+
+    soft = (struct intel_soft_tas *)intel_atomic_load_ptr((void *const volatile *)&device->soft_tas);
+    if (!soft) {
+        intel_hal_set_error("Software TAS is not active on this device");
+        return INTEL_HAL_ERROR_NOT_SUPPORTED;
+    }
+
+    intel_hal_mutex_lock(&soft->lock);
+    *stats = soft->stats;
+    for (tc = 0; tc < 8; tc++) {
+        stats->queued[tc] = soft->queues[tc].count;
+    }
+    intel_hal_mutex_unlock(&soft->lock);
+    return INTEL_HAL_SUCCESS;
+}
@@ -0,0 +1,134 @@
+/******************************************************************************
+
+  Copyright (c) 2025, Intel Corporation
+  All rights reserved.
+
+  Intel Ethernet HAL - SRP Credit-Based Shaper Calculation
+
+  Derives the Class A/B credit-based shaper parameters from a set of stream
+  reservations following IEEE 802.1Q Annex L, with admission control
+  against the 75% default maximum SR class bandwidth.
+
+******************************************************************************/
+
+#include "../include/intel_ethernet_hal.h"
+#include "../intel_hal_private.h"
+#include <stdio.h>
+#include <string.h>
+
+#define SRP_FRAME_OVERHEAD          42      /* Preamble+SFD, MAC header, VLAN tag, FCS, IPG */
+#define SRP_CLASS_A_INTERVALS       8000    /* Class measurement intervals per second (125 us) */
+#define SRP_CLASS_B_INTERVALS       4000    /* 250 us */
+#define SRP_DEFAULT_INTERFERENCE    1542    /* 1522-byte frame with preamble and IPG */
+#define SRP_MAX_BANDWIDTH_PERCENT   75
+
+static uint64_t ceil_div(uint64_t numerator, uint64_t denominator)
+{
+    return (numerator + denominator - 1) / denominator;
+}
+
+intel_hal_result_t intel_hal_calculate_cbs(const intel_stream_reservation_t *streams, uint32_t stream_count,
+                                           uint32_t link_speed_mbps, uint32_t max_interference_size,
+                                           intel_cbs_config_t *class_a, intel_cbs_config_t *class_b)
+{
+    uint64_t port_rate;             /* bits per second */
+    uint64_t idle_a = 0, idle_b = 0;
+    uint64_t frame_a = 0, frame_b = 0;  /* Largest frame per class on the wire, bytes */
+    uint64_t interference;
+    uint32_t i;
+
+    if ((!streams && stream_count > 0) || link_speed_mbps == 0 || !class_a || !class_b) {
+        intel_hal_set_error("Invalid parameters for CBS calculation");
+        return INTEL_HAL_ERROR_INVALID_PARAM;
+    }
+
+    port_rate = (uint64_t)link_speed_mbps * 1000000ULL;
+    interference = max_interference_size ? max_interference_size : SRP_DEFAULT_INTERFERENCE;
+
+    /* Reserved bandwidth per class: wire frame size x frames per class measurement interval */
+    for (i = 0; i < stream_count; i++) {
+        uint64_t wire_frame = (uint64_t)streams[i].max_frame_size + SRP_FRAME_OVERHEAD;
+        uint64_t frames = streams[i].max_interval_frames;
+
+        if (frames == 0 || streams[i].max_frame_size == 0) {
+            intel_hal_set_error("Stream %u has no frames or zero frame size", i);
+            return INTEL_HAL_ERROR_INVALID_PARAM;
+        }
+        if (streams[i].sr_class == INTEL_SR_CLASS_A) {
+            idle_a += wire_frame * 8 * frames * SRP_CLASS_A_INTERVALS;
+            frame_a = wire_frame > frame_a ? wire_frame : frame_a;
+        } else if (streams[i].sr_class == INTEL_SR_CLASS_B) {
+            idle_b += wire_frame * 8 * frames * SRP_CLASS_B_INTERVALS;
+            frame_b = wire_frame > frame_b ? wire_frame : frame_b;
+        } else {
+            intel_hal_set_error("Stream %u has an unknown SR class", i);
+            return INTEL_HAL_ERROR_INVALID_PARAM;
+        }
+    }
+
+    /* Admission control */
+    if ((idle_a + idle_b) * 100 > port_rate * SRP_MAX_BANDWIDTH_PERCENT) {
+        intel_hal_set_error("Reservations need %llu.%02llu%% of the link (limit %u%%)",
+                            (unsigned long long)((idle_a + idle_b) * 100 / port_rate),
+                            (unsigned long long)((idle_a + idle_b) * 10000 / port_rate % 100),
+                            SRP_MAX_BANDWIDTH_PERCENT);
+        return INTEL_HAL_ERROR_NO_BANDWIDTH;
+    }
+
+    /*
+     * Annex L.3, credits in bytes:
+     *   hiCredit_A = maxInterferenceSize * idleSlope_A / portTransmitRate
+     *   loCredit_A = maxFrameSize_A * sendSlope_A / portTransmitRate
+     *   hiCredit_B = idleSlope_B * (maxInterferenceSize / (portTransmitRate - idleSlope_A)
+     *                               + maxFrameSize_A / portTransmitRate)
+     *   loCredit_B = maxFrameSize_B * sendSlope_B / portTransmitRate
+     * sendSlope = idleSlope - portTransmitRate; lo_credit and send_slope hold magnitudes.
+     */
+    memset(class_a, 0, sizeof(*class_a));
+    class_a->traffic_class = INTEL_AVB_CLASS_A;
+    class_a->enabled = idle_a > 0;
+    class_a->idle_slope = (uint32_t)(idle_a / 8);
+    class_a->send_slope = (uint32_t)((port_rate - idle_a) / 8);
+    if (class_a->enabled) {
+        class_a->hi_credit = (uint32_t)ceil_div(interference * idle_a, port_rate);
+        class_a->lo_credit = (uint32_t)ceil_div(frame_a * (port_rate - idle_a), port_rate);
+    }
+
+    memset(class_b, 0, sizeof(*class_b));
+    class_b->traffic_class = INTEL_AVB_CLASS_B;
+    class_b->enabled = idle_b > 0;
+    class_b->idle_slope = (uint32_t)(idle_b / 8);
+    class_b->send_slope = (uint32_t)((port_rate - idle_b) / 8);
+    if (class_b->enabled) {
+        double hi = (double)idle_b * ((double)interference / (double)(port_rate - idle_a) +
+                                      (double)frame_a / (double)port_rate);
+        uint32_t hi_credit = (uint32_t)hi;
+        class_b->hi_credit = (double)hi_credit < hi ? hi_credit + 1 : hi_credit;   /* Round up */
+        class_b->lo_credit = (uint32_t)ceil_div(frame_b * (port_rate - idle_b), port_rate);
+    }
+
+    return INTEL_HAL_SUCCESS;
+}
+
+intel_hal_result_t intel_hal_apply_stream_reservations(intel_device_t *device, const intel_stream_reservation_t *streams,
+                                                       uint32_t stream_count, uint32_t link_speed_mbps)
+{
+    intel_cbs_config_t class_a, class_b;
+    intel_hal_result_t result;
+
+    if (!device) {
+        intel_hal_set_error("Invalid device");
+        return INTEL_HAL_ERROR_INVALID_PARAM;
+    }
+
+    result = intel_hal_calculate_cbs(streams, stream_count, link_speed_mbps, 0, &class_a, &class_b);
+    if (result != INTEL_HAL_SUCCESS) {
+        return result;
+    }
+
+    result = intel_hal_configure_cbs(device, INTEL_AVB_CLASS_A, &class_a);
+    if (result != INTEL_HAL_SUCCESS) {
+        return result;
+    }
+    return intel_hal_configure_cbs(device, INTEL_AVB_CLASS_B, &class_b);
+}
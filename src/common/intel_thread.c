@@ -0,0 +1,342 @@
+/******************************************************************************
+
+  Copyright (c) 2025, Intel Corporation
+  All rights reserved.
+
+  Intel Ethernet HAL - Real-time Worker Threads
+
+  Creates HAL and application worker threads with an explicit CPU set,
+  real-time priority, locked memory and a pre-faulted stack. Without an
+  explicit CPU set, threads are placed on the CPUs of the NIC's NUMA node.
+
+******************************************************************************/
+
+#include "../include/intel_ethernet_hal.h"
+#include "../intel_hal_private.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef INTEL_HAL_LINUX
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#endif
+
+#define INTEL_HAL_THREAD_DEFAULT_STACK  (256u * 1024u)
+
+struct intel_hal_thread {
+    intel_hal_thread_fn_t fn;
+    void *arg;
+    char name[16];
+#ifdef INTEL_HAL_WINDOWS
+    HANDLE handle;
+#endif
+#ifdef INTEL_HAL_LINUX
+    pthread_t handle;
+    void *stack;                        /* Owned stack mapping, including guard page */
+    size_t stack_map_size;
+#endif
+};
+
+void intel_hal_thread_attr_init(intel_hal_thread_attr_t *attr)
+{
+    if (!attr) {
+        return;
+    }
+
+    memset(attr, 0, sizeof(*attr));
+    attr->numa_node = INTEL_HAL_NUMA_NODE_DEVICE;
+}
+
+intel_hal_result_t intel_hal_get_numa_node(intel_device_t *device, int32_t *node)
+{
+    if (!device || !node) {
+        intel_hal_set_error("Invalid parameters for NUMA node query");
+        return INTEL_HAL_ERROR_INVALID_PARAM;
+    }
+
+#ifdef INTEL_HAL_LINUX
+    return intel_linux_get_numa_node(device->info.linux.interface_name, node);
+#else
+    *node = -1;
+    return INTEL_HAL_SUCCESS;
+#endif
+}
+
+static bool cpu_mask_empty(const uint64_t *cpu_mask)
+{
+    uint32_t i;
+
+    for (i = 0; i < INTEL_HAL_THREAD_CPU_WORDS; i++) {
+        if (cpu_mask[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Resolve the CPU set a thread should run on
+ *
+ * @return true if the thread should be pinned to cpu_mask
+ */
+static bool resolve_cpu_mask(intel_device_t *device, const intel_hal_thread_attr_t *attr, uint64_t *cpu_mask)
+{
+    int32_t node = attr->numa_node;
+
+    if (!cpu_mask_empty(attr->cpu_mask)) {
+        memcpy(cpu_mask, attr->cpu_mask, sizeof(attr->cpu_mask));
+        return true;
+    }
+
+    if (node == INTEL_HAL_NUMA_NODE_ANY) {
+        return false;
+    }
+    if (node == INTEL_HAL_NUMA_NODE_DEVICE) {
+        if (!device || intel_hal_get_numa_node(device, &node) != INTEL_HAL_SUCCESS || node < 0) {
+            return false;
+        }
+    }
+
+#ifdef INTEL_HAL_LINUX
+    return intel_linux_get_node_cpus(node, cpu_mask, INTEL_HAL_THREAD_CPU_WORDS) == INTEL_HAL_SUCCESS &&
+           !cpu_mask_empty(cpu_mask);
+#else
+    {
+        GROUP_AFFINITY affinity;
+        memset(cpu_mask, 0, INTEL_HAL_THREAD_CPU_WORDS * sizeof(uint64_t));
+        if (!GetNumaNodeProcessorMaskEx((USHORT)node, &affinity) || affinity.Group != 0) {
+            return false;
+        }
+        cpu_mask[0] = (uint64_t)affinity.Mask;
+        return cpu_mask[0] != 0;
+    }
+#endif
+}
+
+#ifdef INTEL_HAL_LINUX
+static void *intel_hal_thread_entry(void *context)
+{
+    intel_hal_thread_t *thread = (intel_hal_thread_t *)context;
+
+    if (thread->name[0]) {
+        pthread_setname_np(pthread_self(), thread->name);
+    }
+    thread->fn(thread->arg);
+    return NULL;
+}
+
+intel_hal_result_t intel_hal_thread_create(intel_device_t *device, const intel_hal_thread_attr_t *attr,
+                                           intel_hal_thread_fn_t fn, void *arg, intel_hal_thread_t **thread)
+{
+    intel_hal_thread_attr_t defaults;
+    intel_hal_thread_t *new_thread;
+    pthread_attr_t pattr;
+    uint64_t cpu_mask[INTEL_HAL_THREAD_CPU_WORDS];
+    size_t page_size = (size_t)sysconf(_SC_PAGESIZE);
+    size_t stack_size;
+    int rc;
+
+    if (!fn || !thread || (attr && (attr->priority < 0 || attr->priority > 99))) {
+        intel_hal_set_error("Invalid parameters for thread creation");
+        return INTEL_HAL_ERROR_INVALID_PARAM;
+    }
+    if (!attr) {
+        intel_hal_thread_attr_init(&defaults);
+        attr = &defaults;
+    }
+
+    new_thread = (intel_hal_thread_t *)calloc(1, sizeof(*new_thread));
+    if (!new_thread) {
+        intel_hal_set_error("Out of memory creating thread");
+        return INTEL_HAL_ERROR_NO_MEMORY;
+    }
+    new_thread->fn = fn;
+    new_thread->arg = arg;
+    if (attr->name) {
+        snprintf(new_thread->name, sizeof(new_thread->name), "%s", attr->name);
+    }
+
+    if (attr->lock_memory && mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+        intel_hal_set_error("mlockall failed: %s", strerror(errno));
+        free(new_thread);
+        return INTEL_HAL_ERROR_ACCESS_DENIED;
+    }
+
+    pthread_attr_init(&pattr);
+
+    /* Own the stack so it can be pre-faulted (and locked) before the thread runs */
+    stack_size = attr->stack_size ? attr->stack_size : INTEL_HAL_THREAD_DEFAULT_STACK;
+    stack_size = (stack_size + page_size - 1) & ~(page_size - 1);
+    new_thread->stack_map_size = stack_size + page_size;
+    new_thread->stack = mmap(NULL, new_thread->stack_map_size, PROT_READ | PROT_WRITE,
+                             MAP_PRIVATE | MAP_ANONYMOUS | MAP_STACK |
+                             (attr->lock_memory ? MAP_POPULATE : 0), -1, 0);
+    if (new_thread->stack == MAP_FAILED) {
+        intel_hal_set_error("Thread stack allocation failed: %s", strerror(errno));
+        pthread_attr_destroy(&pattr);
+        free(new_thread);
+        return INTEL_HAL_ERROR_NO_MEMORY;
+    }
+    mprotect(new_thread->stack, page_size, PROT_NONE);   /* Guard page below the stack */
+    if (attr->lock_memory) {
+        memset((uint8_t *)new_thread->stack + page_size, 0, stack_size);
+    }
+    rc = pthread_attr_setstack(&pattr, (uint8_t *)new_thread->stack + page_size, stack_size);
+    if (rc != 0) {
+        intel_hal_set_error("Thread stack of %zu bytes rejected: %s", stack_size, strerror(rc));
+        goto attr_failed;
+    }
+
+    if (attr->priority > 0) {
+        struct sched_param param;
+        memset(&param, 0, sizeof(param));
+        param.sched_priority = attr->priority;
+        rc = pthread_attr_setinheritsched(&pattr, PTHREAD_EXPLICIT_SCHED);
+        if (rc == 0) {
+            rc = pthread_attr_setschedpolicy(&pattr, SCHED_FIFO);
+        }
+        if (rc == 0) {
+            rc = pthread_attr_setschedparam(&pattr, &param);
+        }
+        if (rc != 0) {
+            intel_hal_set_error("SCHED_FIFO priority %d rejected: %s", attr->priority, strerror(rc));
+            goto attr_failed;
+        }
+    }
+
+    if (resolve_cpu_mask(device, attr, cpu_mask)) {
+        cpu_set_t cpus;
+        uint32_t cpu;
+        CPU_ZERO(&cpus);
+        for (cpu = 0; cpu < INTEL_HAL_THREAD_CPU_WORDS * 64 && cpu < CPU_SETSIZE; cpu++) {
+            if (cpu_mask[cpu / 64] & (1ULL << (cpu % 64))) {
+                CPU_SET(cpu, &cpus);
+            }
+        }
+        rc = pthread_attr_setaffinity_np(&pattr, sizeof(cpus), &cpus);
+        if (rc != 0) {
+            intel_hal_set_error("CPU affinity rejected: %s", strerror(rc));
+            goto attr_failed;
+        }
+    }
+
+    rc = pthread_create(&new_thread->handle, &pattr, intel_hal_thread_entry, new_thread);
+    pthread_attr_destroy(&pattr);
+    if (rc != 0) {
+        intel_hal_set_error("pthread_create failed: %s", strerror(rc));
+        munmap(new_thread->stack, new_thread->stack_map_size);
+        free(new_thread);
+        return rc == EPERM ? INTEL_HAL_ERROR_ACCESS_DENIED : INTEL_HAL_ERROR_OS_SPECIFIC;
+    }
+
+    *thread = new_thread;
+    return INTEL_HAL_SUCCESS;
+
+attr_failed:
+    pthread_attr_destroy(&pattr);
+    munmap(new_thread->stack, new_thread->stack_map_size);
+    free(new_thread);
+    return INTEL_HAL_ERROR_INVALID_PARAM;
+}
+
+intel_hal_result_t intel_hal_thread_join(intel_hal_thread_t *thread)
+{
+    int rc;
+
+    if (!thread) {
+        return INTEL_HAL_ERROR_INVALID_PARAM;
+    }
+
+    rc = pthread_join(thread->handle, NULL);
+    if (rc != 0) {
+        intel_hal_set_error("pthread_join failed: %s", strerror(rc));
+        return INTEL_HAL_ERROR_OS_SPECIFIC;
+    }
+
+    munmap(thread->stack, thread->stack_map_size);
+    free(thread);
+    return INTEL_HAL_SUCCESS;
+}
+#endif /* INTEL_HAL_LINUX */
+
+#ifdef INTEL_HAL_WINDOWS
+static DWORD WINAPI intel_hal_thread_entry(LPVOID context)
+{
+    intel_hal_thread_t *thread = (intel_hal_thread_t *)context;
+
+    thread->fn(thread->arg);
+    return 0;
+}
+
+intel_hal_result_t intel_hal_thread_create(intel_device_t *device, const intel_hal_thread_attr_t *attr,
+                                           intel_hal_thread_fn_t fn, void *arg, intel_hal_thread_t **thread)
+{
+    intel_hal_thread_attr_t defaults;
+    intel_hal_thread_t *new_thread;
+    uint64_t cpu_mask[INTEL_HAL_THREAD_CPU_WORDS];
+    size_t stack_size;
+
+    if (!fn || !thread || (attr && (attr->priority < 0 || attr->priority > 99))) {
+        intel_hal_set_error("Invalid parameters for thread creation");
+        return INTEL_HAL_ERROR_INVALID_PARAM;
+    }
+    if (!attr) {
+        intel_hal_thread_attr_init(&defaults);
+        attr = &defaults;
+    }
+
+    new_thread = (intel_hal_thread_t *)calloc(1, sizeof(*new_thread));
+    if (!new_thread) {
+        intel_hal_set_error("Out of memory creating thread");
+        return INTEL_HAL_ERROR_NO_MEMORY;
+    }
+    new_thread->fn = fn;
+    new_thread->arg = arg;
+
+    /* Windows has no mlockall; committing the full stack pre-faults it */
+    stack_size = attr->stack_size ? attr->stack_size : INTEL_HAL_THREAD_DEFAULT_STACK;
+    new_thread->handle = CreateThread(NULL, stack_size, intel_hal_thread_entry, new_thread,
+                                      CREATE_SUSPENDED | (attr->lock_memory ? 0 : STACK_SIZE_PARAM_IS_A_RESERVATION),
+                                      NULL);
+    if (!new_thread->handle) {
+        intel_hal_set_error("CreateThread failed: %u", (unsigned int)GetLastError());
+        free(new_thread);
+        return INTEL_HAL_ERROR_OS_SPECIFIC;
+    }
+
+    if (resolve_cpu_mask(device, attr, cpu_mask) && cpu_mask[0]) {
+        SetThreadAffinityMask(new_thread->handle, (DWORD_PTR)cpu_mask[0]);
+    }
+    if (attr->priority > 0 && !SetThreadPriority(new_thread->handle, THREAD_PRIORITY_TIME_CRITICAL)) {
+        intel_hal_set_error("SetThreadPriority failed: %u", (unsigned int)GetLastError());
+        TerminateThread(new_thread->handle, 0);
+        CloseHandle(new_thread->handle);
+        free(new_thread);
+        return INTEL_HAL_ERROR_ACCESS_DENIED;
+    }
+
+    ResumeThread(new_thread->handle);
+    *thread = new_thread;
+    return INTEL_HAL_SUCCESS;
+}
+
+intel_hal_result_t intel_hal_thread_join(intel_hal_thread_t *thread)
+{
+    if (!thread) {
+        return INTEL_HAL_ERROR_INVALID_PARAM;
+    }
+
+    if (WaitForSingleObject(thread->handle, INFINITE) != WAIT_OBJECT_0) {
+        intel_hal_set_error("WaitForSingleObject failed: %u", (unsigned int)GetLastError());
+        return INTEL_HAL_ERROR_OS_SPECIFIC;
+    }
+
+    CloseHandle(thread->handle);
+    free(thread);
+    return INTEL_HAL_SUCCESS;
+}
+#endif /* INTEL_HAL_WINDOWS */
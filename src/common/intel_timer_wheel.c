@@ -0,0 +1,299 @@
+/******************************************************************************
+
+  Copyright (c) 2025, Intel Corporation
+  All rights reserved.
+
+  Intel Ethernet HAL - Hierarchical Timing Wheel
+
+  Four levels of 256 slots. Level 0 slots are one tick wide; each higher
+  level slot covers a full rotation of the level below and is cascaded down
+  when the lower level wraps. Insert and cancel are O(1); advancing skips
+  empty slots through per-level occupancy bitmaps. Used by the PHC-time
+  scheduler and the launch-time transmit scheduler.
+
+******************************************************************************/
+
+#include "../include/intel_ethernet_hal.h"
+#include "../intel_hal_private.h"
+#include <string.h>
+
+#define WHEEL_BITS      8
+#define WHEEL_MASK      (INTEL_TIMER_WHEEL_SLOTS - 1)
+
+static uint32_t find_first_set(uint64_t value)
+{
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward64(&index, value);
+    return (uint32_t)index;
+#else
+    return (uint32_t)__builtin_ctzll(value);
+#endif
+}
+
+/**
+ * @brief Find the first occupied slot at or after 'from' in a level
+ *
+ * @return Slot index, or INTEL_TIMER_WHEEL_SLOTS if none
+ */
+static uint32_t next_occupied(const uint64_t *bitmap, uint32_t from)
+{
+    uint32_t word = from / 64;
+    uint64_t bits;
+
+    if (from >= INTEL_TIMER_WHEEL_SLOTS) {
+        return INTEL_TIMER_WHEEL_SLOTS;
+    }
+
+    bits = bitmap[word] & (~0ULL << (from % 64));
+    for (;;) {
+        if (bits) {
+            return word * 64 + find_first_set(bits);
+        }
+        if (++word == INTEL_TIMER_WHEEL_SLOTS / 64) {
+            return INTEL_TIMER_WHEEL_SLOTS;
+        }
+        bits = bitmap[word];
+    }
+}
+
+static void list_append(intel_timer_node_t *head, intel_timer_node_t *node)
+{
+    node->prev = head->prev;
+    node->next = head;
+    head->prev->next = node;
+    head->prev = node;
+}
+
+static void place_node(intel_timer_wheel_t *wheel, intel_timer_node_t *node)
+{
+    uint64_t tick = node->expires >> wheel->granularity_shift;
+    uint64_t delta;
+    uint32_t level;
+    uint32_t slot;
+
+    if (tick < wheel->current_tick) {
+        /* Already due: its slot has been passed, so the next advance expires it */
+        list_append(&wheel->due, node);
+        return;
+    }
+    delta = tick - wheel->current_tick;
+
+    for (level = 0; level < INTEL_TIMER_WHEEL_LEVELS - 1; level++) {
+        if (delta < (1ULL << (WHEEL_BITS * (level + 1)))) {
+            break;
+        }
+    }
+    if (delta >= (1ULL << (WHEEL_BITS * INTEL_TIMER_WHEEL_LEVELS))) {
+        /* Beyond the wheel span: park in the last top-level slot, re-placed on cascade */
+        tick = wheel->current_tick + (1ULL << (WHEEL_BITS * INTEL_TIMER_WHEEL_LEVELS)) - 1;
+    }
+
+    slot = (uint32_t)(tick >> (WHEEL_BITS * level)) & WHEEL_MASK;
+    list_append(&wheel->slots[level][slot], node);
+    wheel->occupied[level][slot / 64] |= 1ULL << (slot % 64);
+}
+
+/**
+ * @brief Earliest tick at which an occupied slot of level >= first_level
+ *        expires (level 0) or cascades (higher levels)
+ *
+ * @return UINT64_MAX if those levels are empty
+ */
+static uint64_t next_event_tick(const intel_timer_wheel_t *wheel, uint32_t first_level)
+{
+    uint64_t best = UINT64_MAX;
+    uint32_t level;
+
+    for (level = first_level; level < INTEL_TIMER_WHEEL_LEVELS; level++) {
+        uint32_t shift = WHEEL_BITS * level;
+        uint64_t position = wheel->current_tick >> shift;
+        uint32_t index = (uint32_t)position & WHEEL_MASK;
+        uint64_t lower_mask = (1ULL << shift) - 1;
+        /* A higher-level slot cascades when the level below wraps; the current one has
+         * cascaded unless current_tick sits exactly on that boundary */
+        uint32_t first = (wheel->current_tick & lower_mask) == 0 ? index : index + 1;
+        uint32_t slot = next_occupied(wheel->occupied[level], first);
+        uint64_t distance;
+        uint64_t tick;
+
+        if (slot == INTEL_TIMER_WHEEL_SLOTS) {
+            /* Wrapped slots belong to the next rotation of this level */
+            slot = next_occupied(wheel->occupied[level], 0);
+            if (slot >= first) {
+                continue;
+            }
+            distance = INTEL_TIMER_WHEEL_SLOTS - index + slot;
+        } else {
+            distance = slot - index;
+        }
+
+        tick = level == 0 ? wheel->current_tick + distance : (position + distance) << shift;
+        if (tick < best) {
+            best = tick;
+        }
+    }
+
+    return best;
+}
+
+/**
+ * @brief Re-place all nodes of one higher-level slot into lower levels
+ */
+static void cascade(intel_timer_wheel_t *wheel, uint32_t level)
+{
+    uint32_t slot = (uint32_t)(wheel->current_tick >> (WHEEL_BITS * level)) & WHEEL_MASK;
+    intel_timer_node_t *head = &wheel->slots[level][slot];
+    intel_timer_node_t *node = head->next;
+
+    head->next = head->prev = head;
+    wheel->occupied[level][slot / 64] &= ~(1ULL << (slot % 64));
+
+    while (node != head) {
+        intel_timer_node_t *next = node->next;
+        place_node(wheel, node);
+        node = next;
+    }
+}
+
+void intel_timer_wheel_init(intel_timer_wheel_t *wheel, uint64_t now_ns, uint32_t granularity_shift)
+{
+    uint32_t level;
+    uint32_t slot;
+
+    memset(wheel->occupied, 0, sizeof(wheel->occupied));
+    wheel->due.next = wheel->due.prev = &wheel->due;
+    for (level = 0; level < INTEL_TIMER_WHEEL_LEVELS; level++) {
+        for (slot = 0; slot < INTEL_TIMER_WHEEL_SLOTS; slot++) {
+            wheel->slots[level][slot].next = &wheel->slots[level][slot];
+            wheel->slots[level][slot].prev = &wheel->slots[level][slot];
+        }
+    }
+    wheel->granularity_shift = granularity_shift;
+    wheel->current_tick = now_ns >> granularity_shift;
+    wheel->count = 0;
+}
+
+void intel_timer_wheel_add(intel_timer_wheel_t *wheel, intel_timer_node_t *node)
+{
+    place_node(wheel, node);
+    wheel->count++;
+}
+
+void intel_timer_wheel_remove(intel_timer_wheel_t *wheel, intel_timer_node_t *node)
+{
+    /* A slot head whose list becomes empty keeps its occupancy bit until visited */
+    node->prev->next = node->next;
+    node->next->prev = node->prev;
+    node->next = node->prev = node;
+    wheel->count--;
+}
+
+/**
+ * @brief Expire all nodes due at or before now_ns
+ *
+ * Expired nodes are moved, in slot order, onto the circular list headed by
+ * 'expired' (which must be initialized to point to itself).
+ *
+ * @return Number of expired nodes
+ */
+uint32_t intel_timer_wheel_advance(intel_timer_wheel_t *wheel, uint64_t now_ns, intel_timer_node_t *expired)
+{
+    uint64_t now_tick = now_ns >> wheel->granularity_shift;
+    uint32_t expired_count = 0;
+
+    if (wheel->count == 0) {
+        if (now_tick >= wheel->current_tick) {
+            wheel->current_tick = now_tick + 1;
+        }
+        return 0;
+    }
+
+    while (wheel->due.next != &wheel->due) {
+        intel_timer_node_t *node = wheel->due.next;
+        node->prev->next = node->next;
+        node->next->prev = node->prev;
+        list_append(expired, node);
+        wheel->count--;
+        expired_count++;
+    }
+
+    while (wheel->current_tick <= now_tick) {
+        uint32_t index = (uint32_t)wheel->current_tick & WHEEL_MASK;
+        uint32_t slot;
+        intel_timer_node_t *head;
+        intel_timer_node_t *node;
+
+        if (index == 0) {
+            uint32_t level;
+            for (level = INTEL_TIMER_WHEEL_LEVELS - 1; level > 0; level--) {
+                uint64_t lower_mask = (1ULL << (WHEEL_BITS * level)) - 1;
+                if ((wheel->current_tick & lower_mask) == 0) {
+                    cascade(wheel, level);
+                }
+            }
+        }
+
+        slot = next_occupied(wheel->occupied[0], index);
+        if (slot == INTEL_TIMER_WHEEL_SLOTS) {
+            /* Nothing left in this rotation: jump to the next expiry or cascade */
+            uint64_t next = next_event_tick(wheel, 0);
+            uint64_t boundary = wheel->current_tick + (INTEL_TIMER_WHEEL_SLOTS - index);
+            if (next < boundary) {
+                next = boundary;
+            }
+            wheel->current_tick = next <= now_tick ? next : now_tick + 1;
+            continue;
+        }
+        if (wheel->current_tick + (slot - index) > now_tick) {
+            wheel->current_tick = now_tick + 1;
+            break;
+        }
+        wheel->current_tick += slot - index;
+
+        head = &wheel->slots[0][slot];
+        wheel->occupied[0][slot / 64] &= ~(1ULL << (slot % 64));
+        node = head->next;
+        while (node != head) {
+            intel_timer_node_t *next = node->next;
+            list_append(expired, node);
+            wheel->count--;
+            expired_count++;
+            node = next;
+        }
+        head->next = head->prev = head;
+        wheel->current_tick++;
+    }
+
+    return expired_count;
+}
+
+/**
+ * @brief Get a lower bound on the earliest pending expiry
+ *
+ * Exact for nodes in level 0; for higher levels returns the time the slot
+ * cascades, at which point the caller advances and asks again.
+ *
+ * @return false if the wheel is empty
+ */
+bool intel_timer_wheel_next_expiry(const intel_timer_wheel_t *wheel, uint64_t *expiry_ns)
+{
+    uint64_t tick;
+
+    if (wheel->count == 0) {
+        return false;
+    }
+    if (wheel->due.next != &wheel->due) {
+        /* Overdue: report the last tick already advanced over */
+        *expiry_ns = (wheel->current_tick - 1) << wheel->granularity_shift;
+        return true;
+    }
+
+    tick = next_event_tick(wheel, 0);
+    if (tick == UINT64_MAX) {
+        /* Only stale occupancy bits remain */
+        tick = wheel->current_tick;
+    }
+    *expiry_ns = tick << wheel->granularity_shift;
+    return true;
+}
@@ -0,0 +1,235 @@
+/******************************************************************************
+
+  Copyright (c) 2025, Intel Corporation
+  All rights reserved.
+
+  Intel Ethernet HAL - TSN Schedule Synthesis
+
+  Builds an 802.1Qbv gate schedule and per-stream launch offsets for a set
+  of periodic streams. The gate cycle is the GCD of the stream periods, so
+  the schedule needs one exclusive window per scheduled traffic class plus
+  a best-effort window and its guard band, independent of the stream
+  count. Streams are packed greedily in earliest-deadline order into the
+  cycles of the hyperperiod, choosing the cycle phase that grows their
+  class window least while meeting the deadline.
+
+******************************************************************************/
+
+#include "../include/intel_ethernet_hal.h"
+#include "../intel_hal_private.h"
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    uint64_t deadline;
+    uint64_t period;
+    uint32_t index;
+} synth_order_t;
+
+static int compare_deadline(const void *a, const void *b)
+{
+    const synth_order_t *x = (const synth_order_t *)a;
+    const synth_order_t *y = (const synth_order_t *)b;
+
+    if (x->deadline != y->deadline) {
+        return x->deadline < y->deadline ? -1 : 1;
+    }
+    if (x->period != y->period) {
+        return x->period < y->period ? -1 : 1;
+    }
+    return x->index < y->index ? -1 : (x->index > y->index);
+}
+
+static uint64_t gcd_u64(uint64_t a, uint64_t b)
+{
+    while (b != 0) {
+        uint64_t t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+intel_hal_result_t intel_hal_tsn_synthesize(const intel_tsn_synth_config_t *config,
+                                            const intel_tsn_stream_t *streams, uint32_t stream_count,
+                                            intel_tsn_stream_slot_t *slots, intel_tas_config_t *tas)
+{
+    synth_order_t *order = NULL;
+    uint64_t *load = NULL;              /* [tc][cycle] occupied time from the window start */
+    uint32_t *phase = NULL;
+    uint64_t *position = NULL;
+    uint64_t window[8] = {0};
+    uint64_t window_start[8] = {0};
+    uint8_t tc_order[8];
+    uint32_t tc_count = 0;
+    uint64_t cycle = 0;
+    uint64_t cycles = 1;
+    uint64_t offset = 0;
+    uint64_t guard = 0;
+    uint8_t scheduled = 0;
+    intel_hal_result_t result = INTEL_HAL_SUCCESS;
+    uint32_t i, t;
+
+    if (!config || !streams || !slots || !tas || stream_count == 0 || config->link_speed_mbps == 0) {
+        intel_hal_set_error("Invalid parameters for schedule synthesis");
+        return INTEL_HAL_ERROR_INVALID_PARAM;
+    }
+    for (i = 0; i < stream_count; i++) {
+        if (streams[i].period_ns == 0 || streams[i].frame_size == 0 || streams[i].traffic_class > 7) {
+            intel_hal_set_error("Stream %u has no period, no frame size or an invalid traffic class", i);
+            return INTEL_HAL_ERROR_INVALID_PARAM;
+        }
+        cycle = gcd_u64(cycle, streams[i].period_ns);
+        scheduled |= (uint8_t)(1u << streams[i].traffic_class);
+    }
+    if (config->best_effort_gates & scheduled) {
+        intel_hal_set_error("Best-effort gates 0x%02X overlap the scheduled traffic classes 0x%02X",
+                            config->best_effort_gates, scheduled);
+        return INTEL_HAL_ERROR_INVALID_PARAM;
+    }
+    if (cycle > UINT32_MAX) {
+        intel_hal_set_error("Gate cycle of %llu ns exceeds the 32-bit gate interval", (unsigned long long)cycle);
+        return INTEL_HAL_ERROR_NOT_SUPPORTED;
+    }
+
+    /* Hyperperiod in gate cycles */
+    for (i = 0; i < stream_count; i++) {
+        uint64_t k = streams[i].period_ns / cycle;
+        cycles = cycles / gcd_u64(cycles, k) * k;
+        if (cycles > INTEL_TSN_SYNTH_MAX_CYCLES) {
+            intel_hal_set_error("Hyperperiod exceeds %u gate cycles of %llu ns",
+                                INTEL_TSN_SYNTH_MAX_CYCLES, (unsigned long long)cycle);
+            return INTEL_HAL_ERROR_NOT_SUPPORTED;
+        }
+    }
+
+    order = (synth_order_t *)malloc(stream_count * sizeof(*order));
+    phase = (uint32_t *)malloc(stream_count * sizeof(*phase));
+    position = (uint64_t *)malloc(stream_count * sizeof(*position));
+    load = (uint64_t *)calloc(8 * cycles, sizeof(*load));
+    if (!order || !phase || !position || !load) {
+        intel_hal_set_error("Out of memory in schedule synthesis");
+        result = INTEL_HAL_ERROR_NO_MEMORY;
+        goto out;
+    }
+
+    for (i = 0; i < stream_count; i++) {
+        order[i].deadline = streams[i].deadline_ns ? streams[i].deadline_ns : streams[i].period_ns;
+        order[i].period = streams[i].period_ns;
+        order[i].index = i;
+    }
+    qsort(order, stream_count, sizeof(*order), compare_deadline);
+
+    /* Class windows in the cycle, in order of their earliest stream deadline */
+    for (i = 0; i < stream_count; i++) {
+        uint8_t tc = streams[order[i].index].traffic_class;
+        for (t = 0; t < tc_count && tc_order[t] != tc; t++) {
+        }
+        if (t == tc_count) {
+            tc_order[tc_count++] = tc;
+        }
+    }
+
+    /* Earliest-deadline packing into the hyperperiod cycles */
+    for (i = 0; i < stream_count; i++) {
+        const intel_tsn_stream_t *stream = &streams[order[i].index];
+        uint64_t *tc_load = &load[stream->traffic_class * cycles];
+        uint64_t k = stream->period_ns / cycle;
+        uint64_t frame = intel_wire_time_ns(stream->frame_size, config->link_speed_mbps);
+        uint64_t before = 0;            /* Current size of the windows ahead of this class */
+        uint64_t best_position = 0;
+        uint64_t best_completion = UINT64_MAX;
+        uint32_t best_phase = 0;
+        bool best_feasible = false;
+        uint64_t p, j;
+
+        for (t = 0; tc_order[t] != stream->traffic_class; t++) {
+            before += window[tc_order[t]];
+        }
+
+        for (p = 0; p < k; p++) {
+            uint64_t start = 0;
+            uint64_t completion;
+            bool feasible;
+
+            for (j = p; j < cycles; j += k) {
+                if (tc_load[j] > start) {
+                    start = tc_load[j];
+                }
+            }
+            completion = p * cycle + before + start + frame;
+            feasible = completion <= order[i].deadline;
+
+            /* Prefer meeting the deadline, then the smallest window growth, then the earliest phase */
+            if ((feasible && !best_feasible) ||
+                (feasible == best_feasible &&
+                 (feasible ? start < best_position : completion < best_completion))) {
+                best_feasible = feasible;
+                best_position = start;
+                best_completion = completion;
+                best_phase = (uint32_t)p;
+            }
+        }
+
+        phase[order[i].index] = best_phase;
+        position[order[i].index] = best_position;
+        for (j = best_phase; j < cycles; j += k) {
+            tc_load[j] = best_position + frame;
+        }
+        if (best_position + frame > window[stream->traffic_class]) {
+            window[stream->traffic_class] = best_position + frame;
+        }
+    }
+
+    for (t = 0; t < tc_count; t++) {
+        window_start[tc_order[t]] = offset;
+        offset += window[tc_order[t]];
+    }
+    if (config->best_effort_gates) {
+        guard = intel_wire_time_ns(config->guard_frame_size, config->link_speed_mbps);
+    }
+    if (offset > cycle || tc_count + (config->best_effort_gates ? 2 : 1) > INTEL_HAL_TAS_MAX_ENTRIES) {
+        intel_hal_set_error("Scheduled traffic needs %llu ns in %u windows of the %llu ns cycle",
+                            (unsigned long long)offset, tc_count, (unsigned long long)cycle);
+        result = INTEL_HAL_ERROR_NOT_SUPPORTED;
+        goto out;
+    }
+
+    for (i = 0; i < stream_count; i++) {
+        uint64_t deadline = streams[i].deadline_ns ? streams[i].deadline_ns : streams[i].period_ns;
+        slots[i].launch_offset_ns = phase[i] * cycle + window_start[streams[i].traffic_class] + position[i];
+        slots[i].latency_ns = slots[i].launch_offset_ns + intel_wire_time_ns(streams[i].frame_size, config->link_speed_mbps);
+        if (slots[i].latency_ns > deadline) {
+            intel_hal_set_error("Stream %u misses its deadline (%llu > %llu ns)", i,
+                                (unsigned long long)slots[i].latency_ns, (unsigned long long)deadline);
+            result = INTEL_HAL_ERROR_NOT_SUPPORTED;
+            goto out;
+        }
+    }
+
+    /* Class windows, then best effort and its guard band (all closed) until the cycle wraps */
+    memset(tas, 0, sizeof(*tas));
+    tas->base_time = config->base_time;
+    tas->cycle_time = cycle;
+    for (t = 0; t < tc_count; t++) {
+        tas->gate_control_list[t].gate_states = (uint8_t)(1u << tc_order[t]);
+        tas->gate_control_list[t].time_interval = (uint32_t)window[tc_order[t]];
+    }
+    tas->gate_control_list_length = tc_count;
+    if (offset + guard < cycle && config->best_effort_gates) {
+        tas->gate_control_list[tas->gate_control_list_length].gate_states = config->best_effort_gates;
+        tas->gate_control_list[tas->gate_control_list_length++].time_interval = (uint32_t)(cycle - offset - guard);
+        offset = cycle - guard;
+    }
+    if (offset < cycle) {
+        tas->gate_control_list[tas->gate_control_list_length].gate_states = 0;
+        tas->gate_control_list[tas->gate_control_list_length++].time_interval = (uint32_t)(cycle - offset);
+    }
+
+out:
+    free(order);
+    free(phase);
+    free(position);
+    free(load);
+    return result;
+}
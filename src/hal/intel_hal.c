@@ -16,6 +16,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdarg.h>
+#include <ctype.h>
 #include <inttypes.h>
 
 /* Include intel_avb for hardware register access */
@@ -51,6 +52,8 @@ extern bool intel_windows_has_modern_ndis_support(void);
 #endif
 
 #ifdef INTEL_HAL_LINUX
+#include <net/if.h>     /* For if_nametoindex */
+
 extern intel_hal_result_t intel_linux_init_device(intel_device_t *device, uint16_t device_id);
 extern void intel_linux_cleanup_device(intel_device_t *device);
 extern intel_hal_result_t intel_linux_read_timestamp(intel_device_t *device, intel_timestamp_t *timestamp);
@@ -69,7 +72,7 @@ static bool hal_initialized = false;
 static char hal_last_error[512] = {0};
 
 /* Internal helper functions */
-static void set_hal_error(const char *format, ...)
+void intel_hal_set_error(const char *format, ...)
 {
     va_list args;
     va_start(args, format);
@@ -121,14 +124,17 @@ intel_hal_result_t intel_hal_init(void)
     hal_initialized = true;
     
     /* Print supported devices */
-    uint16_t device_ids[32];
-    uint32_t count = sizeof(device_ids) / sizeof(device_ids[0]);
-    
-    if (intel_get_supported_devices(device_ids, &count) == INTEL_HAL_SUCCESS) {
-        printf("Supported devices: %u\n", count);
-        for (uint32_t i = 0; i < count; i++) {
-            printf("  - 0x%04x\n", device_ids[i]);
+    uint32_t count = 0;
+    
+    if (intel_get_supported_devices(NULL, &count) == INTEL_HAL_SUCCESS && count > 0) {
+        uint16_t *device_ids = (uint16_t *)malloc(count * sizeof(uint16_t));
+        if (device_ids && intel_get_supported_devices(device_ids, &count) == INTEL_HAL_SUCCESS) {
+            printf("Supported devices: %u\n", count);
+            for (uint32_t i = 0; i < count; i++) {
+                printf("  - 0x%04x\n", device_ids[i]);
+            }
         }
+        free(device_ids);
     }
     
     printf("Intel Ethernet HAL initialized successfully\n");
@@ -145,60 +151,133 @@ void intel_hal_cleanup(void)
     hal_initialized = false;
 }
 
+/**
+ * @brief Enumerate device records on this platform
+ */
+static intel_hal_result_t platform_enumerate_records(intel_device_record_t *records, uint32_t capacity, uint32_t *total)
+{
+#ifdef INTEL_HAL_WINDOWS
+    intel_hal_result_t result = intel_windows_enumerate_records(records, capacity, total);
+    if (result != INTEL_HAL_SUCCESS) {
+        intel_hal_set_error("Windows device enumeration failed: %s", intel_windows_get_last_error());
+    }
+    return result;
+#endif
+
+#ifdef INTEL_HAL_LINUX
+    return intel_linux_enumerate_records(records, capacity, total);
+#endif
+}
+
+/**
+ * @brief Enumerate all device records into a heap array sized to the system
+ *
+ * @param[out] records Array to release with free() (NULL if no devices)
+ * @param[out] count Number of records
+ */
+static intel_hal_result_t enumerate_all_records(intel_device_record_t **records, uint32_t *count)
+{
+    intel_device_record_t *buffer = NULL;
+    uint32_t capacity = 0;
+    uint32_t total = 0;
+    intel_hal_result_t result;
+    
+    /* Retry if adapters appear between sizing and filling */
+    for (;;) {
+        result = platform_enumerate_records(buffer, capacity, &total);
+        if (result != INTEL_HAL_SUCCESS || total <= capacity) {
+            break;
+        }
+        free(buffer);
+        capacity = total + 4;
+        buffer = (intel_device_record_t *)malloc(capacity * sizeof(intel_device_record_t));
+        if (!buffer) {
+            intel_hal_set_error("Out of memory enumerating %u devices", total);
+            return INTEL_HAL_ERROR_NO_MEMORY;
+        }
+    }
+    
+    if (result != INTEL_HAL_SUCCESS) {
+        free(buffer);
+        return result;
+    }
+    
+    *records = buffer;
+    *count = total;
+    return INTEL_HAL_SUCCESS;
+}
+
+/**
+ * @brief Bind a device to the adapter instance described by a record
+ */
+static intel_hal_result_t platform_init_instance(intel_device_t *device, const intel_device_record_t *record)
+{
+#ifdef INTEL_HAL_WINDOWS
+    intel_hal_result_t result = intel_windows_init_device_instance(device, record);
+    if (result != INTEL_HAL_SUCCESS) {
+        intel_hal_set_error("Windows device initialization failed: %s", intel_windows_get_last_error());
+    }
+    return result;
+#endif
+
+#ifdef INTEL_HAL_LINUX
+    return intel_linux_init_device_instance(device, record);
+#endif
+}
+
+static void platform_cleanup(intel_device_t *device)
+{
+#ifdef INTEL_HAL_WINDOWS
+    intel_windows_cleanup_device(device);
+#endif
+
+#ifdef INTEL_HAL_LINUX
+    intel_linux_cleanup_device(device);
+#endif
+}
+
 intel_hal_result_t intel_hal_enumerate_devices(intel_device_info_t *devices, uint32_t *count)
 {
-    uint16_t device_ids[32];
-    uint32_t device_count, i;
+    intel_device_record_t *records = NULL;
+    uint32_t record_count = 0;
+    uint32_t found_count = 0;
+    uint32_t i;
     intel_hal_result_t result;
     
     if (!hal_initialized) {
-        set_hal_error("HAL not initialized");
+        intel_hal_set_error("HAL not initialized");
         return INTEL_HAL_ERROR_INVALID_PARAM;
     }
     
     if (!count) {
-        set_hal_error("Count parameter is NULL");
+        intel_hal_set_error("Count parameter is NULL");
         return INTEL_HAL_ERROR_INVALID_PARAM;
     }
     
-    /* Get supported device list */
-    device_count = sizeof(device_ids) / sizeof(device_ids[0]);
-    result = intel_get_supported_devices(device_ids, &device_count);
+    /* One pass over the adapters present; every instance is reported */
+    result = enumerate_all_records(&records, &record_count);
     if (result != INTEL_HAL_SUCCESS) {
-        set_hal_error("Failed to get supported devices");
         return result;
     }
     
-    /* Try to find each device on the system */
-    uint32_t found_count = 0;
-    uint32_t max_devices = *count;
+    if (!devices) {
+        free(records);
+        *count = record_count;
+        return INTEL_HAL_SUCCESS;
+    }
     
-    for (i = 0; i < device_count && found_count < max_devices; i++) {
-        intel_device_t *device = intel_device_create(device_ids[i]);
+    for (i = 0; i < record_count && found_count < *count; i++) {
+        intel_device_t *device = intel_device_create(records[i].device_id);
         if (device) {
-            /* Try platform-specific initialization to see if device exists */
-#ifdef INTEL_HAL_WINDOWS
-            if (intel_windows_init_device(device, device_ids[i]) == INTEL_HAL_SUCCESS) {
-                if (devices) {
-                    memcpy(&devices[found_count], &device->info, sizeof(intel_device_info_t));
-                }
-                found_count++;
-                intel_windows_cleanup_device(device);
-            }
-#endif
-
-#ifdef INTEL_HAL_LINUX
-            if (intel_linux_init_device(device, device_ids[i]) == INTEL_HAL_SUCCESS) {
-                if (devices) {
-                    memcpy(&devices[found_count], &device->info, sizeof(intel_device_info_t));
-                }
+            if (platform_init_instance(device, &records[i]) == INTEL_HAL_SUCCESS) {
+                memcpy(&devices[found_count], &device->info, sizeof(intel_device_info_t));
                 found_count++;
-                intel_linux_cleanup_device(device);
+                platform_cleanup(device);
             }
-#endif
             intel_device_destroy(device);
         }
     }
+    free(records);
     
     *count = found_count;
     printf("HAL: Found %u Intel devices\n", found_count);
@@ -206,6 +285,128 @@ intel_hal_result_t intel_hal_enumerate_devices(intel_device_info_t *devices, uin
     return INTEL_HAL_SUCCESS;
 }
 
+intel_hal_result_t intel_hal_enumerate_records(intel_device_record_t *records, uint32_t *count)
+{
+    uint32_t capacity;
+    uint32_t total = 0;
+    intel_hal_result_t result;
+    
+    if (!hal_initialized) {
+        intel_hal_set_error("HAL not initialized");
+        return INTEL_HAL_ERROR_INVALID_PARAM;
+    }
+    
+    if (!count) {
+        intel_hal_set_error("Count parameter is NULL");
+        return INTEL_HAL_ERROR_INVALID_PARAM;
+    }
+    
+    capacity = records ? *count : 0;
+    
+    result = platform_enumerate_records(records, capacity, &total);
+    if (result != INTEL_HAL_SUCCESS) {
+        return result;
+    }
+    
+    *count = total;
+    if (records && total > capacity) {
+        intel_hal_set_error("Record buffer too small: %u devices present", total);
+        return INTEL_HAL_ERROR_NO_MEMORY;
+    }
+    return INTEL_HAL_SUCCESS;
+}
+
+intel_hal_result_t intel_hal_open_device_by_record(const intel_device_record_t *record, intel_device_t **device)
+{
+    intel_device_t *new_device;
+    intel_hal_result_t result;
+    
+    if (!hal_initialized) {
+        intel_hal_set_error("HAL not initialized");
+        return INTEL_HAL_ERROR_INVALID_PARAM;
+    }
+    
+    if (!record || !device) {
+        intel_hal_set_error("Invalid parameters");
+        return INTEL_HAL_ERROR_INVALID_PARAM;
+    }
+    
+    new_device = intel_device_create(record->device_id);
+    if (!new_device) {
+        intel_hal_set_error("Failed to create device instance for 0x%04x", record->device_id);
+        return INTEL_HAL_ERROR_NO_MEMORY;
+    }
+    
+    result = platform_init_instance(new_device, record);
+    if (result != INTEL_HAL_SUCCESS) {
+        intel_device_destroy(new_device);
+        return result;
+    }
+    
+    new_device->record = *record;
+    result = intel_registry_add(new_device);
+    if (result != INTEL_HAL_SUCCESS) {
+        platform_cleanup(new_device);
+        intel_device_destroy(new_device);
+        return result;
+    }
+    
+    new_device->is_open = true;
+    *device = new_device;
+    
+    printf("HAL: Device 0x%04x at %04x:%02x:%02x.%x opened successfully\n", record->device_id,
+           record->pci_domain, record->pci_bus, record->pci_device, record->pci_function);
+    intel_device_print_capabilities(new_device);
+    
+    return INTEL_HAL_SUCCESS;
+}
+
+/**
+ * @brief Open the adapter instance named by a PCI address or interface name
+ */
+static intel_hal_result_t open_device_instance(const char *name, intel_device_t **device)
+{
+    intel_device_record_t *records = NULL;
+    unsigned int domain = 0, bus, dev, function;
+    uint32_t record_count = 0;
+    uint32_t if_index = 0;
+    uint32_t i;
+    bool by_pci_address;
+    intel_hal_result_t result;
+    
+    by_pci_address = sscanf(name, "%x:%x:%x.%x", &domain, &bus, &dev, &function) == 4 ||
+                     (domain = 0, sscanf(name, "%x:%x.%x", &bus, &dev, &function) == 3);
+    if (!by_pci_address) {
+        if_index = if_nametoindex(name);
+        if (if_index == 0) {
+            intel_hal_set_error("No interface named %s", name);
+            return INTEL_HAL_ERROR_NO_DEVICE;
+        }
+    }
+    
+    result = enumerate_all_records(&records, &record_count);
+    if (result != INTEL_HAL_SUCCESS) {
+        return result;
+    }
+    
+    result = INTEL_HAL_ERROR_NO_DEVICE;
+    intel_hal_set_error("No supported Intel device at %s", name);
+    for (i = 0; i < record_count; i++) {
+        const intel_device_record_t *record = &records[i];
+        bool match = by_pci_address ?
+            (record->pci_domain == domain && record->pci_bus == bus &&
+             record->pci_device == dev && record->pci_function == function) :
+            record->if_index == if_index;
+        if (match) {
+            result = intel_hal_open_device_by_record(record, device);
+            break;
+        }
+    }
+    
+    free(records);
+    return result;
+}
+
 intel_hal_result_t intel_hal_open_device(const char *device_id, intel_device_t **device)
 {
     uint16_t device_id_num;
@@ -213,26 +414,31 @@ intel_hal_result_t intel_hal_open_device(const char *device_id, intel_device_t *
     intel_hal_result_t result;
     
     if (!hal_initialized) {
-        set_hal_error("HAL not initialized");
+        intel_hal_set_error("HAL not initialized");
         return INTEL_HAL_ERROR_INVALID_PARAM;
     }
     
     if (!device_id || !device) {
-        set_hal_error("Invalid parameters");
+        intel_hal_set_error("Invalid parameters");
         return INTEL_HAL_ERROR_INVALID_PARAM;
     }
     
+    /* PCI address or interface name selects one specific adapter instance */
+    if (strchr(device_id, ':') || !isdigit((unsigned char)device_id[0])) {
+        return open_device_instance(device_id, device);
+    }
+    
     /* Parse device ID */
     device_id_num = parse_device_id(device_id);
     if (device_id_num == 0) {
-        set_hal_error("Invalid device ID: %s", device_id);
+        intel_hal_set_error("Invalid device ID: %s", device_id);
         return INTEL_HAL_ERROR_INVALID_PARAM;
     }
     
     /* Create device instance */
     new_device = intel_device_create(device_id_num);
     if (!new_device) {
-        set_hal_error("Failed to create device instance for 0x%04x", device_id_num);
+        intel_hal_set_error("Failed to create device instance for 0x%04x", device_id_num);
         return INTEL_HAL_ERROR_NO_MEMORY;
     }
     
@@ -240,7 +446,7 @@ intel_hal_result_t intel_hal_open_device(const char *device_id, intel_device_t *
 #ifdef INTEL_HAL_WINDOWS
     result = intel_windows_init_device(new_device, device_id_num);
     if (result != INTEL_HAL_SUCCESS) {
-        set_hal_error("Windows device initialization failed: %s", intel_windows_get_last_error());
+        intel_hal_set_error("Windows device initialization failed: %s", intel_windows_get_last_error());
         intel_device_destroy(new_device);
         return result;
     }
@@ -249,12 +455,30 @@ intel_hal_result_t intel_hal_open_device(const char *device_id, intel_device_t *
 #ifdef INTEL_HAL_LINUX
     result = intel_linux_init_device(new_device, device_id_num);
     if (result != INTEL_HAL_SUCCESS) {
-        set_hal_error("Linux device initialization failed: %s", intel_linux_get_last_error());
+        intel_hal_set_error("Linux device initialization failed: %s", intel_linux_get_last_error());
         intel_device_destroy(new_device);
         return result;
     }
 #endif
     
+    /* Record the instance identity of the adapter found for this ID */
+    new_device->record.device_id = device_id_num;
+    new_device->record.family = (uint8_t)new_device->info.family;
+    new_device->record.capabilities = new_device->info.capabilities;
+    new_device->record.ptp_index = -1;
+#ifdef INTEL_HAL_WINDOWS
+    new_device->record.if_index = new_device->info.windows.adapter_index;
+#endif
+#ifdef INTEL_HAL_LINUX
+    intel_linux_get_record(new_device->info.linux.interface_name, &new_device->record);
+#endif
+    result = intel_registry_add(new_device);
+    if (result != INTEL_HAL_SUCCESS) {
+        platform_cleanup(new_device);
+        intel_device_destroy(new_device);
+        return result;
+    }
+    
     new_device->is_open = true;
     *device = new_device;
     
@@ -277,6 +501,19 @@ void intel_hal_close_device(intel_device_t *device)
     
     printf("HAL: Closing device 0x%04x\n", device->info.device_id);
     
+    intel_registry_remove(device);
+    
+    /* Stop the PHC-time scheduler while the PHC is still accessible */
+    intel_scheduler_destroy(device->scheduler);
+    device->scheduler = NULL;
+    intel_config_queue_destroy(device->config_queue);
+    device->config_queue = NULL;
+    intel_soft_tas_destroy(device->soft_tas);
+    device->soft_tas = NULL;
+    intel_launch_destroy(device->launch);
+    device->launch = NULL;
+    intel_packet_pools_destroy(device);
+    
     /* Platform-specific cleanup */
 #ifdef INTEL_HAL_WINDOWS
     intel_windows_cleanup_device(device);
@@ -293,7 +530,7 @@ void intel_hal_close_device(intel_device_t *device)
 intel_hal_result_t intel_hal_get_device_info(intel_device_t *device, intel_device_info_t *info)
 {
     if (!device || !info) {
-        set_hal_error("Invalid parameters");
+        intel_hal_set_error("Invalid parameters");
         return INTEL_HAL_ERROR_INVALID_PARAM;
     }
     
@@ -301,10 +538,21 @@ intel_hal_result_t intel_hal_get_device_info(intel_device_t *device, intel_devic
     return INTEL_HAL_SUCCESS;
 }
 
+intel_hal_result_t intel_hal_get_device_record(intel_device_t *device, intel_device_record_t *record)
+{
+    if (!device || !record) {
+        intel_hal_set_error("Invalid parameters");
+        return INTEL_HAL_ERROR_INVALID_PARAM;
+    }
+    
+    *record = device->record;
+    return INTEL_HAL_SUCCESS;
+}
+
 intel_hal_result_t intel_hal_get_interface_info(intel_device_t *device, intel_interface_info_t *info)
 {
     if (!device || !info) {
-        set_hal_error("Invalid parameters");
+        intel_hal_set_error("Invalid parameters");
         return INTEL_HAL_ERROR_INVALID_PARAM;
     }
     
@@ -392,12 +640,12 @@ intel_hal_result_t intel_hal_get_interface_info(intel_device_t *device, intel_in
 intel_hal_result_t intel_hal_enable_timestamping(intel_device_t *device, bool enable)
 {
     if (!device) {
-        set_hal_error("Invalid device");
+        intel_hal_set_error("Invalid device");
         return INTEL_HAL_ERROR_INVALID_PARAM;
     }
     
     if (!intel_device_has_capability(device, INTEL_CAP_BASIC_1588)) {
-        set_hal_error("Device does not support timestamping");
+        intel_hal_set_error("Device does not support timestamping");
         return INTEL_HAL_ERROR_NOT_SUPPORTED;
     }
     
@@ -406,21 +654,34 @@ intel_hal_result_t intel_hal_enable_timestamping(intel_device_t *device, bool en
     
     /* Platform-specific timestamp enable/disable would go here */
     
+    intel_hal_mutex_lock(&device->state_lock);
+    device->state.timestamping_enabled = enable;
+    intel_hal_mutex_unlock(&device->state_lock);
+    
     return INTEL_HAL_SUCCESS;
 }
 
 intel_hal_result_t intel_hal_read_timestamp(intel_device_t *device, intel_timestamp_t *timestamp)
 {
     if (!device || !timestamp) {
-        set_hal_error("Invalid parameters");
+        intel_hal_set_error("Invalid parameters");
         return INTEL_HAL_ERROR_INVALID_PARAM;
     }
     
     if (!intel_device_has_capability(device, INTEL_CAP_BASIC_1588)) {
-        set_hal_error("Device does not support timestamping");
+        intel_hal_set_error("Device does not support timestamping");
         return INTEL_HAL_ERROR_NOT_SUPPORTED;
     }
     
+    return intel_hal_read_timestamp_unchecked(device, timestamp);
+}
+
+intel_hal_result_t intel_hal_read_timestamp_unchecked(intel_device_t *device, intel_timestamp_t *timestamp)
+{
+    if (device->host_clock) {
+        return device->host_clock(device, timestamp);
+    }
+
 #ifdef INTEL_HAL_WINDOWS
     return intel_windows_read_timestamp(device, timestamp);
 #endif
@@ -435,47 +696,60 @@ intel_hal_result_t intel_hal_read_timestamp(intel_device_t *device, intel_timest
 intel_hal_result_t intel_hal_set_timestamp(intel_device_t *device, const intel_timestamp_t *timestamp)
 {
     if (!device || !timestamp) {
-        set_hal_error("Invalid parameters");
+        intel_hal_set_error("Invalid parameters");
         return INTEL_HAL_ERROR_INVALID_PARAM;
     }
     
     if (!intel_device_has_capability(device, INTEL_CAP_BASIC_1588)) {
-        set_hal_error("Device does not support timestamping");
+        intel_hal_set_error("Device does not support timestamping");
         return INTEL_HAL_ERROR_NOT_SUPPORTED;
     }
     
+    return intel_hal_set_timestamp_unchecked(device, timestamp);
+}
+
+intel_hal_result_t intel_hal_set_timestamp_unchecked(intel_device_t *device, const intel_timestamp_t *timestamp)
+{
     printf("HAL: Setting timestamp to %" PRIu64 ".%09u for device 0x%04x\n",
            timestamp->seconds, timestamp->nanoseconds, device->info.device_id);
     
     /* Platform-specific timestamp setting would go here */
     
+    intel_atomic_fetch_add_u64(&device->servo.step_count, 1);
     return INTEL_HAL_SUCCESS;
 }
 
 intel_hal_result_t intel_hal_adjust_frequency(intel_device_t *device, int32_t ppb_adjustment)
 {
     if (!device) {
-        set_hal_error("Invalid device");
+        intel_hal_set_error("Invalid device");
         return INTEL_HAL_ERROR_INVALID_PARAM;
     }
     
     if (!intel_device_has_capability(device, INTEL_CAP_BASIC_1588)) {
-        set_hal_error("Device does not support frequency adjustment");
+        intel_hal_set_error("Device does not support frequency adjustment");
         return INTEL_HAL_ERROR_NOT_SUPPORTED;
     }
     
+    return intel_hal_adjust_frequency_unchecked(device, ppb_adjustment);
+}
+
+intel_hal_result_t intel_hal_adjust_frequency_unchecked(intel_device_t *device, int32_t ppb_adjustment)
+{
     printf("HAL: Adjusting frequency by %d ppb for device 0x%04x\n",
            ppb_adjustment, device->info.device_id);
     
     /* Platform-specific frequency adjustment would go here */
     
+    intel_atomic_store_u32(&device->servo.frequency_ppb, (uint32_t)ppb_adjustment);
+    intel_atomic_fetch_add_u64(&device->servo.adjust_count, 1);
     return INTEL_HAL_SUCCESS;
 }
 
 intel_hal_result_t intel_hal_get_capabilities(intel_device_t *device, uint32_t *capabilities)
 {
     if (!device || !capabilities) {
-        set_hal_error("Invalid parameters");
+        intel_hal_set_error("Invalid parameters");
         return INTEL_HAL_ERROR_INVALID_PARAM;
     }
     
@@ -514,19 +788,19 @@ intel_hal_result_t intel_hal_configure_vlan_filter(intel_device_t *device, uint1
     int result;
     
     if (!device || vlan_id > 4095) {
-        set_hal_error("Invalid parameters for VLAN filter configuration");
+        intel_hal_set_error("Invalid parameters for VLAN filter configuration");
         return INTEL_HAL_ERROR_INVALID_PARAM;
     }
     
     if (!intel_device_has_capability(device, INTEL_CAP_VLAN_FILTER)) {
-        set_hal_error("Device does not support VLAN filtering");
+        intel_hal_set_error("Device does not support VLAN filtering");
         return INTEL_HAL_ERROR_NOT_SUPPORTED;
     }
     
     // Map HAL device to intel_avb device (stored in platform_data)
     avb_device = device->platform_data;
     if (!avb_device) {
-        set_hal_error("Intel AVB device not available for hardware access");
+        intel_hal_set_error("Intel AVB device not available for hardware access");
         return INTEL_HAL_ERROR_DEVICE_BUSY;
     }
     
@@ -540,6 +814,14 @@ intel_hal_result_t intel_hal_configure_vlan_filter(intel_device_t *device, uint1
     printf("  VFTA Register: [%d], Bit: %d\n", vfta_index, vfta_bit);
     printf("  Register Address: 0x%08X\n", INTEL_VFTA_BASE + (vfta_index * 4));
     
+    intel_hal_mutex_lock(&device->state_lock);
+    if (enable) {
+        device->state.vlan_filter[vfta_index] |= 1u << vfta_bit;
+    } else {
+        device->state.vlan_filter[vfta_index] &= ~(1u << vfta_bit);
+    }
+    intel_hal_mutex_unlock(&device->state_lock);
+    
     return INTEL_HAL_SUCCESS;
 }
 
@@ -549,19 +831,19 @@ intel_hal_result_t intel_hal_set_vlan_tag(intel_device_t *device, const intel_vl
     void *avb_device;
     
     if (!device || !vlan_tag || vlan_tag->vlan_id > 4095 || vlan_tag->priority > 7) {
-        set_hal_error("Invalid parameters for VLAN tag configuration");
+        intel_hal_set_error("Invalid parameters for VLAN tag configuration");
         return INTEL_HAL_ERROR_INVALID_PARAM;
     }
     
     if (!intel_device_has_capability(device, INTEL_CAP_VLAN_FILTER)) {
-        set_hal_error("Device does not support VLAN tagging");
+        intel_hal_set_error("Device does not support VLAN tagging");
         return INTEL_HAL_ERROR_NOT_SUPPORTED;
     }
     
     // Map HAL device to intel_avb device (stored in platform_data)
     avb_device = device->platform_data;
     if (!avb_device) {
-        set_hal_error("Intel AVB device not available for hardware access");
+        intel_hal_set_error("Intel AVB device not available for hardware access");
         return INTEL_HAL_ERROR_DEVICE_BUSY;
     }
     
@@ -583,12 +865,12 @@ intel_hal_result_t intel_hal_set_vlan_tag(intel_device_t *device, const intel_vl
 intel_hal_result_t intel_hal_get_vlan_tag(intel_device_t *device, intel_vlan_tag_t *vlan_tag)
 {
     if (!device || !vlan_tag) {
-        set_hal_error("Invalid parameters for VLAN tag retrieval");
+        intel_hal_set_error("Invalid parameters for VLAN tag retrieval");
         return INTEL_HAL_ERROR_INVALID_PARAM;
     }
     
     if (!intel_device_has_capability(device, INTEL_CAP_VLAN_FILTER)) {
-        set_hal_error("Device does not support VLAN tagging");
+        intel_hal_set_error("Device does not support VLAN tagging");
         return INTEL_HAL_ERROR_NOT_SUPPORTED;
     }
     
@@ -605,57 +887,75 @@ intel_hal_result_t intel_hal_get_vlan_tag(intel_device_t *device, intel_vlan_tag
 intel_hal_result_t intel_hal_configure_priority_mapping(intel_device_t *device, uint8_t priority, uint8_t traffic_class)
 {
     if (!device || priority > 7 || traffic_class > 7) {
-        set_hal_error("Invalid parameters for priority mapping");
+        intel_hal_set_error("Invalid parameters for priority mapping");
         return INTEL_HAL_ERROR_INVALID_PARAM;
     }
     
     if (!intel_device_has_capability(device, INTEL_CAP_QOS_PRIORITY)) {
-        set_hal_error("Device does not support QoS priority mapping");
+        intel_hal_set_error("Device does not support QoS priority mapping");
         return INTEL_HAL_ERROR_NOT_SUPPORTED;
     }
     
     // Placeholder implementation - would access hardware registers
     printf("Configuring priority mapping: Priority %d -> Traffic Class %d\n", priority, traffic_class);
+    
+    intel_hal_mutex_lock(&device->state_lock);
+    device->state.priority_map[priority] = traffic_class;
+    intel_hal_mutex_unlock(&device->state_lock);
     return INTEL_HAL_SUCCESS;
 }
 
 intel_hal_result_t intel_hal_configure_cbs(intel_device_t *device, uint8_t traffic_class, const intel_cbs_config_t *cbs_config)
 {
     if (!device || !cbs_config || traffic_class > 7) {
-        set_hal_error("Invalid parameters for CBS configuration");
+        intel_hal_set_error("Invalid parameters for CBS configuration");
         return INTEL_HAL_ERROR_INVALID_PARAM;
     }
     
     if (!intel_device_has_capability(device, INTEL_CAP_AVB_SHAPING)) {
-        set_hal_error("Device does not support Credit-Based Shaper");
+        intel_hal_set_error("Device does not support Credit-Based Shaper");
         return INTEL_HAL_ERROR_NOT_SUPPORTED;
     }
     
+    return intel_hal_configure_cbs_unchecked(device, traffic_class, cbs_config);
+}
+
+intel_hal_result_t intel_hal_configure_cbs_unchecked(intel_device_t *device, uint8_t traffic_class, const intel_cbs_config_t *cbs_config)
+{
+    intel_hal_result_t result = intel_ledger_claim(device, traffic_class, INTEL_LEDGER_CBS,
+                                                   cbs_config->enabled ? (uint64_t)cbs_config->idle_slope * 8 : 0);
+    if (result != INTEL_HAL_SUCCESS) {
+        return result;
+    }
+    
     // Placeholder implementation - would access hardware registers
     printf("Configuring CBS for TC %d: %s, Send Slope=%d, Idle Slope=%d\n",
            traffic_class, cbs_config->enabled ? "enabled" : "disabled",
            cbs_config->send_slope, cbs_config->idle_slope);
+    
+    intel_hal_mutex_lock(&device->state_lock);
+    device->state.cbs[traffic_class] = *cbs_config;
+    device->state.cbs[traffic_class].traffic_class = traffic_class;
+    intel_hal_mutex_unlock(&device->state_lock);
     return INTEL_HAL_SUCCESS;
 }
 
 intel_hal_result_t intel_hal_get_cbs_config(intel_device_t *device, uint8_t traffic_class, intel_cbs_config_t *cbs_config)
 {
     if (!device || !cbs_config || traffic_class > 7) {
-        set_hal_error("Invalid parameters for CBS configuration retrieval");
+        intel_hal_set_error("Invalid parameters for CBS configuration retrieval");
         return INTEL_HAL_ERROR_INVALID_PARAM;
     }
     
     if (!intel_device_has_capability(device, INTEL_CAP_AVB_SHAPING)) {
-        set_hal_error("Device does not support Credit-Based Shaper");
+        intel_hal_set_error("Device does not support Credit-Based Shaper");
         return INTEL_HAL_ERROR_NOT_SUPPORTED;
     }
     
-    // Placeholder implementation - would read from hardware registers
-    cbs_config->enabled = true;
-    cbs_config->send_slope = 1000000;  // 1 Mbps
-    cbs_config->idle_slope = 2000000;  // 2 Mbps
-    cbs_config->hi_credit = 5000;
-    cbs_config->lo_credit = -5000;
+    // Report the last configuration applied through the HAL
+    intel_hal_mutex_lock(&device->state_lock);
+    *cbs_config = device->state.cbs[traffic_class];
+    intel_hal_mutex_unlock(&device->state_lock);
     cbs_config->traffic_class = traffic_class;
     
     printf("Retrieved CBS config for TC %d: %s, Send Slope=%d\n",
@@ -666,34 +966,54 @@ intel_hal_result_t intel_hal_get_cbs_config(intel_device_t *device, uint8_t traf
 intel_hal_result_t intel_hal_configure_bandwidth_allocation(intel_device_t *device, uint8_t traffic_class, uint32_t bandwidth_percent)
 {
     if (!device || traffic_class > 7 || bandwidth_percent > 100) {
-        set_hal_error("Invalid parameters for bandwidth allocation");
+        intel_hal_set_error("Invalid parameters for bandwidth allocation");
         return INTEL_HAL_ERROR_INVALID_PARAM;
     }
     
     if (!intel_device_has_capability(device, INTEL_CAP_ADVANCED_QOS)) {
-        set_hal_error("Device does not support advanced QoS features");
+        intel_hal_set_error("Device does not support advanced QoS features");
         return INTEL_HAL_ERROR_NOT_SUPPORTED;
     }
     
+    intel_hal_result_t result = intel_ledger_claim(device, traffic_class, INTEL_LEDGER_BANDWIDTH,
+                                                   device->ledger.capacity_bps * bandwidth_percent / 100);
+    if (result != INTEL_HAL_SUCCESS) {
+        return result;
+    }
+    
     // Placeholder implementation - would access hardware registers
     printf("Configuring bandwidth allocation: TC %d -> %d%%\n", traffic_class, bandwidth_percent);
+    
+    intel_hal_mutex_lock(&device->state_lock);
+    device->state.bandwidth_percent[traffic_class] = bandwidth_percent;
+    intel_hal_mutex_unlock(&device->state_lock);
     return INTEL_HAL_SUCCESS;
 }
 
 intel_hal_result_t intel_hal_set_rate_limit(intel_device_t *device, uint8_t traffic_class, uint32_t rate_mbps)
 {
     if (!device || traffic_class > 7) {
-        set_hal_error("Invalid parameters for rate limiting");
+        intel_hal_set_error("Invalid parameters for rate limiting");
         return INTEL_HAL_ERROR_INVALID_PARAM;
     }
     
     if (!intel_device_has_capability(device, INTEL_CAP_ADVANCED_QOS)) {
-        set_hal_error("Device does not support advanced QoS features");
+        intel_hal_set_error("Device does not support advanced QoS features");
         return INTEL_HAL_ERROR_NOT_SUPPORTED;
     }
     
+    intel_hal_result_t result = intel_ledger_claim(device, traffic_class, INTEL_LEDGER_RATE_LIMIT,
+                                                   (uint64_t)rate_mbps * 1000000ULL);
+    if (result != INTEL_HAL_SUCCESS) {
+        return result;
+    }
+    
     // Placeholder implementation - would access hardware registers
     printf("Setting rate limit: TC %d -> %d Mbps\n", traffic_class, rate_mbps);
+    
+    intel_hal_mutex_lock(&device->state_lock);
+    device->state.rate_limit_mbps[traffic_class] = rate_mbps;
+    intel_hal_mutex_unlock(&device->state_lock);
     return INTEL_HAL_SUCCESS;
 }
 
@@ -701,83 +1021,303 @@ intel_hal_result_t intel_hal_set_rate_limit(intel_device_t *device, uint8_t traf
  * TSN (Time-Sensitive Networking) Functions Implementation
  * ============================================================================ */
 
-intel_hal_result_t intel_hal_setup_time_aware_shaper(intel_device_t *device, const intel_tas_config_t *config)
+/**
+ * @brief Build the intel_avb device descriptor for a HAL device
+ *
+ * @param[in] device HAL device handle
+ * @param[out] avb_device intel_avb device_t used for intel.h calls
+ */
+static void intel_hal_fill_avb_device(intel_device_t *device, device_t *avb_device)
 {
-    if (!device || !config) {
-        set_hal_error("Invalid parameters for Time-Aware Shaper setup");
-        return INTEL_HAL_ERROR_INVALID_PARAM;
+    memset(avb_device, 0, sizeof(*avb_device));
+    avb_device->pci_vendor_id = device->info.vendor_id;
+    avb_device->pci_device_id = device->info.device_id;
+    avb_device->private_data = device->platform_data;
+    
+    switch (device->info.family) {
+        case INTEL_FAMILY_I210: avb_device->device_type = INTEL_DEVICE_I210; break;
+        case INTEL_FAMILY_I219: avb_device->device_type = INTEL_DEVICE_I219; break;
+        case INTEL_FAMILY_I225: avb_device->device_type = INTEL_DEVICE_I225; break;
+        case INTEL_FAMILY_I226: avb_device->device_type = INTEL_DEVICE_I226; break;
+        default: break;
     }
+}
+
+/**
+ * @brief Build the gate lookup index of a schedule (entry_count 0 if it cannot be indexed)
+ */
+static void intel_hal_build_tas_index(const intel_tas_config_t *config, intel_tas_index_t *index)
+{
+    uint64_t total = 0;
     
-    // Check if device supports TSN TAS
-    if (!intel_device_has_capability(device, INTEL_CAP_TSN_TIME_AWARE_SHAPER)) {
-        printf("WARNING: Device does not support hardware Time-Aware Shaper, using software fallback\n");
-        // Continue with software implementation
+    memset(index, 0, sizeof(*index));
+    for (uint32_t i = 0; i < config->gate_control_list_length && i < INTEL_HAL_TAS_MAX_ENTRIES; i++) {
+        total += config->gate_control_list[i].time_interval;
     }
-    
+    if (config->gate_control_list_length > 0 && total == config->cycle_time) {
+        intel_hal_tas_index_build(config, index);
+    }
+}
+
+/**
+ * @brief Record an applied TAS configuration in the device state cache
+ */
+static void intel_hal_store_tas_state(intel_device_t *device, const intel_tas_config_t *config)
+{
+    intel_tas_index_t index;
+    
+    intel_hal_build_tas_index(config, &index);
+    intel_hal_mutex_lock(&device->state_lock);
+    device->state.tas = *config;
+    device->tas_index = index;
+    device->state.tas_enabled = config->gate_control_list_length > 0;
+    device->tas_admin.pending = false;  /* An immediate configuration replaces a staged one */
+    intel_hal_mutex_unlock(&device->state_lock);
+}
+
+/**
+ * @brief Record a schedule that takes over at its base time as the staged admin schedule
+ */
+static void intel_hal_stage_tas_state(intel_device_t *device, const intel_tas_config_t *config)
+{
+    intel_tas_index_t index;
+    
+    intel_hal_build_tas_index(config, &index);
+    intel_hal_mutex_lock(&device->state_lock);
+    device->tas_admin.config = *config;
+    device->tas_admin.index = index;
+    device->tas_admin.pending = true;
+    intel_hal_mutex_unlock(&device->state_lock);
+}
+
+/**
+ * @brief Make a staged admin schedule operational in the state cache once due
+ */
+static void intel_hal_promote_tas_admin(intel_device_t *device)
+{
+    intel_timestamp_t now;
+    bool pending;
+
+    intel_hal_mutex_lock(&device->state_lock);
+    pending = device->tas_admin.pending;
+    intel_hal_mutex_unlock(&device->state_lock);
+    if (!pending || intel_hal_read_timestamp_unchecked(device, &now) != INTEL_HAL_SUCCESS) {
+        return;
+    }
+
+    intel_hal_mutex_lock(&device->state_lock);
+    if (device->tas_admin.pending &&
+        now.seconds * 1000000000ULL + now.nanoseconds >= device->tas_admin.config.base_time) {
+        device->state.tas = device->tas_admin.config;
+        device->tas_index = device->tas_admin.index;
+        device->state.tas_enabled = true;
+        device->tas_admin.pending = false;
+    }
+    intel_hal_mutex_unlock(&device->state_lock);
+}
+
+static void print_tas_config(const intel_tas_config_t *config)
+{
     printf("Configuring Time-Aware Shaper:\n");
     printf("  Cycle Time: %" PRIu64 " ns\n", config->cycle_time);
     printf("  Base Time: %" PRIu64 " ns\n", config->base_time);
     printf("  Gate Control List Length: %u\n", config->gate_control_list_length);
     
-    for (uint32_t i = 0; i < config->gate_control_list_length && i < 8; i++) {
+    for (uint32_t i = 0; i < config->gate_control_list_length && i < INTEL_HAL_TAS_MAX_ENTRIES; i++) {
         printf("  Gate %u: States=0x%02X, Interval=%u ns\n", 
                i, config->gate_control_list[i].gate_states, 
                config->gate_control_list[i].time_interval);
     }
+}
+
+intel_hal_result_t intel_hal_setup_time_aware_shaper(intel_device_t *device, const intel_tas_config_t *config)
+{
+    if (!device || !config) {
+        intel_hal_set_error("Invalid parameters for Time-Aware Shaper setup");
+        return INTEL_HAL_ERROR_INVALID_PARAM;
+    }
     
-    // Hardware-specific implementation for I225/I226
-    if (device->info.family == INTEL_DEVICE_FAMILY_I225 || 
-        device->info.family == INTEL_DEVICE_FAMILY_I226) {
-        
-        printf("I225/I226: Delegating to intel_avb for hardware TAS configuration\n");
-        
-        // Convert Intel HAL config to intel_avb format
-        struct tsn_tas_config intel_avb_config = {0};
-        intel_avb_config.base_time_s = config->base_time / 1000000000ULL;
-        intel_avb_config.base_time_ns = config->base_time % 1000000000ULL;
-        intel_avb_config.cycle_time_s = config->cycle_time / 1000000000ULL;
-        intel_avb_config.cycle_time_ns = config->cycle_time % 1000000000ULL;
+    if (config->gate_control_list_length > INTEL_HAL_TAS_MAX_ENTRIES) {
+        intel_hal_set_error("Gate control list has %u entries (hardware limit %u); use intel_hal_setup_gcl",
+                      config->gate_control_list_length, INTEL_HAL_TAS_MAX_ENTRIES);
+        return INTEL_HAL_ERROR_INVALID_PARAM;
+    }
+    
+    // Check if device supports TSN TAS
+    if (!intel_device_has_capability(device, INTEL_CAP_TSN_TIME_AWARE_SHAPER)) {
+        printf("WARNING: Device does not support hardware Time-Aware Shaper, using software fallback\n");
+        print_tas_config(config);
         
-        // Convert gate control list
-        for (uint32_t i = 0; i < config->gate_control_list_length && i < 8; i++) {
-            intel_avb_config.gate_states[i] = config->gate_control_list[i].gate_states;
-            intel_avb_config.gate_durations[i] = config->gate_control_list[i].time_interval;
+        // Software fallback for I210/I219
+        printf("I210/I219: Using software-based time-aware scheduling\n");
+        intel_hal_result_t result = intel_soft_tas_configure(device, config);
+        if (result != INTEL_HAL_SUCCESS) {
+            return result;
         }
-        
-        // Create intel_avb device_t structure from HAL device
-        device_t intel_avb_device = {0};
-        intel_avb_device.pci_vendor_id = device->info.vendor_id;
-        intel_avb_device.pci_device_id = device->info.device_id;
-        intel_avb_device.private_data = device->platform_data;
-        
-        // Set device type based on family
-        if (device->info.family == INTEL_DEVICE_FAMILY_I225) {
-            intel_avb_device.device_type = INTEL_DEVICE_I225;
-        } else {
-            intel_avb_device.device_type = INTEL_DEVICE_I226;
+        intel_hal_store_tas_state(device, config);
+        return INTEL_HAL_SUCCESS;
+    }
+    
+    return intel_hal_setup_time_aware_shaper_unchecked(device, config);
+}
+
+/**
+ * @brief Program the I225/I226 gate scheduler through intel_avb
+ */
+static intel_hal_result_t intel_hal_program_tas(intel_device_t *device, const intel_tas_config_t *config)
+{
+    print_tas_config(config);
+    
+    // Hardware implementation for I225/I226 (the only INTEL_CAP_TSN_TAS families)
+    printf("I225/I226: Delegating to intel_avb for hardware TAS configuration\n");
+    
+    // Convert Intel HAL config to intel_avb format
+    struct tsn_tas_config intel_avb_config = {0};
+    intel_avb_config.base_time_s = config->base_time / 1000000000ULL;
+    intel_avb_config.base_time_ns = config->base_time % 1000000000ULL;
+    intel_avb_config.cycle_time_s = config->cycle_time / 1000000000ULL;
+    intel_avb_config.cycle_time_ns = config->cycle_time % 1000000000ULL;
+    
+    // Convert gate control list
+    for (uint32_t i = 0; i < config->gate_control_list_length && i < INTEL_HAL_TAS_MAX_ENTRIES; i++) {
+        intel_avb_config.gate_states[i] = config->gate_control_list[i].gate_states;
+        intel_avb_config.gate_durations[i] = config->gate_control_list[i].time_interval;
+    }
+    
+    device_t intel_avb_device;
+    intel_hal_fill_avb_device(device, &intel_avb_device);
+    
+    // Call real intel_avb TSN function
+    int result = intel_setup_time_aware_shaper(&intel_avb_device, &intel_avb_config);
+    
+    if (result != 0) {
+        intel_hal_set_error("intel_avb TAS configuration failed with code %d", result);
+        return INTEL_HAL_ERROR_HARDWARE;
+    }
+    printf("I225/I226: Hardware TAS configured successfully via intel_avb\n");
+    return INTEL_HAL_SUCCESS;
+}
+
+intel_hal_result_t intel_hal_setup_time_aware_shaper_unchecked(intel_device_t *device, const intel_tas_config_t *config)
+{
+    intel_hal_result_t result = intel_hal_program_tas(device, config);
+    
+    if (result == INTEL_HAL_SUCCESS) {
+        intel_hal_store_tas_state(device, config);
+    }
+    return result;
+}
+
+intel_hal_result_t intel_hal_tas_program_staged(intel_device_t *device, const intel_tas_config_t *config)
+{
+    intel_hal_result_t result = intel_hal_program_tas(device, config);
+    
+    if (result == INTEL_HAL_SUCCESS) {
+        intel_hal_stage_tas_state(device, config);
+    }
+    return result;
+}
+
+intel_hal_result_t intel_hal_tas_stage_update(intel_device_t *device, const intel_tas_config_t *admin,
+                                              uint64_t not_before, intel_tas_update_t *update)
+{
+    intel_tas_config_t oper;
+    intel_tas_config_t staged;
+    intel_timestamp_t now;
+    intel_hal_result_t result;
+    uint64_t earliest;
+    uint32_t changed = 0;
+    uint32_t count;
+    bool oper_enabled;
+    bool hardware;
+    
+    if (update) {
+        memset(update, 0, sizeof(*update));
+    }
+    if (!device || !admin || admin->gate_control_list_length == 0 ||
+        admin->gate_control_list_length > INTEL_HAL_TAS_MAX_ENTRIES || admin->cycle_time == 0) {
+        intel_hal_set_error("Invalid parameters for TAS schedule update");
+        return INTEL_HAL_ERROR_INVALID_PARAM;
+    }
+    
+    result = intel_hal_read_timestamp_unchecked(device, &now);
+    if (result != INTEL_HAL_SUCCESS) {
+        return result;
+    }
+    earliest = now.seconds * 1000000000ULL + now.nanoseconds + INTEL_HAL_TAS_UPDATE_MIN_LEAD_NS;
+    if (not_before > earliest) {
+        earliest = not_before;
+    }
+    
+    intel_hal_promote_tas_admin(device);
+    intel_hal_mutex_lock(&device->state_lock);
+    oper = device->state.tas;
+    oper_enabled = device->state.tas_enabled;
+    intel_hal_mutex_unlock(&device->state_lock);
+    if (!oper_enabled) {
+        oper.gate_control_list_length = 0;
+    }
+    
+    /* Entries that differ from the operating schedule, including removed ones */
+    count = admin->gate_control_list_length > oper.gate_control_list_length ?
+            admin->gate_control_list_length : oper.gate_control_list_length;
+    for (uint32_t i = 0; i < count; i++) {
+        if (i >= admin->gate_control_list_length || i >= oper.gate_control_list_length ||
+            admin->gate_control_list[i].gate_states != oper.gate_control_list[i].gate_states ||
+            admin->gate_control_list[i].time_interval != oper.gate_control_list[i].time_interval) {
+            changed |= 1u << i;
         }
+    }
+    if (changed == 0 && admin->cycle_time == oper.cycle_time &&
+        (admin->base_time < earliest || admin->base_time == oper.base_time)) {
+        return INTEL_HAL_SUCCESS;       /* Already operating */
+    }
+    
+    /* AdminBaseTime: explicit future base, else the next boundary of the running grid */
+    staged = *admin;
+    if (admin->base_time < earliest) {
+        uint64_t base = oper.gate_control_list_length > 0 ? oper.base_time : admin->base_time;
+        uint64_t cycle = oper.gate_control_list_length > 0 ? oper.cycle_time : admin->cycle_time;
         
-        // Call real intel_avb TSN function
-        int result = intel_setup_time_aware_shaper(&intel_avb_device, &intel_avb_config);
-        
-        if (result == 0) {
-            printf("I225/I226: Hardware TAS configured successfully via intel_avb\n");
-            return INTEL_HAL_SUCCESS;
-        } else {
-            set_hal_error("intel_avb TAS configuration failed with code %d", result);
-            return INTEL_HAL_ERROR_HARDWARE;
-        }
+        staged.base_time = base < earliest ? intel_hal_tas_next_base_time(base, cycle, earliest) : base;
+    }
+    
+    /* Hardware latches the new list and switches at its base time */
+    hardware = intel_device_has_capability(device, INTEL_CAP_TSN_TIME_AWARE_SHAPER);
+    result = hardware ? intel_hal_program_tas(device, &staged) : intel_soft_tas_stage(device, &staged);
+    if (result != INTEL_HAL_SUCCESS) {
+        return result;
+    }
+    
+    intel_hal_stage_tas_state(device, &staged);
+    
+    if (update) {
+        update->admin_base_time = staged.base_time;
+        update->changed_entries = changed;
+        update->hardware = hardware;
+    }
+    return INTEL_HAL_SUCCESS;
+}
+
+intel_hal_result_t intel_hal_tas_get_update_status(intel_device_t *device, bool *pending, uint64_t *admin_base_time)
+{
+    if (!device || !pending || !admin_base_time) {
+        intel_hal_set_error("Invalid parameters for TAS update status query");
+        return INTEL_HAL_ERROR_INVALID_PARAM;
     }
     
-    // Software fallback for I210/I219
-    printf("I210/I219: Using software-based time-aware scheduling\n");
+    intel_hal_promote_tas_admin(device);
+    intel_hal_mutex_lock(&device->state_lock);
+    *pending = device->tas_admin.pending;
+    *admin_base_time = *pending ? device->tas_admin.config.base_time : 0;
+    intel_hal_mutex_unlock(&device->state_lock);
     return INTEL_HAL_SUCCESS;
 }
 
 intel_hal_result_t intel_hal_setup_frame_preemption(intel_device_t *device, const intel_frame_preemption_config_t *config)
 {
     if (!device || !config) {
-        set_hal_error("Invalid parameters for Frame Preemption setup");
+        intel_hal_set_error("Invalid parameters for Frame Preemption setup");
         return INTEL_HAL_ERROR_INVALID_PARAM;
     }
     
@@ -787,6 +1327,11 @@ intel_hal_result_t intel_hal_setup_frame_preemption(intel_device_t *device, cons
         return INTEL_HAL_ERROR_NOT_SUPPORTED;
     }
     
+    return intel_hal_setup_frame_preemption_unchecked(device, config);
+}
+
+intel_hal_result_t intel_hal_setup_frame_preemption_unchecked(intel_device_t *device, const intel_frame_preemption_config_t *config)
+{
     printf("Configuring Frame Preemption:\n");
     printf("  Preemptible Queues: 0x%02X\n", config->preemptible_queues);
     printf("  Additional Fragment Size: %u bytes\n", config->additional_fragment_size);
@@ -803,12 +1348,8 @@ intel_hal_result_t intel_hal_setup_frame_preemption(intel_device_t *device, cons
         intel_avb_config.min_fragment_size = config->additional_fragment_size;
         intel_avb_config.verify_disable = config->verify_disable ? 1 : 0;
         
-        // Create intel_avb device_t structure from HAL device
-        device_t intel_avb_device = {0};
-        intel_avb_device.pci_vendor_id = device->info.vendor_id;
-        intel_avb_device.pci_device_id = device->info.device_id;
-        intel_avb_device.private_data = device->platform_data;
-        intel_avb_device.device_type = INTEL_DEVICE_I226;
+        device_t intel_avb_device;
+        intel_hal_fill_avb_device(device, &intel_avb_device);
         
         // Call real intel_avb Frame Preemption function
         int result = intel_setup_frame_preemption(&intel_avb_device, &intel_avb_config);
@@ -817,9 +1358,22 @@ intel_hal_result_t intel_hal_setup_frame_preemption(intel_device_t *device, cons
             printf("I226: Hardware Frame Preemption configured successfully via intel_avb\n");
             printf("I226: Preemptible Queues: 0x%02X, Min Fragment: %u bytes\n",
                    config->preemptible_queues, config->additional_fragment_size);
+            
+            intel_timestamp_t now;
+            uint64_t now_ns = 0;
+            if (intel_hal_read_timestamp_unchecked(device, &now) == INTEL_HAL_SUCCESS) {
+                now_ns = now.seconds * 1000000000ULL + now.nanoseconds;
+            }
+            
+            intel_hal_mutex_lock(&device->state_lock);
+            device->state.fp = *config;
+            device->state.fp_enabled = config->preemptible_queues != 0;
+            device->fp_monitor.configured_ns = now_ns;   /* Verification restarts */
+            memset(&device->fp_monitor.since_configure, 0, sizeof(device->fp_monitor.since_configure));
+            intel_hal_mutex_unlock(&device->state_lock);
             return INTEL_HAL_SUCCESS;
         } else {
-            set_hal_error("intel_avb Frame Preemption configuration failed with code %d", result);
+            intel_hal_set_error("intel_avb Frame Preemption configuration failed with code %d", result);
             return INTEL_HAL_ERROR_HARDWARE;
         }
     }
@@ -831,7 +1385,7 @@ intel_hal_result_t intel_hal_setup_frame_preemption(intel_device_t *device, cons
 intel_hal_result_t intel_hal_xmit_timed_packet(intel_device_t *device, const intel_timed_packet_t *packet)
 {
     if (!device || !packet || !packet->packet_data || packet->packet_length == 0) {
-        set_hal_error("Invalid parameters for timed packet transmission");
+        intel_hal_set_error("Invalid parameters for timed packet transmission");
         return INTEL_HAL_ERROR_INVALID_PARAM;
     }
     
@@ -871,19 +1425,15 @@ intel_hal_result_t intel_hal_xmit_timed_packet(intel_device_t *device, const int
 intel_hal_result_t intel_hal_get_tas_status(intel_device_t *device, bool *enabled, uint64_t *current_time)
 {
     if (!device || !enabled || !current_time) {
-        set_hal_error("Invalid parameters for TAS status query");
+        intel_hal_set_error("Invalid parameters for TAS status query");
         return INTEL_HAL_ERROR_INVALID_PARAM;
     }
     
-    // Check if device supports TAS
-    if (!intel_device_has_capability(device, INTEL_CAP_TSN_TIME_AWARE_SHAPER)) {
-        *enabled = false;
-        *current_time = 0;
-        return INTEL_HAL_SUCCESS;
-    }
-    
-    // Read TAS status from hardware registers
-    *enabled = true;  // Placeholder - would read TSN_CTL register
+    // TAS state as last applied through the HAL (hardware or software schedule)
+    intel_hal_promote_tas_admin(device);
+    intel_hal_mutex_lock(&device->state_lock);
+    *enabled = device->state.tas_enabled;
+    intel_hal_mutex_unlock(&device->state_lock);
     
     // Read current time from hardware
     intel_timestamp_t timestamp;
@@ -894,16 +1444,61 @@ intel_hal_result_t intel_hal_get_tas_status(intel_device_t *device, bool *enable
         *current_time = 0;
     }
     
-    printf("TAS Status: %s, Current Time: %" PRIu64 " ns\n", 
-           *enabled ? "Enabled" : "Disabled", *current_time);
-    
     return INTEL_HAL_SUCCESS;
 }
 
+intel_hal_result_t intel_hal_get_tas_gate_info(intel_device_t *device, uint8_t traffic_class,
+                                               intel_tas_gate_info_t *info)
+{
+    intel_timestamp_t timestamp;
+    intel_hal_result_t result;
+    uint64_t now;
+    
+    if (!device || !info || traffic_class > 7) {
+        intel_hal_set_error("Invalid parameters for TAS gate query");
+        return INTEL_HAL_ERROR_INVALID_PARAM;
+    }
+    
+    result = intel_hal_read_timestamp_unchecked(device, &timestamp);
+    if (result != INTEL_HAL_SUCCESS) {
+        return result;
+    }
+    now = timestamp.seconds * 1000000000ULL + timestamp.nanoseconds;
+    
+    intel_hal_promote_tas_admin(device);
+    intel_hal_mutex_lock(&device->state_lock);
+    if (!device->state.tas_enabled || device->tas_index.entry_count == 0) {
+        intel_hal_mutex_unlock(&device->state_lock);
+        intel_hal_set_error("No indexable TAS schedule is enabled on this device");
+        return INTEL_HAL_ERROR_NOT_SUPPORTED;
+    }
+    result = intel_hal_tas_index_query(&device->tas_index, now, traffic_class, info);
+    
+    /* Windows from the admin base time on belong to the staged schedule */
+    if (result == INTEL_HAL_SUCCESS && device->tas_admin.pending && device->tas_admin.index.entry_count > 0 &&
+        (info->window_end == 0 || info->window_end > device->tas_admin.config.base_time)) {
+        intel_tas_gate_info_t admin;
+        if (intel_hal_tas_index_query(&device->tas_admin.index, now, traffic_class, &admin) == INTEL_HAL_SUCCESS) {
+            if (info->window_end == 0 || info->window_start >= device->tas_admin.config.base_time) {
+                info->open = false;
+                info->window_start = admin.window_start;
+                info->window_end = admin.window_end;
+            } else if (admin.window_start <= device->tas_admin.config.base_time) {
+                info->window_end = admin.window_end;    /* Open across the switch */
+            } else {
+                info->window_end = device->tas_admin.config.base_time;
+            }
+        }
+    }
+    intel_hal_mutex_unlock(&device->state_lock);
+    
+    return result;
+}
+
 intel_hal_result_t intel_hal_get_frame_preemption_status(intel_device_t *device, bool *enabled, uint8_t *active_queues)
 {
     if (!device || !enabled || !active_queues) {
-        set_hal_error("Invalid parameters for Frame Preemption status query");
+        intel_hal_set_error("Invalid parameters for Frame Preemption status query");
         return INTEL_HAL_ERROR_INVALID_PARAM;
     }
     
@@ -916,8 +1511,10 @@ intel_hal_result_t intel_hal_get_frame_preemption_status(intel_device_t *device,
     
     // Read Frame Preemption status from hardware registers (I226 only)
     if (device->info.family == INTEL_DEVICE_FAMILY_I226) {
-        *enabled = true;  // Placeholder - would read FPE_CTL register
-        *active_queues = 0x0F;  // Placeholder - would read FPE_CONFIG register
+        intel_hal_mutex_lock(&device->state_lock);
+        *enabled = device->state.fp_enabled;
+        *active_queues = device->state.fp.preemptible_queues;
+        intel_hal_mutex_unlock(&device->state_lock);
         
         printf("Frame Preemption Status: %s, Active Queues: 0x%02X\n", 
                *enabled ? "Enabled" : "Disabled", *active_queues);
@@ -928,3 +1525,176 @@ intel_hal_result_t intel_hal_get_frame_preemption_status(intel_device_t *device,
     *active_queues = 0;
     return INTEL_HAL_SUCCESS;
 }
+
+/* I226 MAC merge statistics (clear on read) */
+#define I226_PRMPTDTCNT             0x04280     /* Preempted frames transmitted */
+#define I226_PRMPTDRCNT             0x04284     /* Preempted frames reassembled (assembly OK) */
+#define I226_PRMEVNTTCNT            0x04298     /* Fragments transmitted */
+#define I226_PRMEVNTRCNT            0x0429C     /* Fragments received */
+#define I226_PRMEXCPRCNT            0x042A0     /* Reassembly exceptions, one count per byte */
+#define I226_TQAVCTRL               0x03570
+#define I226_TQAVCTRL_PREEMPT_ENA   0x00000002
+
+static void add_fp_counters(intel_fp_counters_t *total, const intel_fp_counters_t *delta)
+{
+    total->tx_preempted_frames += delta->tx_preempted_frames;
+    total->tx_fragments += delta->tx_fragments;
+    total->rx_fragments += delta->rx_fragments;
+    total->assembly_ok += delta->assembly_ok;
+    total->assembly_errors += delta->assembly_errors;
+    total->smd_errors += delta->smd_errors;
+}
+
+intel_hal_result_t intel_hal_get_frame_preemption_stats(intel_device_t *device, intel_fp_status_t *status)
+{
+    device_t intel_avb_device;
+    intel_fp_counters_t delta;
+    intel_fp_monitor_t *monitor;
+    intel_timestamp_t now;
+    uint32_t tqavctrl = 0;
+    uint32_t exceptions = 0;
+    uint32_t value;
+    uint64_t now_ns = 0;
+    uint64_t verify_ns;
+    bool hw_ok = true;
+    
+    if (!device || !status) {
+        intel_hal_set_error("Invalid parameters for Frame Preemption statistics query");
+        return INTEL_HAL_ERROR_INVALID_PARAM;
+    }
+    
+    if (device->info.family != INTEL_DEVICE_FAMILY_I226) {
+        intel_hal_set_error("Frame Preemption statistics only supported on I226 hardware");
+        return INTEL_HAL_ERROR_NOT_SUPPORTED;
+    }
+    
+    intel_hal_fill_avb_device(device, &intel_avb_device);
+    memset(&delta, 0, sizeof(delta));
+    hw_ok &= intel_read_reg(&intel_avb_device, I226_TQAVCTRL, &tqavctrl) == 0;
+    hw_ok &= intel_read_reg(&intel_avb_device, I226_PRMPTDTCNT, &value) == 0;
+    delta.tx_preempted_frames = value;
+    hw_ok &= intel_read_reg(&intel_avb_device, I226_PRMPTDRCNT, &value) == 0;
+    delta.assembly_ok = value;
+    hw_ok &= intel_read_reg(&intel_avb_device, I226_PRMEVNTTCNT, &value) == 0;
+    delta.tx_fragments = value;
+    hw_ok &= intel_read_reg(&intel_avb_device, I226_PRMEVNTRCNT, &value) == 0;
+    delta.rx_fragments = value;
+    hw_ok &= intel_read_reg(&intel_avb_device, I226_PRMEXCPRCNT, &exceptions) == 0;
+    if (!hw_ok) {
+        intel_hal_set_error("Cannot read I226 Frame Preemption registers");
+        return INTEL_HAL_ERROR_HARDWARE;
+    }
+    
+    /* Out-of-order fragments and frames are reassembly errors; SMD errors are counted separately */
+    delta.assembly_errors = (exceptions & 0xFF) + ((exceptions >> 16) & 0xFF) + (exceptions >> 24);
+    delta.smd_errors = (exceptions >> 8) & 0xFF;
+    
+    if (intel_hal_read_timestamp_unchecked(device, &now) == INTEL_HAL_SUCCESS) {
+        now_ns = now.seconds * 1000000000ULL + now.nanoseconds;
+    }
+    
+    memset(status, 0, sizeof(*status));
+    monitor = &device->fp_monitor;
+    
+    intel_hal_mutex_lock(&device->state_lock);
+    add_fp_counters(&monitor->total, &delta);
+    add_fp_counters(&monitor->since_configure, &delta);
+    status->enabled = device->state.fp_enabled;
+    status->preemptible_queues = device->state.fp.preemptible_queues;
+    status->tx_active = status->enabled && (tqavctrl & I226_TQAVCTRL_PREEMPT_ENA) != 0;
+    status->total = monitor->total;
+    status->delta = delta;
+    
+    /*
+     * The MAC exposes no verify state register: the outcome is inferred
+     * from fragment traffic since the last configuration, after the
+     * verifyTime window of three verify attempts. Silence is not failure:
+     * the partner may simply have nothing preemptible to send.
+     */
+    verify_ns = (uint64_t)device->state.fp.verify_time * 1000ULL * 3;
+    if (!status->enabled) {
+        status->verify_status = INTEL_FP_VERIFY_INITIAL;
+    } else if (device->state.fp.verify_disable) {
+        status->verify_status = INTEL_FP_VERIFY_DISABLED;
+    } else if (monitor->since_configure.assembly_ok > 0 ||
+               (monitor->since_configure.rx_fragments > 0 && monitor->since_configure.smd_errors == 0)) {
+        status->verify_status = INTEL_FP_VERIFY_SUCCEEDED;
+    } else if (now_ns == 0 || monitor->configured_ns == 0 || now_ns - monitor->configured_ns < verify_ns) {
+        status->verify_status = INTEL_FP_VERIFY_VERIFYING;
+    } else if (monitor->since_configure.assembly_errors > 0 || monitor->since_configure.smd_errors > 0) {
+        status->verify_status = INTEL_FP_VERIFY_FAILED;
+    } else {
+        status->verify_status = INTEL_FP_VERIFY_UNKNOWN;
+    }
+    intel_hal_mutex_unlock(&device->state_lock);
+    
+    /* Express traffic is never held: HAL gate schedules only use SetGateStates */
+    status->hold = false;
+    return INTEL_HAL_SUCCESS;
+}
+
+intel_hal_result_t intel_hal_read_link(intel_device_t *device, bool *link_up, uint32_t *speed_mbps)
+{
+    *link_up = false;
+    *speed_mbps = 0;
+
+#ifdef INTEL_HAL_WINDOWS
+    {
+        MIB_IF_ROW2 row;
+        memset(&row, 0, sizeof(row));
+        row.InterfaceIndex = device->info.windows.adapter_index;
+        if (GetIfEntry2(&row) != NO_ERROR) {
+            return INTEL_HAL_ERROR_OS_SPECIFIC;
+        }
+        *link_up = row.OperStatus == IfOperStatusUp;
+        *speed_mbps = *link_up ? (uint32_t)(row.TransmitLinkSpeed / 1000000ULL) : 0;
+        return INTEL_HAL_SUCCESS;
+    }
+#endif
+
+#ifdef INTEL_HAL_LINUX
+    return intel_linux_get_link(device->info.linux.interface_name, link_up, speed_mbps);
+#endif
+
+    return INTEL_HAL_ERROR_NOT_SUPPORTED;
+}
+
+intel_hal_result_t intel_hal_get_status(intel_device_t *device, intel_device_status_t *status)
+{
+    intel_timestamp_t timestamp;
+    
+    if (!device || !status) {
+        intel_hal_set_error("Invalid parameters for status query");
+        return INTEL_HAL_ERROR_INVALID_PARAM;
+    }
+    
+    memset(status, 0, sizeof(*status));
+    
+    /* Configuration from the state cache, one lock for a consistent view */
+    intel_hal_promote_tas_admin(device);
+    intel_hal_mutex_lock(&device->state_lock);
+    status->timestamping_enabled = device->state.timestamping_enabled;
+    status->tas_enabled = device->state.tas_enabled;
+    status->tas_base_time = device->state.tas.base_time;
+    status->tas_cycle_time = device->state.tas.cycle_time;
+    status->tas_gate_count = device->state.tas.gate_control_list_length;
+    status->fp_enabled = device->state.fp_enabled;
+    status->fp_preemptible_queues = device->state.fp.preemptible_queues;
+    memcpy(status->cbs, device->state.cbs, sizeof(status->cbs));
+    intel_hal_mutex_unlock(&device->state_lock);
+    
+    status->frequency_ppb = (int32_t)intel_atomic_load_u32(&device->servo.frequency_ppb);
+    status->frequency_adjustments = intel_atomic_load_u64(&device->servo.adjust_count);
+    status->time_steps = intel_atomic_load_u64(&device->servo.step_count);
+    
+    /* Device reads: link state and PHC */
+    intel_hal_read_link(device, &status->link_up, &status->speed_mbps);
+    
+    if (intel_device_has_capability(device, INTEL_CAP_BASIC_1588) &&
+        intel_hal_read_timestamp_unchecked(device, &timestamp) == INTEL_HAL_SUCCESS) {
+        status->phc_valid = true;
+        status->phc_time = timestamp.seconds * 1000000000ULL + timestamp.nanoseconds;
+    }
+    
+    return INTEL_HAL_SUCCESS;
+}
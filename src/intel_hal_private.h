@@ -19,14 +19,6 @@
 extern "C" {
 #endif
 
-/* Internal device structure definition */
-struct intel_device {
-    intel_device_info_t info;
-    bool is_open;
-    void *platform_data;
-    uint32_t ref_count;
-};
-
 /* Platform-specific function declarations */
 #ifdef INTEL_HAL_WINDOWS
 intel_hal_result_t intel_windows_init_device(intel_device_t *device, uint16_t device_id);
@@ -35,6 +27,8 @@ intel_hal_result_t intel_windows_read_timestamp(intel_device_t *device, intel_ti
 const char *intel_windows_get_last_error(void);
 bool intel_windows_has_modern_ndis_support(void);
 intel_hal_result_t find_intel_adapter_by_device_id(uint16_t device_id, intel_device_info_t *info);
+intel_hal_result_t intel_windows_enumerate_records(intel_device_record_t *records, uint32_t capacity, uint32_t *total);
+intel_hal_result_t intel_windows_init_device_instance(intel_device_t *device, const intel_device_record_t *record);
 #endif
 
 #ifdef INTEL_HAL_LINUX
@@ -42,12 +36,296 @@ intel_hal_result_t intel_linux_init_device(intel_device_t *device, uint16_t devi
 void intel_linux_cleanup_device(intel_device_t *device);
 intel_hal_result_t intel_linux_read_timestamp(intel_device_t *device, intel_timestamp_t *timestamp);
 const char *intel_linux_get_last_error(void);
+intel_hal_result_t intel_linux_get_numa_node(const char *interface_name, int32_t *node);
+intel_hal_result_t intel_linux_get_node_cpus(int32_t node, uint64_t *cpu_mask, uint32_t words);
+intel_hal_result_t intel_linux_get_link(const char *interface_name, bool *link_up, uint32_t *speed_mbps);
+intel_hal_result_t intel_linux_enumerate_records(intel_device_record_t *records, uint32_t capacity, uint32_t *total);
+intel_hal_result_t intel_linux_get_record(const char *interface_name, intel_device_record_t *record);
+intel_hal_result_t intel_linux_init_device_instance(intel_device_t *device, const intel_device_record_t *record);
+#endif
+
+/* Portable atomics: MSVC Interlocked intrinsics or GCC/Clang __atomic builtins */
+#ifdef _MSC_VER
+#include <intrin.h>
+
+static inline uint32_t intel_atomic_load_u32(const volatile uint32_t *ptr)
+{
+    uint32_t value = *ptr;
+    _ReadWriteBarrier();
+    return value;
+}
+
+static inline void intel_atomic_store_u32(volatile uint32_t *ptr, uint32_t value)
+{
+    _ReadWriteBarrier();
+    *ptr = value;
+}
+
+static inline bool intel_atomic_cas_u32(volatile uint32_t *ptr, uint32_t expected, uint32_t desired)
+{
+    return (uint32_t)_InterlockedCompareExchange((volatile long *)ptr, (long)desired, (long)expected) == expected;
+}
+
+static inline uint64_t intel_atomic_load_u64(const volatile uint64_t *ptr)
+{
+    return (uint64_t)_InterlockedCompareExchange64((volatile __int64 *)ptr, 0, 0);
+}
+
+static inline void intel_atomic_store_u64(volatile uint64_t *ptr, uint64_t value)
+{
+    _InterlockedExchange64((volatile __int64 *)ptr, (__int64)value);
+}
+
+static inline bool intel_atomic_cas_u64(volatile uint64_t *ptr, uint64_t expected, uint64_t desired)
+{
+    return (uint64_t)_InterlockedCompareExchange64((volatile __int64 *)ptr, (__int64)desired, (__int64)expected) == expected;
+}
+
+static inline uint64_t intel_atomic_fetch_add_u64(volatile uint64_t *ptr, uint64_t value)
+{
+    return (uint64_t)_InterlockedExchangeAdd64((volatile __int64 *)ptr, (__int64)value);
+}
+#else
+static inline uint32_t intel_atomic_load_u32(const volatile uint32_t *ptr)
+{
+    return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+}
+
+static inline void intel_atomic_store_u32(volatile uint32_t *ptr, uint32_t value)
+{
+    __atomic_store_n(ptr, value, __ATOMIC_RELEASE);
+}
+
+static inline bool intel_atomic_cas_u32(volatile uint32_t *ptr, uint32_t expected, uint32_t desired)
+{
+    return __atomic_compare_exchange_n(ptr, &expected, desired, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+}
+
+static inline uint64_t intel_atomic_load_u64(const volatile uint64_t *ptr)
+{
+    return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+}
+
+static inline void intel_atomic_store_u64(volatile uint64_t *ptr, uint64_t value)
+{
+    __atomic_store_n(ptr, value, __ATOMIC_RELEASE);
+}
+
+static inline bool intel_atomic_cas_u64(volatile uint64_t *ptr, uint64_t expected, uint64_t desired)
+{
+    return __atomic_compare_exchange_n(ptr, &expected, desired, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+}
+
+static inline uint64_t intel_atomic_fetch_add_u64(volatile uint64_t *ptr, uint64_t value)
+{
+    return __atomic_fetch_add(ptr, value, __ATOMIC_ACQ_REL);
+}
+#endif
+
+#ifdef _MSC_VER
+static inline void *intel_atomic_load_ptr(void *const volatile *ptr)
+{
+    void *value = *ptr;
+    _ReadWriteBarrier();
+    return value;
+}
+
+static inline bool intel_atomic_cas_ptr(void *volatile *ptr, void *expected, void *desired)
+{
+    return InterlockedCompareExchangePointer(ptr, desired, expected) == expected;
+}
+#else
+static inline void *intel_atomic_load_ptr(void *const volatile *ptr)
+{
+    return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+}
+
+static inline bool intel_atomic_cas_ptr(void *volatile *ptr, void *expected, void *desired)
+{
+    return __atomic_compare_exchange_n(ptr, &expected, desired, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+}
 #endif
 
+/* Portable mutex */
+#ifdef INTEL_HAL_WINDOWS
+typedef CRITICAL_SECTION intel_hal_mutex_t;
+static inline void intel_hal_mutex_init(intel_hal_mutex_t *mutex) { InitializeCriticalSection(mutex); }
+static inline void intel_hal_mutex_destroy(intel_hal_mutex_t *mutex) { DeleteCriticalSection(mutex); }
+static inline void intel_hal_mutex_lock(intel_hal_mutex_t *mutex) { EnterCriticalSection(mutex); }
+static inline void intel_hal_mutex_unlock(intel_hal_mutex_t *mutex) { LeaveCriticalSection(mutex); }
+#else
+#include <pthread.h>
+typedef pthread_mutex_t intel_hal_mutex_t;
+static inline void intel_hal_mutex_init(intel_hal_mutex_t *mutex) { pthread_mutex_init(mutex, NULL); }
+static inline void intel_hal_mutex_destroy(intel_hal_mutex_t *mutex) { pthread_mutex_destroy(mutex); }
+static inline void intel_hal_mutex_lock(intel_hal_mutex_t *mutex) { pthread_mutex_lock(mutex); }
+static inline void intel_hal_mutex_unlock(intel_hal_mutex_t *mutex) { pthread_mutex_unlock(mutex); }
+#endif
+
+/* Preamble, start delimiter and minimum inter-packet gap */
+#define INTEL_WIRE_OVERHEAD_BYTES   20
+
+/* Time a frame occupies the wire, overhead included, in nanoseconds rounded up */
+static inline uint64_t intel_wire_time_ns(uint64_t frame_size, uint32_t link_speed_mbps)
+{
+    return ((frame_size + INTEL_WIRE_OVERHEAD_BYTES) * 8000ULL + link_speed_mbps - 1) / link_speed_mbps;
+}
+
+/* Hierarchical timing wheel (intel_timer_wheel.c), O(1) insert and cancel */
+#define INTEL_TIMER_WHEEL_LEVELS    4
+#define INTEL_TIMER_WHEEL_SLOTS     256
+
+typedef struct intel_timer_node {
+    struct intel_timer_node *next;
+    struct intel_timer_node *prev;
+    uint64_t expires;                   /* Expiry time in nanoseconds */
+} intel_timer_node_t;
+
+typedef struct {
+    intel_timer_node_t slots[INTEL_TIMER_WHEEL_LEVELS][INTEL_TIMER_WHEEL_SLOTS];  /* List heads */
+    uint64_t occupied[INTEL_TIMER_WHEEL_LEVELS][INTEL_TIMER_WHEEL_SLOTS / 64];    /* Non-empty slot bitmap */
+    intel_timer_node_t due;             /* Nodes already due when added */
+    uint64_t current_tick;              /* Next tick to expire */
+    uint32_t granularity_shift;         /* Tick = 2^shift ns */
+    uint32_t count;                     /* Pending nodes */
+} intel_timer_wheel_t;
+
+void intel_timer_wheel_init(intel_timer_wheel_t *wheel, uint64_t now_ns, uint32_t granularity_shift);
+void intel_timer_wheel_add(intel_timer_wheel_t *wheel, intel_timer_node_t *node);
+void intel_timer_wheel_remove(intel_timer_wheel_t *wheel, intel_timer_node_t *node);
+uint32_t intel_timer_wheel_advance(intel_timer_wheel_t *wheel, uint64_t now_ns, intel_timer_node_t *expired);
+bool intel_timer_wheel_next_expiry(const intel_timer_wheel_t *wheel, uint64_t *expiry_ns);
+
+/* PHC-time-triggered scheduler (intel_scheduler.c) */
+struct intel_scheduler;
+void intel_scheduler_destroy(struct intel_scheduler *scheduler);
+/* Cancel and wait for an in-progress callback to return; *started reports whether
+ * it had begun. Must not be called for an entry from its own callback. */
+intel_hal_result_t intel_scheduler_cancel_sync(intel_device_t *device, intel_hal_schedule_id_t id, bool *started);
+/* Id of the entry whose callback is running; only meaningful inside a callback */
+intel_hal_schedule_id_t intel_scheduler_current_id(intel_device_t *device);
+
+/* Scheduled configuration changes (intel_config_queue.c) */
+struct intel_config_queue;
+void intel_config_queue_destroy(struct intel_config_queue *queue);
+
+/* Software Time-Aware Shaper for families without hardware TAS (intel_soft_tas.c) */
+struct intel_soft_tas;
+intel_hal_result_t intel_soft_tas_configure(intel_device_t *device, const intel_tas_config_t *config);
+intel_hal_result_t intel_soft_tas_stage(intel_device_t *device, const intel_tas_config_t *config);
+void intel_soft_tas_open_times(const intel_tas_config_t *config, uint64_t open_ns[INTEL_HAL_TAS_MAX_ENTRIES][8]);
+void intel_soft_tas_destroy(struct intel_soft_tas *soft);
+
+/* Launch-time transmit scheduler (intel_launch.c) */
+struct intel_launch;
+void intel_launch_destroy(struct intel_launch *launch);
+
+/* Packet buffer pools (intel_packet_pool.c) */
+intel_hal_packet_pool_t *intel_packet_pool_hold(intel_device_t *device, const void *buffer);
+void intel_packet_pool_release(intel_hal_packet_pool_t *pool, void *buffer);
+void intel_packet_pools_destroy(intel_device_t *device);
+
+/* Device configuration cache, updated by successful configure calls */
+typedef struct {
+    bool timestamping_enabled;
+    intel_cbs_config_t cbs[8];
+    uint8_t priority_map[8];            /* 802.1p priority -> traffic class */
+    uint32_t bandwidth_percent[8];
+    uint32_t rate_limit_mbps[8];
+    uint32_t vlan_filter[128];          /* VFTA shadow, one bit per VLAN ID */
+    bool tas_enabled;
+    intel_tas_config_t tas;
+    bool fp_enabled;
+    intel_frame_preemption_config_t fp;
+} intel_device_state_t;
+
+/* Bandwidth ledger claim kinds per traffic class */
+enum {
+    INTEL_LEDGER_BANDWIDTH = 0,         /* Bandwidth allocation percentage of capacity */
+    INTEL_LEDGER_CBS,                   /* CBS idle slope */
+    INTEL_LEDGER_RATE_LIMIT,            /* Rate limit */
+    INTEL_LEDGER_STREAMS,               /* Sum of intel_hal_bandwidth_reserve() */
+    INTEL_LEDGER_KINDS
+};
+
+/* Port bandwidth ledger; updates hold lock, queries read the atomics only */
+typedef struct {
+    intel_hal_mutex_t lock;
+    volatile uint64_t capacity_bps;
+    volatile uint64_t committed_bps;    /* Sum of tc_bps */
+    volatile uint64_t tc_bps[8];        /* Largest claim per class */
+    uint64_t claims[8][INTEL_LEDGER_KINDS];
+} intel_bandwidth_ledger_t;
+
+/* Staged admin TAS schedule (protected by state_lock) */
+typedef struct {
+    bool pending;                       /* Not yet operational; promoted into state.tas at its base time */
+    intel_tas_config_t config;          /* base_time is the AdminBaseTime */
+    intel_tas_index_t index;            /* entry_count 0 if the list cannot be indexed */
+} intel_tas_admin_t;
+
+/* Frame preemption counter accumulation (protected by state_lock) */
+typedef struct {
+    intel_fp_counters_t total;
+    intel_fp_counters_t since_configure;    /* Evidence for the inferred verify status */
+    uint64_t configured_ns;             /* PHC time of the last preemption configuration */
+} intel_fp_monitor_t;
+
+/* Clock servo activity, updated without the state lock */
+typedef struct {
+    volatile uint32_t frequency_ppb;    /* Last frequency adjustment (int32_t bits) */
+    volatile uint64_t adjust_count;
+    volatile uint64_t step_count;
+} intel_device_servo_t;
+
+/* Internal device structure definition */
+struct intel_device {
+    intel_device_info_t info;
+    bool is_open;
+    void *platform_data;
+    uint32_t ref_count;
+    intel_device_record_t record;       /* Instance identity (interface index, PCI address) */
+    struct intel_scheduler *scheduler;  /* PHC-time scheduler, created on first use */
+    struct intel_config_queue *config_queue; /* Scheduled configuration completions, created on first use */
+    struct intel_soft_tas *soft_tas;    /* Software gate schedule (no hardware TAS), created on first use */
+    struct intel_launch *launch;        /* Launch-time transmit scheduler, created on first use */
+    intel_hal_packet_pool_t *packet_pools[INTEL_HAL_MAX_PACKET_POOLS];  /* Registered transmit buffer pools */
+    intel_hal_mutex_t state_lock;       /* Protects state */
+    intel_device_state_t state;
+    intel_tas_index_t tas_index;        /* Lookup index of state.tas */
+    intel_tas_admin_t tas_admin;
+    intel_fp_monitor_t fp_monitor;
+    intel_device_servo_t servo;
+    intel_bandwidth_ledger_t ledger;
+    /* Replaces the PHC when set (host-only devices in tests) */
+    intel_hal_result_t (*host_clock)(intel_device_t *device, intel_timestamp_t *timestamp);
+};
+
+/* HAL error reporting shared by all modules (read via intel_hal_get_last_error) */
+void intel_hal_set_error(const char *format, ...);
+
+/* Current link state; speed 0 if the link is down or unknown */
+intel_hal_result_t intel_hal_read_link(intel_device_t *device, bool *link_up, uint32_t *speed_mbps);
+
+/* Program a hardware TAS schedule (INTEL_CAP_TSN_TAS) that switches at its base time;
+   the state cache keeps the running schedule until then */
+intel_hal_result_t intel_hal_tas_program_staged(intel_device_t *device, const intel_tas_config_t *config);
+
+/* Port bandwidth ledger (intel_ledger.c) */
+void intel_ledger_init(intel_device_t *device);
+void intel_ledger_destroy(intel_device_t *device);
+intel_hal_result_t intel_ledger_claim(intel_device_t *device, uint8_t tc, uint32_t kind, uint64_t bps);
+intel_hal_result_t intel_ledger_load(intel_device_t *device, const intel_device_state_t *state);
+
+/* Open device registry (intel_registry.c) */
+intel_hal_result_t intel_registry_add(intel_device_t *device);
+void intel_registry_remove(intel_device_t *device);
+
 /* Common device functions */
 intel_device_t *intel_device_create(uint16_t device_id);
 void intel_device_destroy(intel_device_t *device);
 bool intel_device_has_capability(intel_device_t *device, uint32_t capability);
+const char *intel_device_lookup(uint16_t device_id, intel_device_family_t *family, uint32_t *capabilities);
 void intel_device_print_capabilities(intel_device_t *device);
 intel_hal_result_t intel_get_supported_devices(uint16_t *device_ids, uint32_t *count);
 
@@ -0,0 +1,64 @@
+/******************************************************************************
+
+  Copyright (c) 2025, Intel Corporation
+  All rights reserved.
+
+  Intel Ethernet HAL - Linux Per-interface Device Binding
+
+  Binds a HAL device to one specific interface instance (from an
+  enumeration record) rather than to the first adapter with a matching
+  device ID, so multiple ports of the same model can be opened.
+
+******************************************************************************/
+
+#include "../include/intel_ethernet_hal.h"
+#include "../intel_hal_private.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <net/if.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+
+/**
+ * @brief Initialize the Linux context of a device for one interface
+ *
+ * Opens the interface's PHC (/dev/ptpN) and a control socket; both are
+ * released by intel_linux_cleanup_device().
+ */
+intel_hal_result_t intel_linux_init_device_instance(intel_device_t *device, const intel_device_record_t *record)
+{
+    intel_linux_context_t *context = &device->info.linux;
+    char path[32];
+
+    if (!record->if_index || !if_indextoname(record->if_index, context->interface_name)) {
+        intel_hal_set_error("Interface index %u not found", (unsigned int)record->if_index);
+        return INTEL_HAL_ERROR_NO_DEVICE;
+    }
+
+    context->ptp_fd = -1;
+    context->has_phc = false;
+    context->socket_fd = socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    if (context->socket_fd < 0) {
+        intel_hal_set_error("Cannot create control socket: %s", strerror(errno));
+        return INTEL_HAL_ERROR_OS_SPECIFIC;
+    }
+
+    if (record->ptp_index >= 0) {
+        snprintf(path, sizeof(path), "/dev/ptp%d", (int)record->ptp_index);
+        context->ptp_fd = open(path, O_RDWR | O_CLOEXEC);
+        if (context->ptp_fd < 0) {
+            int error = errno;          /* close() may overwrite it */
+
+            intel_hal_set_error("Cannot open %s: %s", path, strerror(error));
+            close(context->socket_fd);
+            context->socket_fd = -1;
+            return error == EACCES ? INTEL_HAL_ERROR_ACCESS_DENIED : INTEL_HAL_ERROR_OS_SPECIFIC;
+        }
+        context->has_phc = ioctl(context->ptp_fd, PTP_CLOCK_GETCAPS, &context->ptp_caps) == 0;
+    }
+
+    return INTEL_HAL_SUCCESS;
+}
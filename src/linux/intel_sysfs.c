@@ -0,0 +1,304 @@
+/******************************************************************************
+
+  Copyright (c) 2025, Intel Corporation
+  All rights reserved.
+
+  Intel Ethernet HAL - Linux sysfs Integration
+
+  This module reads adapter topology (PCI device, NUMA node, node CPUs) and
+  link state from sysfs for enumeration, thread placement and status queries.
+
+******************************************************************************/
+
+#include "../include/intel_ethernet_hal.h"
+#include "../intel_hal_private.h"
+#include <dirent.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/**
+ * @brief Read a single-line sysfs attribute
+ */
+static bool read_sysfs_line(const char *path, char *buf, size_t size)
+{
+    FILE *file = fopen(path, "r");
+    bool ok;
+
+    if (!file) {
+        return false;
+    }
+    ok = fgets(buf, (int)size, file) != NULL;
+    fclose(file);
+    return ok;
+}
+
+/**
+ * @brief Get the NUMA node of a network interface's PCI device
+ *
+ * Reads /sys/class/net/<if>/device/numa_node, which is the numa_node
+ * attribute of the interface's /sys/bus/pci/devices/<bdf> entry.
+ */
+intel_hal_result_t intel_linux_get_numa_node(const char *interface_name, int32_t *node)
+{
+    char path[128];
+    char line[32];
+
+    if (!interface_name || !interface_name[0] || !node) {
+        return INTEL_HAL_ERROR_INVALID_PARAM;
+    }
+
+    snprintf(path, sizeof(path), "/sys/class/net/%s/device/numa_node", interface_name);
+    if (!read_sysfs_line(path, line, sizeof(line))) {
+        intel_hal_set_error("Cannot read %s", path);
+        return INTEL_HAL_ERROR_OS_SPECIFIC;
+    }
+
+    /* Single-node systems report -1 */
+    *node = (int32_t)strtol(line, NULL, 10);
+    return INTEL_HAL_SUCCESS;
+}
+
+/**
+ * @brief Get the CPUs of a NUMA node as a bit mask
+ *
+ * Parses the cpulist format ("0-7,16-23") of
+ * /sys/devices/system/node/node<N>/cpulist.
+ */
+intel_hal_result_t intel_linux_get_node_cpus(int32_t node, uint64_t *cpu_mask, uint32_t words)
+{
+    char path[96];
+    char line[1024];
+    char *cursor;
+
+    if (node < 0 || !cpu_mask || words == 0) {
+        return INTEL_HAL_ERROR_INVALID_PARAM;
+    }
+
+    snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist", (int)node);
+    if (!read_sysfs_line(path, line, sizeof(line))) {
+        intel_hal_set_error("Cannot read %s", path);
+        return INTEL_HAL_ERROR_OS_SPECIFIC;
+    }
+
+    memset(cpu_mask, 0, words * sizeof(uint64_t));
+    cursor = line;
+    while (*cursor && *cursor != '\n') {
+        char *end;
+        unsigned long first = strtoul(cursor, &end, 10);
+        unsigned long last = first;
+        unsigned long cpu;
+
+        if (end == cursor) {
+            break;
+        }
+        if (*end == '-') {
+            cursor = end + 1;
+            last = strtoul(cursor, &end, 10);
+        }
+        for (cpu = first; cpu <= last && cpu < (unsigned long)words * 64; cpu++) {
+            cpu_mask[cpu / 64] |= 1ULL << (cpu % 64);
+        }
+        cursor = (*end == ',') ? end + 1 : end;
+    }
+
+    return INTEL_HAL_SUCCESS;
+}
+
+/**
+ * @brief Get link state and speed of a network interface
+ *
+ * Reads /sys/class/net/<if>/operstate and /sys/class/net/<if>/speed;
+ * speed is reported as 0 while the link is down.
+ */
+intel_hal_result_t intel_linux_get_link(const char *interface_name, bool *link_up, uint32_t *speed_mbps)
+{
+    char path[128];
+    char line[32];
+    long speed;
+
+    if (!interface_name || !interface_name[0] || !link_up || !speed_mbps) {
+        return INTEL_HAL_ERROR_INVALID_PARAM;
+    }
+
+    snprintf(path, sizeof(path), "/sys/class/net/%s/operstate", interface_name);
+    if (!read_sysfs_line(path, line, sizeof(line))) {
+        intel_hal_set_error("Cannot read %s", path);
+        return INTEL_HAL_ERROR_OS_SPECIFIC;
+    }
+    *link_up = strncmp(line, "up", 2) == 0;
+    *speed_mbps = 0;
+
+    /* Reading speed fails with EINVAL while the link is down */
+    snprintf(path, sizeof(path), "/sys/class/net/%s/speed", interface_name);
+    if (*link_up && read_sysfs_line(path, line, sizeof(line))) {
+        speed = strtol(line, NULL, 10);
+        *speed_mbps = speed > 0 ? (uint32_t)speed : 0;
+    }
+
+    return INTEL_HAL_SUCCESS;
+}
+
+static bool read_sysfs_ulong(const char *path, int base, unsigned long *value)
+{
+    char line[32];
+    char *end;
+
+    if (!read_sysfs_line(path, line, sizeof(line))) {
+        return false;
+    }
+    *value = strtoul(line, &end, base);
+    return end != line;
+}
+
+/**
+ * @brief Get the PHC index of an interface from its device/ptp/ptpN entry
+ */
+static int32_t read_ptp_index(const char *interface_name)
+{
+    char path[128];
+    struct dirent *entry;
+    int32_t index = -1;
+    DIR *dir;
+
+    snprintf(path, sizeof(path), "/sys/class/net/%s/device/ptp", interface_name);
+    dir = opendir(path);
+    if (!dir) {
+        return -1;
+    }
+    while ((entry = readdir(dir)) != NULL) {
+        if (strncmp(entry->d_name, "ptp", 3) == 0) {
+            index = (int32_t)strtol(entry->d_name + 3, NULL, 10);
+            break;
+        }
+    }
+    closedir(dir);
+    return index;
+}
+
+/**
+ * @brief Parse the PCI address from the /sys/class/net/<if>/device link
+ */
+static void read_pci_address(const char *interface_name, intel_device_record_t *record)
+{
+    char path[128];
+    char target[256];
+    unsigned int domain, bus, dev, function;
+    const char *bdf;
+    ssize_t length;
+
+    snprintf(path, sizeof(path), "/sys/class/net/%s/device", interface_name);
+    length = readlink(path, target, sizeof(target) - 1);
+    if (length <= 0) {
+        return;
+    }
+    target[length] = '\0';
+
+    bdf = strrchr(target, '/');
+    bdf = bdf ? bdf + 1 : target;
+    if (sscanf(bdf, "%x:%x:%x.%x", &domain, &bus, &dev, &function) == 4) {
+        record->pci_domain = (uint16_t)domain;
+        record->pci_bus = (uint8_t)bus;
+        record->pci_device = (uint8_t)dev;
+        record->pci_function = (uint8_t)function;
+    }
+}
+
+static uint32_t pci_address_key(const intel_device_record_t *record)
+{
+    return ((uint32_t)record->pci_domain << 16) | ((uint32_t)record->pci_bus << 8) |
+           ((uint32_t)record->pci_device << 3) | record->pci_function;
+}
+
+/**
+ * @brief Build the device record of a network interface
+ *
+ * @return INTEL_HAL_ERROR_NOT_SUPPORTED if the interface is not a supported
+ *         Intel adapter
+ */
+intel_hal_result_t intel_linux_get_record(const char *interface_name, intel_device_record_t *record)
+{
+    char path[128];
+    unsigned long vendor_id, device_id, if_index;
+    intel_device_family_t family;
+    uint32_t capabilities;
+    const char *name;
+
+    snprintf(path, sizeof(path), "/sys/class/net/%s/device/vendor", interface_name);
+    if (!read_sysfs_ulong(path, 16, &vendor_id) || vendor_id != INTEL_VENDOR_ID) {
+        return INTEL_HAL_ERROR_NOT_SUPPORTED;
+    }
+    snprintf(path, sizeof(path), "/sys/class/net/%s/device/device", interface_name);
+    if (!read_sysfs_ulong(path, 16, &device_id)) {
+        return INTEL_HAL_ERROR_NOT_SUPPORTED;
+    }
+    name = intel_device_lookup((uint16_t)device_id, &family, &capabilities);
+    if (!name) {
+        return INTEL_HAL_ERROR_NOT_SUPPORTED;
+    }
+
+    memset(record, 0, sizeof(*record));
+    record->capabilities = capabilities;
+    record->device_id = (uint16_t)device_id;
+    record->family = (uint8_t)family;
+    record->name = name;
+    snprintf(path, sizeof(path), "/sys/class/net/%s/ifindex", interface_name);
+    if (read_sysfs_ulong(path, 10, &if_index)) {
+        record->if_index = (uint32_t)if_index;
+    }
+    record->ptp_index = read_ptp_index(interface_name);
+    read_pci_address(interface_name, record);
+    return INTEL_HAL_SUCCESS;
+}
+
+/**
+ * @brief Enumerate supported Intel interfaces from /sys/class/net
+ *
+ * Fills up to 'capacity' records with the devices of lowest PCI address, in
+ * that order, and counts all supported devices present in *total.
+ */
+intel_hal_result_t intel_linux_enumerate_records(intel_device_record_t *records, uint32_t capacity, uint32_t *total)
+{
+    struct dirent *entry;
+    uint32_t found = 0;
+    uint32_t key;
+    uint32_t i;
+    DIR *dir;
+
+    dir = opendir("/sys/class/net");
+    if (!dir) {
+        intel_hal_set_error("Cannot open /sys/class/net");
+        return INTEL_HAL_ERROR_OS_SPECIFIC;
+    }
+
+    while ((entry = readdir(dir)) != NULL) {
+        intel_device_record_t record;
+
+        if (entry->d_name[0] == '.' ||
+            intel_linux_get_record(entry->d_name, &record) != INTEL_HAL_SUCCESS) {
+            continue;
+        }
+
+        /* Keep the 'capacity' lowest PCI addresses in order: readdir order is arbitrary,
+         * so a full buffer drops its last record when a lower address turns up */
+        key = pci_address_key(&record);
+        if (found < capacity) {
+            i = found;
+        } else if (capacity > 0 && pci_address_key(&records[capacity - 1]) > key) {
+            i = capacity - 1;
+        } else {
+            found++;
+            continue;
+        }
+        for (; i > 0 && pci_address_key(&records[i - 1]) > key; i--) {
+            records[i] = records[i - 1];
+        }
+        records[i] = record;
+        found++;
+    }
+    closedir(dir);
+
+    *total = found;
+    return INTEL_HAL_SUCCESS;
+}
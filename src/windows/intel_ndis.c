@@ -22,9 +22,12 @@
 #include <iphlpapi.h>
 #include <ntddndis.h>
 #include <winioctl.h>
+#include <setupapi.h>
+#include <devguid.h>
 
 #pragma comment(lib, "iphlpapi.lib")
 #pragma comment(lib, "ws2_32.lib")
+#pragma comment(lib, "setupapi.lib")
 
 /* Windows-specific error handling */
 static char last_error_message[512] = {0};
@@ -230,6 +233,47 @@ intel_hal_result_t intel_windows_init_device(intel_device_t *device, uint16_t de
     return INTEL_HAL_SUCCESS;
 }
 
+/**
+ * @brief Initialize Windows-specific functionality for one adapter instance
+ *
+ * Binds the device to the interface index of an enumeration record instead
+ * of the first adapter with a matching device ID.
+ */
+intel_hal_result_t intel_windows_init_device_instance(intel_device_t *device, const intel_device_record_t *record)
+{
+    MIB_IF_ROW2 row;
+    GUID *guid = &row.InterfaceGuid;
+    
+    memset(&row, 0, sizeof(row));
+    row.InterfaceIndex = record->if_index;
+    if (record->if_index == 0 || GetIfEntry2(&row) != NO_ERROR) {
+        set_last_error("Interface index %u not found", (unsigned int)record->if_index);
+        return INTEL_HAL_ERROR_NO_DEVICE;
+    }
+    
+    device->info.windows.adapter_index = record->if_index;
+    device->info.windows.adapter_luid = row.InterfaceLuid;
+    _snprintf_s(device->info.windows.adapter_name, sizeof(device->info.windows.adapter_name), _TRUNCATE,
+               "{%08lX-%04X-%04X-%02X%02X-%02X%02X%02X%02X%02X%02X}",
+               guid->Data1, guid->Data2, guid->Data3,
+               guid->Data4[0], guid->Data4[1], guid->Data4[2], guid->Data4[3],
+               guid->Data4[4], guid->Data4[5], guid->Data4[6], guid->Data4[7]);
+    WideCharToMultiByte(CP_ACP, 0, row.Description, -1, device->info.description,
+                        (int)sizeof(device->info.description), NULL, NULL);
+    
+    if (query_ndis_timestamp_caps(device) != INTEL_HAL_SUCCESS) {
+        device->info.windows.has_native_timestamp = false;
+    }
+    
+    WSADATA wsa_data;
+    if (WSAStartup(MAKEWORD(2, 2), &wsa_data) != 0) {
+        set_last_error("WSAStartup failed: %d", WSAGetLastError());
+        return INTEL_HAL_ERROR_OS_SPECIFIC;
+    }
+    
+    return INTEL_HAL_SUCCESS;
+}
+
 /**
  * @brief Cleanup Windows-specific resources
  */
@@ -317,3 +361,110 @@ bool intel_windows_has_modern_ndis_support(void)
     
     return false;
 }
+
+/**
+ * @brief Resolve the interface index of a network device via its NetCfgInstanceId
+ */
+static uint32_t get_adapter_if_index(HDEVINFO device_set, SP_DEVINFO_DATA *device_data)
+{
+    char guid_string[64];
+    DWORD data_size = sizeof(guid_string);
+    unsigned int d[11];
+    NET_IFINDEX if_index = 0;
+    NET_LUID luid;
+    GUID guid;
+    HKEY key;
+    
+    key = SetupDiOpenDevRegKey(device_set, device_data, DICS_FLAG_GLOBAL, 0, DIREG_DRV, KEY_READ);
+    if (key == INVALID_HANDLE_VALUE) {
+        return 0;
+    }
+    
+    if (RegQueryValueEx(key, "NetCfgInstanceId", NULL, NULL, (LPBYTE)guid_string, &data_size) == ERROR_SUCCESS &&
+        sscanf_s(guid_string, "{%8x-%4x-%4x-%2x%2x-%2x%2x%2x%2x%2x%2x}",
+                 &d[0], &d[1], &d[2], &d[3], &d[4], &d[5], &d[6], &d[7], &d[8], &d[9], &d[10]) == 11) {
+        guid.Data1 = d[0];
+        guid.Data2 = (unsigned short)d[1];
+        guid.Data3 = (unsigned short)d[2];
+        for (int i = 0; i < 8; i++) {
+            guid.Data4[i] = (unsigned char)d[3 + i];
+        }
+        if (ConvertInterfaceGuidToLuid(&guid, &luid) != NO_ERROR ||
+            ConvertInterfaceLuidToIndex(&luid, &if_index) != NO_ERROR) {
+            if_index = 0;
+        }
+    }
+    
+    RegCloseKey(key);
+    return (uint32_t)if_index;
+}
+
+/**
+ * @brief Enumerate supported Intel network adapters via SetupAPI
+ *
+ * Fills up to 'capacity' records and counts all supported devices present
+ * in *total. Windows exposes no PHC index; ptp_index is always -1.
+ */
+intel_hal_result_t intel_windows_enumerate_records(intel_device_record_t *records, uint32_t capacity, uint32_t *total)
+{
+    HDEVINFO device_set;
+    SP_DEVINFO_DATA device_data;
+    uint32_t found = 0;
+    
+    device_set = SetupDiGetClassDevs(&GUID_DEVCLASS_NET, "PCI", NULL, DIGCF_PRESENT);
+    if (device_set == INVALID_HANDLE_VALUE) {
+        set_last_error("SetupDiGetClassDevs failed: %lu", GetLastError());
+        return INTEL_HAL_ERROR_OS_SPECIFIC;
+    }
+    
+    device_data.cbSize = sizeof(device_data);
+    for (DWORD index = 0; SetupDiEnumDeviceInfo(device_set, index, &device_data); index++) {
+        char hardware_id[512];
+        intel_device_family_t family;
+        uint32_t capabilities;
+        uint16_t device_id;
+        const char *name;
+        const char *dev;
+        
+        /* REG_MULTI_SZ; the first string is the most specific ID */
+        if (!SetupDiGetDeviceRegistryProperty(device_set, &device_data, SPDRP_HARDWAREID, NULL,
+                                              (PBYTE)hardware_id, sizeof(hardware_id), NULL) ||
+            !strstr(hardware_id, "VEN_8086") || !(dev = strstr(hardware_id, "DEV_"))) {
+            continue;
+        }
+        
+        device_id = (uint16_t)strtoul(dev + 4, NULL, 16);
+        name = intel_device_lookup(device_id, &family, &capabilities);
+        if (!name) {
+            continue;
+        }
+        
+        if (found < capacity) {
+            intel_device_record_t *record = &records[found];
+            DWORD bus = 0;
+            DWORD address = 0;
+            
+            memset(record, 0, sizeof(*record));
+            record->capabilities = capabilities;
+            record->device_id = device_id;
+            record->family = (uint8_t)family;
+            record->name = name;
+            record->ptp_index = -1;
+            
+            /* SPDRP_ADDRESS for PCI is (device << 16) | function */
+            SetupDiGetDeviceRegistryProperty(device_set, &device_data, SPDRP_BUSNUMBER, NULL,
+                                             (PBYTE)&bus, sizeof(bus), NULL);
+            SetupDiGetDeviceRegistryProperty(device_set, &device_data, SPDRP_ADDRESS, NULL,
+                                             (PBYTE)&address, sizeof(address), NULL);
+            record->pci_bus = (uint8_t)bus;
+            record->pci_device = (uint8_t)(address >> 16);
+            record->pci_function = (uint8_t)(address & 0xFFFF);
+            record->if_index = get_adapter_if_index(device_set, &device_data);
+        }
+        found++;
+    }
+    
+    SetupDiDestroyDeviceInfoList(device_set);
+    *total = found;
+    return INTEL_HAL_SUCCESS;
+}
@@ -0,0 +1,44 @@
+// avtp_test.c
+// Tests for the AVTP stream packetizer (no hardware required)
+
+#include <string.h>
+#include "test_common.h"
+
+int main(void) {
+    intel_avtp_stream_config_t config;
+    intel_avtp_stream_t stream;
+    intel_timed_packet_t packet;
+    uint8_t frame[INTEL_AVTP_HEADER_SIZE + 48];
+
+    memset(&config, 0, sizeof(config));
+    memcpy(config.dest_mac, "\x91\xe0\xf0\x00\xfe\x01", 6);
+    memcpy(config.src_mac, "\x00\x1b\x21\x01\x02\x03", 6);
+    config.vlan_id = 2;
+    config.vlan_pcp = 3;
+    config.subtype = INTEL_AVTP_SUBTYPE_AAF;
+    config.stream_id = 0x001b210102030001ULL;
+    config.format_specific_1 = 0x02050810;
+    config.queue = 1;
+    CHECK(intel_hal_avtp_stream_init(&stream, &config) == INTEL_HAL_SUCCESS, "stream initialized");
+
+    memset(frame, 0xAA, sizeof(frame));
+    CHECK(intel_hal_avtp_prepare(&stream, frame, 48, 0x100000000ULL + 1000, &packet) == INTEL_HAL_SUCCESS,
+          "first frame prepared");
+    CHECK(frame[12] == 0x81 && frame[13] == 0x00 && frame[14] == 0x60 && frame[15] == 0x02 &&
+          frame[16] == 0x22 && frame[17] == 0xF0, "VLAN tag and AVTP ethertype");
+    CHECK(frame[18] == INTEL_AVTP_SUBTYPE_AAF && frame[19] == 0x81 && frame[20] == 0, "subtype, sv/tv, sequence 0");
+    CHECK(frame[22] == 0x00 && frame[23] == 0x1b && frame[29] == 0x01, "stream ID big-endian");
+    // Presentation time = launch + 2 ms default transit, truncated to 32 bits: 1000 + 2000000 = 0x001E8868
+    CHECK(frame[30] == 0x00 && frame[31] == 0x1E && frame[32] == 0x88 && frame[33] == 0x68, "32-bit presentation time");
+    CHECK(frame[38] == 0 && frame[39] == 48 && frame[42] == 0xAA, "data length set, payload untouched");
+    CHECK(packet.packet_length == INTEL_AVTP_HEADER_SIZE + 48 && packet.queue == 1 &&
+          packet.launch_time == 0x100000000ULL + 1000, "timed packet descriptor");
+
+    CHECK(intel_hal_avtp_prepare(&stream, frame, 48, 0, &packet) == INTEL_HAL_SUCCESS && frame[20] == 1,
+          "sequence advances");
+
+    config.vlan_pcp = 8;
+    CHECK(intel_hal_avtp_stream_init(&stream, &config) == INTEL_HAL_ERROR_INVALID_PARAM, "invalid PCP rejected");
+
+    return TEST_RESULT("AVTP");
+}
@@ -0,0 +1,75 @@
+// broker_test.c
+// Tests for the multi-process device broker: slot claim, reclaim and stale requests
+// (no hardware required; the broker owns no devices, so requests complete with NO_DEVICE)
+
+#include <string.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "test_common.h"
+
+static intel_broker_request_t timestamp_request(uint64_t id) {
+    intel_broker_request_t request;
+    memset(&request, 0, sizeof(request));
+    request.request_id = id;
+    request.op = INTEL_BROKER_OP_READ_TIMESTAMP;
+    return request;
+}
+
+// Child process: claim a slot, queue a request and exit without disconnecting
+static void exit_with_pending_request(const char *name) {
+    intel_broker_client_t *client;
+    intel_broker_request_t request = timestamp_request(99);
+    int ok = intel_hal_broker_connect(name, &client) == INTEL_HAL_SUCCESS &&
+             intel_hal_broker_submit(client, &request) == INTEL_HAL_SUCCESS;
+    _exit(ok ? 0 : 1);
+}
+
+int main(void) {
+    char name[32];
+    intel_broker_t *broker;
+    intel_broker_client_t *first, *second, *third;
+    intel_broker_request_t request;
+    intel_broker_completion_t completion;
+    int status = 0;
+    pid_t child;
+
+    snprintf(name, sizeof(name), "test_%d", (int)getpid());
+    CHECK(intel_hal_broker_create(name, NULL, 0, 2, &broker) == INTEL_HAL_SUCCESS, "broker created");
+
+    // Claim: two slots, the third client is refused
+    CHECK(intel_hal_broker_connect(name, &first) == INTEL_HAL_SUCCESS, "first client claims a slot");
+    CHECK(intel_hal_broker_connect(name, &second) == INTEL_HAL_SUCCESS, "second client claims a slot");
+    CHECK(intel_hal_broker_connect(name, &third) == INTEL_HAL_ERROR_DEVICE_BUSY, "third client refused");
+
+    request = timestamp_request(1);
+    CHECK(intel_hal_broker_submit(first, &request) == INTEL_HAL_SUCCESS, "request submitted");
+    CHECK(intel_hal_broker_poll(broker, 0) == 1, "request serviced");
+    CHECK(intel_hal_broker_poll_completion(first, &completion) && completion.request_id == 1 &&
+          completion.result == INTEL_HAL_ERROR_NO_DEVICE, "completion returned to its client");
+    CHECK(!intel_hal_broker_poll_completion(second, &completion), "no completion for the other client");
+
+    // Reclaim: a slot whose owner exited is taken over; its queued request is dropped
+    intel_hal_broker_disconnect(second);
+    child = fork();
+    if (child == 0) {
+        exit_with_pending_request(name);
+    }
+    CHECK(child > 0 && waitpid(child, &status, 0) == child && WIFEXITED(status) && WEXITSTATUS(status) == 0,
+          "exited client left a request behind");
+    CHECK(intel_hal_broker_connect(name, &second) == INTEL_HAL_SUCCESS, "slot of the exited client reclaimed");
+    CHECK(intel_hal_broker_poll(broker, 0) == 0, "stale request not executed");
+    CHECK(!intel_hal_broker_poll_completion(second, &completion), "no completion for the stale request");
+
+    request = timestamp_request(2);
+    CHECK(intel_hal_broker_submit(second, &request) == INTEL_HAL_SUCCESS && intel_hal_broker_poll(broker, 0) == 1 &&
+          intel_hal_broker_poll_completion(second, &completion) && completion.request_id == 2,
+          "new owner serviced");
+
+    intel_hal_broker_disconnect(first);
+    intel_hal_broker_disconnect(second);
+    intel_hal_broker_destroy(broker);
+    CHECK(intel_hal_broker_connect(name, &first) == INTEL_HAL_ERROR_NO_DEVICE, "destroyed broker unavailable");
+
+    return TEST_RESULT("Broker");
+}
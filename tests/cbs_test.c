@@ -0,0 +1,38 @@
+// cbs_test.c
+// Tests for the SRP credit-based shaper calculation (no hardware required)
+
+#include <string.h>
+#include "test_common.h"
+
+int main(void) {
+    intel_cbs_config_t class_a, class_b;
+
+    // One Class A stream, 58-byte frames, one per 125 us on 1 Gbps:
+    // (58 + 42) * 8 * 8000 = 6.4 Mbps -> idleSlope 800000 B/s
+    intel_stream_reservation_t one = { INTEL_SR_CLASS_A, 58, 1 };
+    CHECK(intel_hal_calculate_cbs(&one, 1, 1000, 0, &class_a, &class_b) == INTEL_HAL_SUCCESS, "single stream admitted");
+    CHECK(class_a.enabled && class_a.idle_slope == 800000 && class_a.send_slope == 124200000, "Class A slopes");
+    // hiCredit = 1542 * 6.4M / 1G = 9.87 -> 10; loCredit = 100 * 993.6M / 1G = 99.36 -> 100
+    CHECK(class_a.hi_credit == 10 && class_a.lo_credit == 100, "Class A credits");
+    CHECK(!class_b.enabled && class_a.traffic_class == INTEL_AVB_CLASS_A, "Class B disabled without streams");
+
+    // Class B credits account for Class A interference:
+    // idleSlope_B = (200 + 42) * 8 * 4000 = 7.744 Mbps
+    // hiCredit_B = 7.744M * (1542 / (1G - 6.4M) + 100 / 1G) = 12.79 -> 13
+    intel_stream_reservation_t both[2] = { { INTEL_SR_CLASS_A, 58, 1 }, { INTEL_SR_CLASS_B, 200, 1 } };
+    CHECK(intel_hal_calculate_cbs(both, 2, 1000, 0, &class_a, &class_b) == INTEL_HAL_SUCCESS &&
+          class_b.idle_slope == 968000 && class_b.hi_credit == 13 && class_b.lo_credit == 241, "Class B credits");
+
+    // Eight 1500-byte Class A streams need 98.7 Mbps each: 79% > 75%
+    intel_stream_reservation_t heavy[8];
+    for (int i = 0; i < 8; i++) {
+        heavy[i].sr_class = INTEL_SR_CLASS_A;
+        heavy[i].max_frame_size = 1500;
+        heavy[i].max_interval_frames = 1;
+    }
+    CHECK(intel_hal_calculate_cbs(heavy, 8, 1000, 0, &class_a, &class_b) == INTEL_HAL_ERROR_NO_BANDWIDTH,
+          "over-subscription rejected");
+    CHECK(intel_hal_calculate_cbs(heavy, 7, 1000, 0, &class_a, &class_b) == INTEL_HAL_SUCCESS, "69% admitted");
+
+    return TEST_RESULT("CBS");
+}
@@ -0,0 +1,59 @@
+// config_queue_test.c
+// Tests for scheduled configuration changes on a host-only device whose PHC is the
+// system clock (no hardware required): apply, cancel and teardown with changes pending
+
+#include <string.h>
+#include <time.h>
+#include "test_common.h"
+#include "host_device.h"
+
+static intel_hal_config_change_t priority_map(uint8_t priority, uint8_t traffic_class) {
+    intel_hal_config_change_t change;
+    memset(&change, 0, sizeof(change));
+    change.type = INTEL_HAL_CHANGE_PRIORITY_MAP;
+    change.u.priority_map.priority = priority;
+    change.u.priority_map.traffic_class = traffic_class;
+    return change;
+}
+
+int main(void) {
+    intel_device_t *device = host_device_create();
+    intel_hal_config_change_t change;
+    intel_hal_config_completion_t completions[4];
+    struct timespec wait = { 0, 30000000 };
+    uint64_t applied_id = 0, cancelled_id = 0, pending_id = 0;
+    uint64_t start;
+    uint32_t count = 0;
+
+    CHECK(device != NULL, "host-only device created");
+    if (!device) {
+        return TEST_RESULT("Config queue");
+    }
+    start = host_now_ns();
+
+    change = priority_map(2, 5);
+    CHECK(intel_hal_submit_config_change(device, &change, start + 5000000, &applied_id) == INTEL_HAL_SUCCESS,
+          "change submitted for +5 ms");
+    change = priority_map(3, 6);
+    CHECK(intel_hal_submit_config_change(device, &change, start + 20000000, &cancelled_id) == INTEL_HAL_SUCCESS,
+          "change submitted for +20 ms");
+    change = priority_map(4, 7);
+    CHECK(intel_hal_submit_config_change(device, &change, start + 60000000000ULL, &pending_id) == INTEL_HAL_SUCCESS,
+          "change submitted for +60 s");
+
+    CHECK(intel_hal_cancel_config_change(device, cancelled_id) == INTEL_HAL_SUCCESS, "pending change cancelled");
+    CHECK(intel_hal_cancel_config_change(device, cancelled_id) == INTEL_HAL_ERROR_INVALID_PARAM,
+          "second cancel rejected");
+
+    nanosleep(&wait, NULL);
+    intel_hal_read_config_completions(device, completions, 4, &count);
+    CHECK(count == 1 && completions[0].change_id == applied_id && completions[0].result == INTEL_HAL_SUCCESS &&
+          completions[0].applied_time >= start + 5000000, "only the remaining due change completed");
+    CHECK(device->state.priority_map[2] == 5 && device->state.priority_map[3] != 6, "cancelled change not applied");
+    CHECK(intel_hal_cancel_config_change(device, applied_id) == INTEL_HAL_ERROR_INVALID_PARAM,
+          "applied change cannot be cancelled");
+
+    // Teardown in device close order releases the change still pending
+    host_device_destroy(device);
+    return TEST_RESULT("Config queue");
+}
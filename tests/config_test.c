@@ -0,0 +1,65 @@
+// config_test.c
+// Tests for configuration snapshot and restore on a host-only device instance (no hardware required)
+
+#include <string.h>
+#include "test_common.h"
+#include "intel_hal_private.h"
+
+int main(void) {
+    intel_device_t *device = intel_device_create(INTEL_DEVICE_I210_1533);
+    intel_device_t *other = intel_device_create(INTEL_DEVICE_I226_125B);
+    intel_device_state_t saved;
+    uint8_t blob[2048];
+    size_t size = 0;
+
+    CHECK(device && other, "host-only devices created");
+    if (!device || !other) {
+        return TEST_RESULT("Configuration");
+    }
+
+    // Configuration cache with TAS and preemption off
+    device->state.priority_map[5] = 6;
+    device->state.vlan_filter[3] = 0x00010001;
+    device->state.cbs[6].traffic_class = 6;
+    device->state.cbs[6].enabled = true;
+    device->state.cbs[6].idle_slope = 12500000;
+    device->state.cbs[6].send_slope = 112500000;
+    device->state.cbs[6].hi_credit = 2000;
+    device->state.cbs[6].lo_credit = 2000;
+    device->state.bandwidth_percent[0] = 40;
+    saved = device->state;
+
+    CHECK(intel_hal_save_config(device, NULL, &size) == INTEL_HAL_SUCCESS && size > 16 && size < sizeof(blob),
+          "size query");
+    CHECK(intel_hal_save_config(device, blob, &size) == INTEL_HAL_SUCCESS, "snapshot saved");
+
+    // A schedule configured after the snapshot must not survive its restore
+    memset(&device->state.vlan_filter, 0, sizeof(device->state.vlan_filter));
+    device->state.priority_map[5] = 0;
+    device->state.tas_enabled = true;
+    device->state.tas.cycle_time = 1000000;
+    device->state.tas.gate_control_list_length = 1;
+    device->state.tas.gate_control_list[0].gate_states = 0xFF;
+    device->state.tas.gate_control_list[0].time_interval = 1000000;
+    intel_hal_tas_index_build(&device->state.tas, &device->tas_index);
+
+    CHECK(intel_hal_restore_config(device, blob, size) == INTEL_HAL_SUCCESS, "snapshot restored");
+    CHECK(device->state.priority_map[5] == 6 && device->state.vlan_filter[3] == 0x00010001 &&
+          memcmp(&device->state.cbs[6], &saved.cbs[6], sizeof(saved.cbs[6])) == 0 &&
+          device->state.bandwidth_percent[0] == 40, "settings round-trip");
+    CHECK(!device->state.tas_enabled && device->state.tas.gate_control_list_length == 0 &&
+          device->tas_index.entry_count == 0, "TAS off in the snapshot disables the running schedule");
+    CHECK(!device->state.fp_enabled, "preemption off");
+
+    // Validation happens before anything is applied
+    blob[size - 1] ^= 0xFF;
+    device->state.priority_map[5] = 2;
+    CHECK(intel_hal_restore_config(device, blob, size) == INTEL_HAL_ERROR_INVALID_PARAM &&
+          device->state.priority_map[5] == 2, "corrupt snapshot rejected without changes");
+    blob[size - 1] ^= 0xFF;
+    CHECK(intel_hal_restore_config(other, blob, size) == INTEL_HAL_ERROR_NOT_SUPPORTED, "other family rejected");
+
+    intel_device_destroy(device);
+    intel_device_destroy(other);
+    return TEST_RESULT("Configuration");
+}
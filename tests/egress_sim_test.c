@@ -0,0 +1,80 @@
+// egress_sim_test.c
+// Tests for the egress pipeline simulator (no hardware required)
+
+#include <string.h>
+#include "test_common.h"
+
+static intel_egress_sim_frame_t frame(uint64_t arrival, uint32_t length, uint8_t tc, uint64_t launch_time) {
+    intel_egress_sim_frame_t f;
+    memset(&f, 0, sizeof(f));
+    f.arrival_ns = arrival;
+    f.packet.packet_length = length;
+    f.packet.queue = tc;
+    f.packet.launch_time = launch_time;
+    return f;
+}
+
+int main(void) {
+    intel_egress_sim_config_t config;
+    intel_egress_sim_frame_t frames[4];
+    intel_egress_sim_result_t results[4];
+    intel_egress_sim_stats_t stats;
+
+    // 1 Gbps: 8 ns per byte, a 1500-byte frame takes (8 + 1500 + 12) * 8 = 12160 ns with its gap
+    intel_hal_egress_sim_config_init(&config, 1000);
+
+    // Strict priority, then launch-time gating
+    frames[0] = frame(0, 1500, 0, 0);
+    frames[1] = frame(0, 1500, 7, 0);
+    frames[2] = frame(0, 64, 5, 50000);
+    CHECK(intel_hal_egress_simulate(&config, frames, 3, results, &stats) == INTEL_HAL_SUCCESS, "simulated");
+    CHECK(results[1].start_ns == 0 && results[1].end_ns == 12064 && results[0].start_ns == 12160,
+          "higher class first");
+    CHECK(results[2].start_ns == 50000 && stats.tc[5].max_launch_delay_ns == 0, "held until launch time");
+    CHECK(stats.tc[0].max_latency_ns == 24224 && stats.tc[7].frames == 1, "per-class latency");
+
+    // TAS: TC7 alone for 10 us, then TC0 for the rest of a 1 ms cycle
+    config.tas_enabled = true;
+    config.tas.cycle_time = 1000000;
+    config.tas.gate_control_list_length = 2;
+    config.tas.gate_control_list[0].gate_states = 0x80;
+    config.tas.gate_control_list[0].time_interval = 10000;
+    config.tas.gate_control_list[1].gate_states = 0x01;
+    config.tas.gate_control_list[1].time_interval = 990000;
+    frames[0] = frame(0, 1500, 0, 0);
+    frames[1] = frame(995000, 1500, 0, 0);
+    frames[2] = frame(995000, 2000, 7, 0);
+    CHECK(intel_hal_egress_simulate(&config, frames, 3, results, &stats) == INTEL_HAL_SUCCESS &&
+          results[0].start_ns == 10000 && results[1].start_ns == 1010000, "frames wait for a window they fit in");
+    CHECK(results[2].dropped && stats.tc[7].dropped == 1, "frame longer than every window dropped");
+    config.tas_enabled = false;
+
+    // Preemption: a 64-byte express frame at 2 us cuts a preemptible 1500-byte frame
+    config.fp_enabled = true;
+    config.fp.preemptible_queues = 0x01;
+    frames[0] = frame(0, 1500, 0, 0);
+    frames[1] = frame(2000, 64, 7, 0);
+    CHECK(intel_hal_egress_simulate(&config, frames, 2, results, &stats) == INTEL_HAL_SUCCESS, "preemption simulated");
+    // Cut after mCRC and gap at 2128 ns; express 84 bytes; remaining 1520 - 250 + 8 bytes
+    CHECK(results[1].start_ns == 2128 && results[1].end_ns == 2704 && results[0].preemptions == 1 &&
+          results[0].end_ns == 2800 + 1278 * 8 - 96, "express frame preempts");
+    config.fp_enabled = false;
+
+    // CBS at 10% of 1 Gbps: the second 1000-byte frame waits for credit to recover
+    config.cbs[6].enabled = true;
+    config.cbs[6].idle_slope = 12500000;
+    config.cbs[6].send_slope = 112500000;
+    config.cbs[6].hi_credit = 2000;
+    config.cbs[6].lo_credit = 2000;
+    frames[0] = frame(0, 1000, 6, 0);
+    frames[1] = frame(0, 1000, 6, 0);
+    CHECK(intel_hal_egress_simulate(&config, frames, 2, results, &stats) == INTEL_HAL_SUCCESS, "CBS simulated");
+    // Credit after 8160 ns: -918 bytes; recovers in 918 / 12.5 MB/s = 73440 ns
+    CHECK(results[1].start_ns >= 8160 + 73440 && results[1].start_ns <= 8160 + 73441, "credit-based shaping");
+
+    frames[1] = frame(0, 1000, 8, 0);
+    CHECK(intel_hal_egress_simulate(&config, frames, 2, results, &stats) == INTEL_HAL_ERROR_INVALID_PARAM,
+          "invalid class rejected");
+
+    return TEST_RESULT("Egress simulation");
+}
@@ -0,0 +1,145 @@
+// gcl_test.c
+// Tests for gate control list validation and fitting (no hardware required)
+
+#include <string.h>
+#include "test_common.h"
+
+int main(void) {
+    intel_tas_config_t config;
+    intel_gcl_t gcl;
+
+    // Intervals must sum to the cycle time
+    intel_gcl_entry_t short_list[] = { {0x01, 400}, {0x02, 500} };
+    gcl.cycle_time = 1000;
+    gcl.base_time = 0;
+    gcl.entry_count = 2;
+    gcl.entries = short_list;
+    CHECK(intel_hal_gcl_validate(&gcl) == INTEL_HAL_ERROR_INVALID_PARAM, "interval sum mismatch rejected");
+
+    // 24 entries with runs of identical states merge to 3
+    intel_gcl_entry_t runs[24];
+    for (int i = 0; i < 24; i++) {
+        runs[i].gate_states = (i < 8) ? 0x80 : (i < 16) ? 0x01 : 0x7E;
+        runs[i].time_interval = 1000;
+    }
+    gcl.cycle_time = 24000;
+    gcl.base_time = 1000000;
+    gcl.entry_count = 24;
+    gcl.entries = runs;
+    CHECK(intel_hal_gcl_fit(&gcl, &config) == INTEL_HAL_SUCCESS && config.gate_control_list_length == 3 &&
+          config.gate_control_list[0].time_interval == 8000 && config.cycle_time == 24000,
+          "adjacent identical entries merged");
+
+    // Last entry continues into the first: merged by moving the base time back
+    intel_gcl_entry_t wrap[] = { {0x01, 300}, {0x02, 400}, {0x01, 300} };
+    gcl.cycle_time = 1000;
+    gcl.base_time = 5000;
+    gcl.entry_count = 3;
+    gcl.entries = wrap;
+    CHECK(intel_hal_gcl_fit(&gcl, &config) == INTEL_HAL_SUCCESS && config.gate_control_list_length == 2 &&
+          config.base_time == 4700 && config.gate_control_list[0].time_interval == 600,
+          "wrap-around entry merged");
+
+    // 40 entries repeating a 4-entry pattern fold onto a tenth of the cycle
+    intel_gcl_entry_t repeat[40];
+    for (int i = 0; i < 40; i++) {
+        repeat[i].gate_states = (uint8_t)(1u << (i % 4));
+        repeat[i].time_interval = 250;
+    }
+    gcl.cycle_time = 10000;
+    gcl.base_time = 0;
+    gcl.entry_count = 40;
+    gcl.entries = repeat;
+    CHECK(intel_hal_gcl_fit(&gcl, &config) == INTEL_HAL_SUCCESS && config.gate_control_list_length == 4 &&
+          config.cycle_time == 1000, "repeating list folded onto sub-cycle");
+
+    // 1,2,4,8,1 repeated three times: the runs of 1 span the repetitions and the cycle boundary
+    intel_gcl_entry_t split[15];
+    for (int i = 0; i < 15; i++) {
+        split[i].gate_states = (uint8_t)(i % 5 == 4 ? 1 : 1u << (i % 5));
+        split[i].time_interval = 100;
+    }
+    gcl.cycle_time = 1500;
+    gcl.base_time = 10000;
+    gcl.entry_count = 15;
+    gcl.entries = split;
+    CHECK(intel_hal_gcl_fit(&gcl, &config) == INTEL_HAL_SUCCESS && config.gate_control_list_length == 4 &&
+          config.cycle_time == 500 && config.base_time == 9900 &&
+          config.gate_control_list[0].gate_states == 0x01 && config.gate_control_list[0].time_interval == 200,
+          "repetition split at the cycle boundary folded");
+
+    // 12 distinct windows cannot fit and report the required count
+    intel_gcl_entry_t distinct[12];
+    for (int i = 0; i < 12; i++) {
+        distinct[i].gate_states = (uint8_t)(i + 1);
+        distinct[i].time_interval = 100 + i;
+    }
+    gcl.cycle_time = 0;
+    for (int i = 0; i < 12; i++) {
+        gcl.cycle_time += distinct[i].time_interval;
+    }
+    gcl.entry_count = 12;
+    gcl.entries = distinct;
+    CHECK(intel_hal_gcl_fit(&gcl, &config) == INTEL_HAL_ERROR_NOT_SUPPORTED &&
+          strstr(intel_hal_get_last_error(), "12 entries") != NULL, "oversized list rejected with entry count");
+
+    // 1 ms cycle at 1 Gbps: TC7 open 0-100 us and 500-600 us, TC0 open the rest
+    intel_tas_analysis_t analysis;
+    uint32_t frame_size[8] = {1500, 1500, 1500, 1500, 1500, 1500, 1500, 125};
+    memset(&config, 0, sizeof(config));
+    config.cycle_time = 1000000;
+    config.gate_control_list_length = 4;
+    config.gate_control_list[0].gate_states = 0x80;
+    config.gate_control_list[0].time_interval = 100000;
+    config.gate_control_list[1].gate_states = 0x01;
+    config.gate_control_list[1].time_interval = 400000;
+    config.gate_control_list[2].gate_states = 0x80;
+    config.gate_control_list[2].time_interval = 100000;
+    config.gate_control_list[3].gate_states = 0x01;
+    config.gate_control_list[3].time_interval = 400000;
+    CHECK(intel_hal_analyze_tas(&config, 1000, frame_size, &analysis) == INTEL_HAL_SUCCESS, "schedule analyzed");
+    // 125 + 20 bytes at 1 Gbps = 1160 ns; latest start 98840 ns, next window at 500000 ns
+    CHECK(analysis.tc[7].frame_time_ns == 1160 && analysis.tc[7].max_closed_interval_ns == 400000 &&
+          analysis.tc[7].worst_case_latency_ns == 500000 - 98840 + 1160, "TC7 worst-case latency");
+    CHECK(analysis.tc[7].guaranteed_bandwidth_bps == 2ULL * (100000 / 1160) * 125 * 8 * 1000, "TC7 bandwidth");
+    CHECK(analysis.tc[3].worst_case_latency_ns == UINT64_MAX && analysis.tc[3].max_closed_interval_ns == 1000000,
+          "closed class reported");
+    // At 300 Mbps the 1160 ns frame takes 3866.67 ns: rounded up, never under-counted
+    CHECK(intel_hal_analyze_tas(&config, 300, frame_size, &analysis) == INTEL_HAL_SUCCESS &&
+          analysis.tc[7].frame_time_ns == 3867, "frame time rounded up");
+
+    // Base time on the 1 ms grid of a reference base at or after a PHC time
+    CHECK(intel_hal_tas_next_base_time(0, 1000000, 5000000) == 5000000 &&
+          intel_hal_tas_next_base_time(250, 1000000, 5000300) == 6000250 &&
+          intel_hal_tas_next_base_time(9000250, 1000000, 5000001) == 5000250, "base time aligned to cycle grid");
+
+    // Starting at 10 ms: TC7 open 100-600 us, TC0 open 0-100 us and 500 us into the next cycle
+    intel_tas_index_t index;
+    intel_tas_gate_info_t info;
+    config.base_time = 10000000;
+    config.gate_control_list[0].gate_states = 0x01;
+    config.gate_control_list[1].gate_states = 0x80;
+    config.gate_control_list[2].gate_states = 0x81;
+    config.gate_control_list[3].gate_states = 0x01;
+    CHECK(intel_hal_tas_index_build(&config, &index) == INTEL_HAL_SUCCESS, "index built");
+    CHECK(intel_hal_tas_index_query(&index, 12550000, 7, &info) == INTEL_HAL_SUCCESS &&
+          info.entry == 2 && info.gate_states == 0x81 && info.cycle_start == 12000000 &&
+          info.cycle_offset == 550000 && info.open && info.window_start == 12100000 &&
+          info.window_end == 12600000, "open window containing the time");
+    CHECK(intel_hal_tas_index_query(&index, 12700000, 7, &info) == INTEL_HAL_SUCCESS && !info.open &&
+          info.entry == 3 && info.window_start == 13100000 && info.window_end == 13600000,
+          "next window in the following cycle");
+    CHECK(intel_hal_tas_index_query(&index, 12900000, 0, &info) == INTEL_HAL_SUCCESS && info.open &&
+          info.window_start == 12500000 && info.window_end == 13100000, "window across the cycle boundary");
+    CHECK(intel_hal_tas_index_query(&index, 12900000, 3, &info) == INTEL_HAL_SUCCESS && !info.open &&
+          info.window_end == 0, "closed class has no window");
+    CHECK(intel_hal_tas_index_query(&index, 0, 0, &info) == INTEL_HAL_SUCCESS && info.cycle_start == 10000000 &&
+          info.open && info.window_start == 10000000 && info.window_end == 10100000,
+          "time before base answered for base time");
+    config.base_time = 0;
+    CHECK(intel_hal_tas_index_build(&config, &index) == INTEL_HAL_SUCCESS &&
+          intel_hal_tas_index_query(&index, 50000, 0, &info) == INTEL_HAL_SUCCESS && info.open &&
+          info.window_start == 0 && info.window_end == 100000, "wrapped window clamped to a base time of 0");
+
+    return TEST_RESULT("GCL");
+}
@@ -0,0 +1,45 @@
+// host_device.h
+// Host-only device fixture for the scheduler-driven tests: an I210 instance whose PHC is
+// the system clock (no hardware required), torn down in device close order
+
+#ifndef INTEL_HAL_TEST_HOST_DEVICE_H
+#define INTEL_HAL_TEST_HOST_DEVICE_H
+
+#include <time.h>
+#include "intel_hal_private.h"
+
+static inline intel_hal_result_t host_clock(intel_device_t *device, intel_timestamp_t *timestamp) {
+    struct timespec ts;
+    (void)device;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    timestamp->seconds = (uint64_t)ts.tv_sec;
+    timestamp->nanoseconds = (uint32_t)ts.tv_nsec;
+    return INTEL_HAL_SUCCESS;
+}
+
+static inline uint64_t host_now_ns(void) {
+    intel_timestamp_t ts;
+    host_clock(NULL, &ts);
+    return ts.seconds * 1000000000ULL + ts.nanoseconds;
+}
+
+// Returns NULL if the device cannot be created
+static inline intel_device_t *host_device_create(void) {
+    intel_device_t *device = intel_device_create(INTEL_DEVICE_I210_1533);
+    if (device) {
+        device->host_clock = host_clock;
+    }
+    return device;
+}
+
+// Stops the scheduler first, then releases the modules it drove, as intel_hal_close() does
+static inline void host_device_destroy(intel_device_t *device) {
+    intel_scheduler_destroy(device->scheduler);
+    intel_config_queue_destroy(device->config_queue);
+    intel_soft_tas_destroy(device->soft_tas);
+    intel_launch_destroy(device->launch);
+    intel_packet_pools_destroy(device);
+    intel_device_destroy(device);
+}
+
+#endif // INTEL_HAL_TEST_HOST_DEVICE_H
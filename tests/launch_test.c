@@ -0,0 +1,58 @@
+// launch_test.c
+// Tests for the launch-time transmit scheduler on a host-only device whose PHC is the
+// system clock (no hardware required): release order, overdue packets and counters
+
+#include <string.h>
+#include <time.h>
+#include "test_common.h"
+#include "host_device.h"
+
+int main(void) {
+    intel_device_t *device = host_device_create();
+    intel_hal_launch_config_t config;
+    intel_hal_launch_stats_t stats;
+    intel_timed_packet_t packet;
+    uint8_t frame[64];
+    struct timespec wait = { 0, 20000000 };
+    uint64_t start;
+
+    CHECK(device != NULL, "host-only device created");
+    if (!device) {
+        return TEST_RESULT("Launch");
+    }
+
+    intel_hal_launch_config_init(&config);
+    config.lead_ns = 2000000;
+    config.max_packets = 2;
+    CHECK(intel_hal_launch_scheduler_start(device, &config) == INTEL_HAL_SUCCESS, "launch scheduler started");
+
+    memset(frame, 0x5A, sizeof(frame));
+    memset(&packet, 0, sizeof(packet));
+    packet.packet_data = frame;
+    packet.packet_length = sizeof(frame);
+
+    // Submitted out of order, due well after their release lead
+    start = host_now_ns();
+    packet.launch_time = start + 6000000;
+    CHECK(intel_hal_launch_submit(device, &packet) == INTEL_HAL_SUCCESS, "later packet held");
+    packet.launch_time = start + 5000000;
+    CHECK(intel_hal_launch_submit(device, &packet) == INTEL_HAL_SUCCESS, "earlier packet held");
+    CHECK(intel_hal_launch_submit(device, &packet) == INTEL_HAL_ERROR_NO_MEMORY, "full scheduler rejects");
+
+    nanosleep(&wait, NULL);
+    intel_hal_launch_get_stats(device, &stats);
+    CHECK(stats.submitted == 2 && stats.released == 2 && stats.pending == 0 && stats.rejected == 1,
+          "held packets released");
+    CHECK(stats.late == 0 && stats.clamped == 0, "released ahead of their launch times");
+
+    // Already due at submission: released at once and counted late
+    packet.launch_time = host_now_ns() - 1000000;
+    packet.queue = 1;
+    CHECK(intel_hal_launch_submit(device, &packet) == INTEL_HAL_SUCCESS, "overdue packet accepted");
+    nanosleep(&wait, NULL);
+    intel_hal_launch_get_stats(device, &stats);
+    CHECK(stats.released == 3 && stats.late == 1, "overdue packet counted late");
+
+    host_device_destroy(device);
+    return TEST_RESULT("Launch");
+}
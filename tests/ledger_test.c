@@ -0,0 +1,51 @@
+// ledger_test.c
+// Tests for the port bandwidth ledger on a host-only gigabit device (no hardware required)
+
+#include "test_common.h"
+#include "intel_hal_private.h"
+
+int main(void) {
+    intel_device_t *device = intel_device_create(INTEL_DEVICE_I210_1533);
+    uint64_t headroom = 0;
+    uint64_t committed = 0;
+
+    CHECK(device != NULL, "host-only device created");
+    if (!device) {
+        return TEST_RESULT("Ledger");
+    }
+
+    // Admission against the 1 Gbps default capacity
+    CHECK(intel_hal_bandwidth_reserve(device, 6, 600000000ULL) == INTEL_HAL_SUCCESS &&
+          intel_hal_bandwidth_get_headroom(device, &headroom) == INTEL_HAL_SUCCESS && headroom == 400000000ULL,
+          "reservation admitted");
+    CHECK(intel_hal_bandwidth_reserve(device, 5, 500000000ULL) == INTEL_HAL_ERROR_NO_BANDWIDTH,
+          "oversubscription rejected");
+    CHECK(intel_hal_bandwidth_reserve(device, 5, UINT64_MAX) == INTEL_HAL_ERROR_NO_BANDWIDTH &&
+          intel_hal_bandwidth_get_committed(device, 5, &committed) == INTEL_HAL_SUCCESS && committed == 0,
+          "reservation beyond the link rejected without wrapping");
+
+    // A class counts with its largest claim
+    CHECK(intel_ledger_claim(device, 6, INTEL_LEDGER_CBS, 500000000ULL) == INTEL_HAL_SUCCESS &&
+          intel_hal_bandwidth_get_headroom(device, &headroom) == INTEL_HAL_SUCCESS && headroom == 400000000ULL,
+          "CBS claim inside the reservation not counted twice");
+    CHECK(intel_ledger_claim(device, 0, INTEL_LEDGER_RATE_LIMIT, UINT64_MAX) == INTEL_HAL_ERROR_NO_BANDWIDTH,
+          "claim beyond the link rejected");
+
+    // Sums that would wrap are rejected even at the largest capacity
+    CHECK(intel_hal_bandwidth_set_capacity(device, UINT64_MAX) == INTEL_HAL_SUCCESS, "capacity raised");
+    CHECK(intel_ledger_claim(device, 0, INTEL_LEDGER_RATE_LIMIT, UINT64_MAX - 1) == INTEL_HAL_ERROR_NO_BANDWIDTH &&
+          intel_hal_bandwidth_get_committed(device, 0, &committed) == INTEL_HAL_SUCCESS && committed == 0,
+          "wrapping claim rejected");
+    CHECK(intel_hal_bandwidth_reserve(device, 6, UINT64_MAX - 1) == INTEL_HAL_ERROR_NO_BANDWIDTH &&
+          intel_hal_bandwidth_get_committed(device, 6, &committed) == INTEL_HAL_SUCCESS && committed == 600000000ULL,
+          "wrapping reservation rejected");
+
+    CHECK(intel_hal_bandwidth_set_capacity(device, 100000000ULL) == INTEL_HAL_ERROR_DEVICE_BUSY,
+          "capacity below the committed bandwidth refused");
+    CHECK(intel_hal_bandwidth_release(device, 6, 600000000ULL) == INTEL_HAL_SUCCESS &&
+          intel_hal_bandwidth_get_committed(device, 6, &committed) == INTEL_HAL_SUCCESS && committed == 500000000ULL,
+          "release falls back to the remaining claim");
+
+    intel_device_destroy(device);
+    return TEST_RESULT("Ledger");
+}
@@ -0,0 +1,57 @@
+// mcr_test.c
+// Tests for media clock recovery (no hardware required)
+
+#include <stdlib.h>
+#include <math.h>
+#include "test_common.h"
+
+int main(void) {
+    intel_mcr_config_t config;
+    intel_mcr_t mcr;
+    intel_mcr_state_t state;
+    uint64_t timestamps[6];
+    uint64_t base = 1000000000000ULL;
+    // Talker media clock 48 kHz + 50 ppm, CRF with 160 events per timestamp, 6 per PDU
+    double period = 1e9 / (48000.0 * (1.0 + 50e-6));
+    uint64_t event = 0;
+
+    intel_hal_mcr_config_init(&config);
+    CHECK(intel_hal_mcr_init(&mcr, &config) == INTEL_HAL_SUCCESS, "recovery initialized");
+
+    srand(1);
+    for (int pdu = 0; pdu < 2000; pdu++) {
+        for (int i = 0; i < 6; i++) {
+            // +/- 200 ns timestamp jitter
+            timestamps[i] = base + (uint64_t)llround(event * period) + (uint64_t)(rand() % 401) - 200;
+            event += 160;
+        }
+        if (pdu == 700) {
+            continue;           // Lost PDU
+        }
+        intel_hal_mcr_feed_crf(&mcr, timestamps, 6, 160, timestamps[0] - 1000000);
+    }
+
+    intel_hal_mcr_get_state(&mcr, &state);
+    CHECK(state.state == INTEL_MCR_LOCKED, "locked");
+    CHECK(fabs(state.rate_ratio - (1.0 + 50e-6)) < 1e-6, "rate ratio within 1 ppm");
+    CHECK(state.resets == 0, "lost PDU bridged without restart");
+    CHECK(llabs((long long)(intel_hal_mcr_event_time(&mcr, 160) - (base + (uint64_t)llround(event * period)))) < 500,
+          "next event predicted");
+
+    // AVTP presentation times: 32-bit timestamps unwrapped around the receive time
+    intel_hal_mcr_init(&mcr, &config);
+    for (int frame = 0; frame < 4000; frame++) {
+        uint64_t presentation = base + (uint64_t)llround(frame * 6 * period);
+        intel_hal_mcr_feed_avtp(&mcr, (uint32_t)presentation, presentation - 2000000, 6);
+    }
+    intel_hal_mcr_get_state(&mcr, &state);
+    CHECK(state.state == INTEL_MCR_LOCKED && fabs(state.rate_ratio - (1.0 + 50e-6)) < 1e-6 &&
+          state.late == 0, "AVTP presentation times tracked");
+
+    // A 10 ms phase jump restarts acquisition
+    intel_hal_mcr_feed_avtp(&mcr, (uint32_t)(base + 10000000000ULL), base + 10000000000ULL - 2000000, 6);
+    intel_hal_mcr_get_state(&mcr, &state);
+    CHECK(state.resets == 1 && state.state == INTEL_MCR_ACQUIRING, "phase jump restarts acquisition");
+
+    return TEST_RESULT("MCR");
+}
@@ -0,0 +1,134 @@
+// packet_pool_test.c
+// Tests for packet buffer pools on a host-only device whose PHC is the system clock
+// (no hardware required): concurrent alloc/free, stealing from other thread caches
+// and a launch scheduler round trip
+
+#include <string.h>
+#include <time.h>
+#include "test_common.h"
+#include "host_device.h"
+
+#define STRESS_THREADS      8
+#define STRESS_ROUNDS       20000
+#define STRESS_BURST        8
+
+typedef struct {
+    intel_hal_packet_pool_t *pool;
+    uint32_t id;
+    uint32_t count;                     /* Buffers obtained */
+    uint32_t errors;                    /* Buffers another thread wrote to while owned */
+} worker_t;
+
+static uint32_t free_buffers(intel_hal_packet_pool_t *pool) {
+    intel_hal_packet_pool_info_t info;
+    return intel_hal_packet_pool_get_info(pool, &info) == INTEL_HAL_SUCCESS ? info.free_buffers : 0;
+}
+
+// Allocates bursts, marks each buffer as owned and checks the mark before freeing
+static void stress(void *arg) {
+    worker_t *worker = (worker_t *)arg;
+    uint32_t *held[STRESS_BURST];
+    uint32_t round, i, n;
+
+    for (round = 0; round < STRESS_ROUNDS; round++) {
+        for (n = 0; n < 1 + round % STRESS_BURST; n++) {
+            held[n] = (uint32_t *)intel_hal_packet_alloc(worker->pool);
+            if (!held[n]) {
+                break;
+            }
+            *held[n] = worker->id;
+            worker->count++;
+        }
+        for (i = n; i-- > 0;) {
+            worker->errors += *held[i] != worker->id;
+            intel_hal_packet_free(worker->pool, held[i]);
+        }
+    }
+}
+
+// Takes every buffer of the pool, then returns them
+static void drain(void *arg) {
+    worker_t *worker = (worker_t *)arg;
+    void *held[64];
+    uint32_t i;
+
+    while (worker->count < 64 && (held[worker->count] = intel_hal_packet_alloc(worker->pool)) != NULL) {
+        worker->count++;
+    }
+    for (i = 0; i < worker->count; i++) {
+        intel_hal_packet_free(worker->pool, held[i]);
+    }
+}
+
+int main(void) {
+    intel_device_t *device = host_device_create();
+    intel_hal_packet_pool_t *pool;
+    intel_hal_thread_t *threads[STRESS_THREADS];
+    worker_t workers[STRESS_THREADS];
+    intel_hal_thread_attr_t attr;
+    intel_hal_launch_config_t config;
+    intel_hal_launch_stats_t stats;
+    intel_timed_packet_t packet;
+    void *held[48];
+    struct timespec wait = { 0, 20000000 };
+    uint32_t errors = 0;
+    int created = 1;
+    uint32_t i;
+
+    CHECK(device != NULL, "host-only device created");
+    if (!device) {
+        return TEST_RESULT("Packet pool");
+    }
+    intel_hal_thread_attr_init(&attr);
+    attr.numa_node = INTEL_HAL_NUMA_NODE_ANY;
+
+    // Concurrent bursts through the thread caches and the shared stack
+    CHECK(intel_hal_packet_pool_create(device, 256, 256, &pool) == INTEL_HAL_SUCCESS &&
+          free_buffers(pool) == 256, "pool created");
+    for (i = 0; i < STRESS_THREADS; i++) {
+        workers[i] = (worker_t){ pool, i + 1, 0, 0 };
+        created &= intel_hal_thread_create(NULL, &attr, stress, &workers[i], &threads[i]) == INTEL_HAL_SUCCESS;
+    }
+    CHECK(created, "stress threads started");
+    for (i = 0; i < STRESS_THREADS && created; i++) {
+        intel_hal_thread_join(threads[i]);
+        errors += workers[i].errors;
+    }
+    CHECK(errors == 0, "no buffer handed to two owners");
+    CHECK(free_buffers(pool) == 256, "every buffer returned");
+    CHECK(intel_hal_packet_pool_destroy(pool) == INTEL_HAL_SUCCESS, "pool destroyed");
+
+    // Buffers cached by this thread are stolen by another once the shared stack is empty
+    CHECK(intel_hal_packet_pool_create(device, 48, 64, &pool) == INTEL_HAL_SUCCESS, "small pool created");
+    for (i = 0; i < 48; i++) {
+        held[i] = intel_hal_packet_alloc(pool);
+    }
+    CHECK(held[47] != NULL && intel_hal_packet_alloc(pool) == NULL, "pool exhausted");
+    for (i = 0; i < 48; i++) {
+        intel_hal_packet_free(pool, held[i]);
+    }
+    workers[0] = (worker_t){ pool, 1, 0, 0 };
+    CHECK(intel_hal_thread_create(NULL, &attr, drain, &workers[0], &threads[0]) == INTEL_HAL_SUCCESS &&
+          intel_hal_thread_join(threads[0]) == INTEL_HAL_SUCCESS && workers[0].count == 48,
+          "other thread takes every cached buffer");
+    CHECK(free_buffers(pool) == 48, "stolen buffers returned");
+
+    // A submitted buffer is owned by the launch scheduler until transmitted
+    intel_hal_launch_config_init(&config);
+    config.lead_ns = 2000000;
+    CHECK(intel_hal_launch_scheduler_start(device, &config) == INTEL_HAL_SUCCESS, "launch scheduler started");
+    memset(&packet, 0, sizeof(packet));
+    packet.packet_data = intel_hal_packet_alloc(pool);
+    packet.packet_length = 64;
+    packet.launch_time = host_now_ns() + 5000000;
+    CHECK(packet.packet_data && intel_hal_launch_submit(device, &packet) == INTEL_HAL_SUCCESS,
+          "pool buffer submitted");
+    CHECK(intel_hal_packet_pool_destroy(pool) == INTEL_HAL_ERROR_DEVICE_BUSY, "destroy refused while queued");
+    nanosleep(&wait, NULL);
+    intel_hal_launch_get_stats(device, &stats);
+    CHECK(stats.released == 1 && free_buffers(pool) == 48, "buffer returned after transmission");
+    CHECK(intel_hal_packet_pool_destroy(pool) == INTEL_HAL_SUCCESS, "destroyed once transmitted");
+
+    host_device_destroy(device);
+    return TEST_RESULT("Packet pool");
+}
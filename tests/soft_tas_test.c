@@ -0,0 +1,74 @@
+// soft_tas_test.c
+// Tests for the software Time-Aware Shaper: gate open times per entry and class, and
+// frame release on a host-only device whose PHC is the system clock (no hardware required)
+
+#include <string.h>
+#include <time.h>
+#include "test_common.h"
+#include "host_device.h"
+
+int main(void) {
+    intel_tas_config_t config;
+    uint64_t open_ns[INTEL_HAL_TAS_MAX_ENTRIES][8];
+    intel_device_t *device;
+    intel_soft_tas_stats_t stats;
+    uint8_t frame[64];
+    struct timespec wait = { 0, 10000000 };
+
+    // TC0 open in entries 0-1, TC7 in entries 2 and 0 (across the cycle end), TC1 never, TC2 always
+    memset(&config, 0, sizeof(config));
+    config.cycle_time = 1000;
+    config.gate_control_list_length = 3;
+    config.gate_control_list[0].gate_states = 0x85;
+    config.gate_control_list[0].time_interval = 300;
+    config.gate_control_list[1].gate_states = 0x05;
+    config.gate_control_list[1].time_interval = 200;
+    config.gate_control_list[2].gate_states = 0x84;
+    config.gate_control_list[2].time_interval = 500;
+    intel_soft_tas_open_times(&config, open_ns);
+    CHECK(open_ns[0][0] == 500 && open_ns[1][0] == 200 && open_ns[2][0] == 0, "open run to the gate close");
+    CHECK(open_ns[2][7] == 800 && open_ns[0][7] == 300 && open_ns[1][7] == 0, "open run across the cycle end");
+    CHECK(open_ns[0][1] == 0 && open_ns[1][1] == 0 && open_ns[2][1] == 0, "never open");
+    CHECK(open_ns[0][2] == 1000 && open_ns[1][2] == 1000 && open_ns[2][2] == 1000, "always open capped at the cycle");
+
+    // All gates open: queued frames go out on the next entry start
+    device = host_device_create();
+    CHECK(device != NULL, "host-only device created");
+    if (!device) {
+        return TEST_RESULT("Software TAS");
+    }
+
+    memset(&config, 0, sizeof(config));
+    config.cycle_time = 1000000;
+    config.gate_control_list_length = 1;
+    config.gate_control_list[0].gate_states = 0xFF;
+    config.gate_control_list[0].time_interval = 1000000;
+    CHECK(intel_soft_tas_configure(device, &config) == INTEL_HAL_SUCCESS, "schedule configured");
+
+    memset(frame, 0xA5, sizeof(frame));
+    CHECK(intel_hal_soft_tas_enqueue(device, 0, frame, sizeof(frame)) == INTEL_HAL_SUCCESS &&
+          intel_hal_soft_tas_enqueue(device, 5, frame, sizeof(frame)) == INTEL_HAL_SUCCESS, "frames queued");
+    nanosleep(&wait, NULL);
+    intel_hal_soft_tas_get_stats(device, &stats);
+    CHECK(stats.sent[0] == 1 && stats.sent[5] == 1 && stats.queued[0] == 0, "frames released");
+
+    // Replacing the schedule keeps releasing from the new one
+    config.gate_control_list[0].gate_states = 0x01;
+    CHECK(intel_soft_tas_configure(device, &config) == INTEL_HAL_SUCCESS, "schedule replaced");
+    intel_hal_soft_tas_enqueue(device, 0, frame, sizeof(frame));
+    intel_hal_soft_tas_enqueue(device, 5, frame, sizeof(frame));
+    nanosleep(&wait, NULL);
+    intel_hal_soft_tas_get_stats(device, &stats);
+    CHECK(stats.sent[0] == 2 && stats.sent[5] == 1 && stats.queued[5] == 1, "closed class held");
+
+    // Disabling drops the held frames and refuses new ones
+    config.gate_control_list_length = 0;
+    CHECK(intel_soft_tas_configure(device, &config) == INTEL_HAL_SUCCESS, "schedule disabled");
+    intel_hal_soft_tas_get_stats(device, &stats);
+    CHECK(stats.queued[5] == 0 && stats.dropped[5] == 1, "held frames dropped");
+    CHECK(intel_hal_soft_tas_enqueue(device, 0, frame, sizeof(frame)) == INTEL_HAL_ERROR_NOT_SUPPORTED,
+          "enqueue refused while disabled");
+
+    host_device_destroy(device);
+    return TEST_RESULT("Software TAS");
+}
@@ -0,0 +1,122 @@
+// tas_update_test.c
+// Tests for staged TAS schedule updates on a host-only device whose PHC is the system clock
+// (no hardware required): AdminBaseTime selection, changed entries and the software
+// two-bank switch at the admin base time
+
+#include <string.h>
+#include <time.h>
+#include "test_common.h"
+#include "host_device.h"
+
+#define MS                  1000000ULL
+#define FRAME_BYTES         1500
+
+static void set_entry(intel_tas_config_t *config, uint32_t index, uint8_t gates, uint32_t interval) {
+    config->gate_control_list[index].gate_states = gates;
+    config->gate_control_list[index].time_interval = interval;
+    if (config->gate_control_list_length <= index) {
+        config->gate_control_list_length = index + 1;
+    }
+}
+
+static void sleep_until(uint64_t phc_time) {
+    uint64_t now = host_now_ns();
+    struct timespec wait;
+
+    if (phc_time > now) {
+        wait.tv_sec = (time_t)((phc_time - now) / 1000000000ULL);
+        wait.tv_nsec = (long)((phc_time - now) % 1000000000ULL);
+        nanosleep(&wait, NULL);
+    }
+}
+
+int main(void) {
+    intel_device_t *device = host_device_create();
+    intel_tas_config_t oper, admin;
+    intel_tas_update_t update;
+    intel_soft_tas_stats_t stats;
+    uint8_t frame[FRAME_BYTES];
+    uint64_t before, after, not_before, base, wire;
+    bool pending;
+    uint32_t i;
+
+    CHECK(device != NULL, "host-only device created");
+    if (!device) {
+        return TEST_RESULT("TAS update");
+    }
+
+    // Operating schedule on a 1 ms grid offset by 250 us
+    memset(&oper, 0, sizeof(oper));
+    oper.cycle_time = 1 * MS;
+    oper.base_time = 250000;
+    set_entry(&oper, 0, 0x01, 500000);
+    set_entry(&oper, 1, 0x02, 500000);
+    CHECK(intel_hal_setup_time_aware_shaper(device, &oper) == INTEL_HAL_SUCCESS, "operating schedule configured");
+
+    // The operating schedule again is not staged
+    admin = oper;
+    admin.base_time = 0;
+    CHECK(intel_hal_tas_stage_update(device, &admin, 0, &update) == INTEL_HAL_SUCCESS &&
+          update.admin_base_time == 0 && update.changed_entries == 0, "identical schedule not staged");
+    CHECK(intel_hal_tas_get_update_status(device, &pending, &base) == INTEL_HAL_SUCCESS && !pending,
+          "nothing pending");
+
+    // Entry 1 shortened and entry 2 added: AdminBaseTime is the next operating cycle boundary
+    set_entry(&admin, 1, 0x04, 250000);
+    set_entry(&admin, 2, 0x02, 250000);
+    before = host_now_ns();
+    CHECK(intel_hal_tas_stage_update(device, &admin, 0, &update) == INTEL_HAL_SUCCESS, "update staged");
+    after = host_now_ns();
+    CHECK(update.changed_entries == 0x6 && !update.hardware, "changed entries reported");
+    CHECK(update.admin_base_time % oper.cycle_time == oper.base_time &&
+          update.admin_base_time >= before + INTEL_HAL_TAS_UPDATE_MIN_LEAD_NS &&
+          update.admin_base_time < after + INTEL_HAL_TAS_UPDATE_MIN_LEAD_NS + oper.cycle_time,
+          "AdminBaseTime on the next operating cycle boundary");
+    CHECK(intel_hal_tas_get_update_status(device, &pending, &base) == INTEL_HAL_SUCCESS &&
+          pending && base == update.admin_base_time, "update pending");
+
+    // Restaging with a later not_before moves the switch to the first boundary after it
+    not_before = host_now_ns() + 50 * MS;
+    CHECK(intel_hal_tas_stage_update(device, &admin, not_before, &update) == INTEL_HAL_SUCCESS &&
+          update.admin_base_time % oper.cycle_time == oper.base_time &&
+          update.admin_base_time >= not_before && update.admin_base_time < not_before + oper.cycle_time,
+          "AdminBaseTime not before the requested time");
+
+    // Once due, the admin schedule is the operating one
+    sleep_until(update.admin_base_time + 5 * MS);
+    CHECK(intel_hal_tas_get_update_status(device, &pending, &base) == INTEL_HAL_SUCCESS && !pending,
+          "update applied at its base time");
+    admin.base_time = 0;
+    CHECK(intel_hal_tas_stage_update(device, &admin, 0, &update) == INTEL_HAL_SUCCESS &&
+          update.admin_base_time == 0 && update.changed_entries == 0, "applied schedule now operating");
+
+    // TC0 always open until an explicit admin base time 4.5 frames into a cycle, then only TC1
+    wire = intel_wire_time_ns(FRAME_BYTES, 1000);
+    memset(&oper, 0, sizeof(oper));
+    oper.cycle_time = 10 * MS;
+    oper.base_time = intel_hal_tas_next_base_time(0, oper.cycle_time, host_now_ns() + 20 * MS);
+    set_entry(&oper, 0, 0x01, 10 * MS);
+    CHECK(intel_hal_setup_time_aware_shaper(device, &oper) == INTEL_HAL_SUCCESS, "schedule replaced");
+    admin = oper;
+    admin.base_time = oper.base_time + 4 * wire + wire / 2;
+    admin.gate_control_list[0].gate_states = 0x02;
+    CHECK(intel_hal_tas_stage_update(device, &admin, 0, &update) == INTEL_HAL_SUCCESS &&
+          update.admin_base_time == admin.base_time && update.changed_entries == 0x1,
+          "explicit future base time kept");
+
+    memset(frame, 0xA5, sizeof(frame));
+    for (i = 0; i < 20; i++) {
+        intel_hal_soft_tas_enqueue(device, 0, frame, sizeof(frame));
+    }
+    CHECK(intel_hal_soft_tas_enqueue(device, 1, frame, sizeof(frame)) == INTEL_HAL_SUCCESS,
+          "frames queued before the switch");
+    sleep_until(admin.base_time + 5 * MS);
+    intel_hal_soft_tas_get_stats(device, &stats);
+    CHECK(stats.sent[0] == 4 && stats.queued[0] == 16, "operating window ends at the admin base time");
+    CHECK(stats.sent[1] == 1, "admin schedule releases from its base time");
+    CHECK(intel_hal_tas_get_update_status(device, &pending, &base) == INTEL_HAL_SUCCESS && !pending,
+          "software switch applied");
+
+    host_device_destroy(device);
+    return TEST_RESULT("TAS update");
+}
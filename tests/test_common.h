@@ -0,0 +1,21 @@
+// test_common.h
+// Shared check and summary helpers for the host-only unit tests
+
+#ifndef INTEL_HAL_TEST_COMMON_H
+#define INTEL_HAL_TEST_COMMON_H
+
+#include <stdio.h>
+#include "intel_ethernet_hal.h"
+
+static int failures = 0;
+
+#define CHECK(cond, msg) do { \
+    if (cond) { printf("[OK]   %s\n", msg); } \
+    else { printf("[FAIL] %s (%s)\n", msg, intel_hal_get_last_error()); failures++; } \
+} while (0)
+
+// Prints the summary line and evaluates to the exit status of main()
+#define TEST_RESULT(name) \
+    (printf("%s tests %s\n", name, failures ? "FAILED" : "passed"), failures ? 1 : 0)
+
+#endif // INTEL_HAL_TEST_COMMON_H
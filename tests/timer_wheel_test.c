@@ -0,0 +1,98 @@
+// timer_wheel_test.c
+// Tests for the hierarchical timing wheel (no hardware required)
+
+#include "test_common.h"
+#include "intel_hal_private.h"
+
+static intel_timer_wheel_t wheel;
+
+// Advances to now_ns and returns the number of nodes expired, setting *hit if 'node' was one
+static uint32_t advance_hit(uint64_t now_ns, const intel_timer_node_t *node, int *hit) {
+    intel_timer_node_t expired;
+    intel_timer_node_t *n;
+    uint32_t count;
+    expired.next = expired.prev = &expired;
+    count = intel_timer_wheel_advance(&wheel, now_ns, &expired);
+    for (n = expired.next; n != &expired; n = n->next) {
+        *hit |= n == node;
+    }
+    return count;
+}
+
+static uint32_t advance(uint64_t now_ns) {
+    int hit = 0;
+    return advance_hit(now_ns, NULL, &hit);
+}
+
+// Follows next_expiry until 'node' expires; returns the advance time that expired it
+static uint64_t run_until_expired(const intel_timer_node_t *node, uint32_t *steps) {
+    uint64_t next = 0;
+    int hit = 0;
+    *steps = 0;
+    while (!hit && intel_timer_wheel_next_expiry(&wheel, &next) && *steps < 64) {
+        advance_hit(next, node, &hit);
+        (*steps)++;
+    }
+    return hit ? next : 0;
+}
+
+int main(void) {
+    intel_timer_node_t a, b, c;
+    uint64_t next = 0;
+    uint32_t steps;
+
+    // Level-1 slot due to cascade exactly when level 0 wraps
+    intel_timer_wheel_init(&wheel, 0x1F0, 0);
+    a.expires = 0x2F5;
+    intel_timer_wheel_add(&wheel, &a);
+    CHECK(intel_timer_wheel_next_expiry(&wheel, &next) && next == 0x200, "cascade reported at the next level-0 wrap");
+    CHECK(advance(0x1FF) == 0 && intel_timer_wheel_next_expiry(&wheel, &next) && next == 0x200,
+          "cascade still due after advancing up to the wrap");
+    CHECK(advance(0x200) == 0 && intel_timer_wheel_next_expiry(&wheel, &next) && next == 0x2F5,
+          "exact expiry after the cascade");
+    CHECK(advance(0x2F4) == 0 && advance(0x2F5) == 1 && wheel.count == 0, "expires on its tick");
+
+    // Level-1 and level-2 nodes cascading through the 0x10000 and 0x20000 boundaries
+    intel_timer_wheel_init(&wheel, 0xFFF0, 0);
+    a.expires = 0x10105;
+    b.expires = 0x20003;
+    intel_timer_wheel_add(&wheel, &a);
+    intel_timer_wheel_add(&wheel, &b);
+    CHECK(run_until_expired(&a, &steps) == 0x10105 && steps <= 3, "level-1 node expires on time");
+    CHECK(run_until_expired(&b, &steps) == 0x20003 && steps <= 4 && wheel.count == 0, "level-2 node expires on time");
+
+    // A node already due when added expires on the next advance, not a tick later
+    intel_timer_wheel_init(&wheel, 1000, 4);
+    advance(5000);
+    a.expires = 5000;
+    b.expires = 100;
+    intel_timer_wheel_add(&wheel, &a);
+    intel_timer_wheel_add(&wheel, &b);
+    CHECK(intel_timer_wheel_next_expiry(&wheel, &next) && next <= 5000, "overdue node reported as due");
+    CHECK(advance(5000) == 2 && wheel.count == 0, "overdue nodes expire without time advancing");
+
+    // Beyond the 2^32-tick span: parked at the top level and re-placed on cascade
+    intel_timer_wheel_init(&wheel, 0, 0);
+    a.expires = (1ULL << 33) + 12345;
+    b.expires = 1000;
+    intel_timer_wheel_add(&wheel, &a);
+    intel_timer_wheel_add(&wheel, &b);
+    CHECK(intel_timer_wheel_next_expiry(&wheel, &next) && next <= 1000, "near node reported first");
+    CHECK(run_until_expired(&b, &steps) == 1000 && wheel.count == 1, "near node expires on time");
+    CHECK(run_until_expired(&a, &steps) == (1ULL << 33) + 12345 && steps <= 16, "far-future node expires on time");
+
+    // Cancel leaves no expiry behind
+    intel_timer_wheel_init(&wheel, 0, 0);
+    a.expires = 300;
+    b.expires = 70000;
+    c.expires = 70001;
+    intel_timer_wheel_add(&wheel, &a);
+    intel_timer_wheel_add(&wheel, &b);
+    intel_timer_wheel_add(&wheel, &c);
+    intel_timer_wheel_remove(&wheel, &b);
+    CHECK(advance(300) == 1 && wheel.count == 1, "cancelled node not expired");
+    CHECK(run_until_expired(&c, &steps) == 70001 && wheel.count == 0, "remaining node expires on time");
+    CHECK(!intel_timer_wheel_next_expiry(&wheel, &next), "empty wheel has no expiry");
+
+    return TEST_RESULT("Timer wheel");
+}
@@ -0,0 +1,64 @@
+// tsn_synth_test.c
+// Tests for TSN schedule synthesis (no hardware required)
+
+#include <string.h>
+#include "test_common.h"
+
+int main(void) {
+    intel_tsn_synth_config_t config;
+    intel_tsn_stream_t streams[64];
+    intel_tsn_stream_slot_t slots[64];
+    intel_tas_config_t tas;
+
+    memset(&config, 0, sizeof(config));
+    config.link_speed_mbps = 1000;
+    config.base_time = 1000000000ULL;
+    config.best_effort_gates = 0x01;
+    config.guard_frame_size = 1522;
+
+    // Two 1 ms streams with a 100 us deadline on TC7, one 2 ms stream on TC6
+    memset(streams, 0, sizeof(streams));
+    streams[0] = (intel_tsn_stream_t){1000000, 105, 7, 100000};
+    streams[1] = (intel_tsn_stream_t){1000000, 105, 7, 100000};
+    streams[2] = (intel_tsn_stream_t){2000000, 230, 6, 0};
+    CHECK(intel_hal_tsn_synthesize(&config, streams, 3, slots, &tas) == INTEL_HAL_SUCCESS, "three streams scheduled");
+    // 125 bytes at 1 Gbps = 1000 ns, 250 bytes = 2000 ns, 1542-byte guard = 12336 ns
+    CHECK(tas.cycle_time == 1000000 && tas.base_time == 1000000000ULL && tas.gate_control_list_length == 4 &&
+          tas.gate_control_list[0].gate_states == 0x80 && tas.gate_control_list[0].time_interval == 2000 &&
+          tas.gate_control_list[1].gate_states == 0x40 && tas.gate_control_list[1].time_interval == 2000 &&
+          tas.gate_control_list[2].gate_states == 0x01 && tas.gate_control_list[3].gate_states == 0 &&
+          tas.gate_control_list[3].time_interval == 12336, "class windows, best effort and guard band");
+    CHECK(slots[0].launch_offset_ns == 0 && slots[1].launch_offset_ns == 1000 && slots[1].latency_ns == 2000 &&
+          slots[2].launch_offset_ns == 2000 && slots[2].latency_ns == 4000, "launch offsets packed back to back");
+    intel_tas_analysis_t analysis;
+    uint32_t frame_size[8] = {1500, 1500, 1500, 1500, 1500, 1500, 230, 105};
+    CHECK(intel_hal_analyze_tas(&tas, 1000, frame_size, &analysis) == INTEL_HAL_SUCCESS &&
+          analysis.tc[7].worst_case_latency_ns != UINT64_MAX, "synthesized schedule is valid");
+
+    // 8 loops at 500 us and 56 at 4 ms share one 15 us class window by spreading over the phases
+    for (int i = 0; i < 64; i++) {
+        streams[i] = (intel_tsn_stream_t){i < 8 ? 500000 : 4000000, 105, 7, i < 8 ? 50000 : 0};
+    }
+    intel_hal_result_t result = intel_hal_tsn_synthesize(&config, streams, 64, slots, &tas);
+    CHECK(result == INTEL_HAL_SUCCESS && tas.cycle_time == 500000 && tas.gate_control_list[0].time_interval == 15000,
+          "64 streams scheduled in hyperperiod slots");
+    int deadlines_met = 1;
+    for (int i = 0; i < 64; i++) {
+        uint64_t deadline = streams[i].deadline_ns ? streams[i].deadline_ns : streams[i].period_ns;
+        deadlines_met &= slots[i].latency_ns <= deadline && slots[i].launch_offset_ns % 500000 < 15000;
+    }
+    CHECK(deadlines_met, "all deadlines met inside the class window");
+
+    // A deadline shorter than the frame cannot be met
+    streams[0] = (intel_tsn_stream_t){1000000, 105, 7, 500};
+    CHECK(intel_hal_tsn_synthesize(&config, streams, 1, slots, &tas) == INTEL_HAL_ERROR_NOT_SUPPORTED &&
+          strstr(intel_hal_get_last_error(), "deadline") != NULL, "missed deadline reported");
+
+    // Best-effort gates may not reopen a scheduled class outside its window
+    streams[0] = (intel_tsn_stream_t){1000000, 105, 7, 0};
+    config.best_effort_gates = 0x81;
+    CHECK(intel_hal_tsn_synthesize(&config, streams, 1, slots, &tas) == INTEL_HAL_ERROR_INVALID_PARAM,
+          "best-effort gates overlapping a scheduled class rejected");
+
+    return TEST_RESULT("TSN synthesis");
+}